@@ -13,6 +13,140 @@ static DispsEnabledFlags ParseDispsFlags(const nlohmann::json& params)
     return flags;
 }
 
+// Передача решателю известных производных модели: точной матрицы Якоби, произведения J * v
+// и структуры матрицы
+static void AttachDerivatives(Solver& solver, TaskManager& taskManager, std::string const& taskName, size_t n)
+{
+    if (auto jacobian = taskManager.FindJacobian(taskName))
+    {
+        solver.SetJacobian(*jacobian);
+    }
+    if (auto jacobianVector = taskManager.FindJacobianVector(taskName))
+    {
+        solver.SetJacobianVector(*jacobianVector);
+    }
+    if (auto pattern = taskManager.FindSparsity(taskName, n))
+    {
+        solver.SetSparsity(*pattern);
+    }
+}
+
+// Функции событий запроса: [{"Expression": "y0 - 1.5", "Terminal": true, "Direction": -1}, ...];
+// Terminal (по умолчанию false) останавливает решение, Direction: 0, +1 или -1
+static std::shared_ptr<EventLocator> ParseEvents(nlohmann::json const& events, TaskManager& taskManager,
+                                                 ODEFunction const& f, size_t n)
+{
+    std::vector<std::string> expressions;
+    std::vector<EventSettings> settings;
+    for (auto const& event : events)
+    {
+        expressions.push_back(event["Expression"].get<std::string>());
+
+        EventSettings setting;
+        setting.terminal = event.value("Terminal", false);
+        setting.direction = event.value("Direction", 0);
+        if (setting.direction < -1 || setting.direction > 1)
+        {
+            throw std::runtime_error("Event direction must be -1, 0 or 1");
+        }
+        settings.push_back(setting);
+    }
+
+    return std::make_shared<EventLocator>(taskManager.CompileEvents(expressions, n), std::move(settings), f);
+}
+
+// Допуски запроса: Atol, Rtol - число или массив по компонентам, ErrorNorm - RMS или Max.
+// Одна только ErrorNorm задаёт atol = rtol = tolerance с выбранной нормой
+static ErrorTolerances ParseTolerances(nlohmann::json const& spec, double tolerance, size_t n)
+{
+    if (spec.is_null())
+    {
+        return ErrorTolerances();
+    }
+
+    auto values = [&spec, tolerance](char const* key)
+    {
+        if (!spec.contains(key))
+        {
+            return std::vector<double>{tolerance};
+        }
+        return spec[key].is_array()
+            ? spec[key].get<std::vector<double>>()
+            : std::vector<double>{spec[key].get<double>()};
+    };
+
+    ErrorTolerances tolerances(values("Atol"), values("Rtol"),
+                               ParseErrorNormKind(spec.value("ErrorNorm", std::string())));
+    tolerances.Validate(n);
+    return tolerances;
+}
+
+// Явный кандидат метода Auto с настройками запроса
+template <class Method>
+static AutoCandidate ExplicitCandidate(std::string const& name, StepControlKind stepControl)
+{
+    return {name, [stepControl](auto const& f, double initialStep, double t0, std::vector<double> const& y0,
+                                double tEnd, Storage& storage, double tolerance, ErrorTolerances const& tolerances)
+    {
+        Method solver(f, initialStep);
+        solver.SetTolerances(tolerances);
+        solver.SetStepControl(stepControl);
+        solver.Solve(t0, y0, tEnd, storage, tolerance);
+    }};
+}
+
+// Кандидаты метода Auto: ExplicitEuler, RK23S, STEKS, DISPD, DISPF, DISPS. DISPF и DISPS берут
+// I, J, K, RadauGamma и флаги схем из параметров запроса, без них - DISPF(0, 0, 1) и все схемы DISPS
+static std::vector<AutoCandidate> AutoCandidates(nlohmann::json const& parameters, StepControlKind stepControl,
+                                                 TaskManager& taskManager, std::string const& taskName, size_t n)
+{
+    std::vector<AutoCandidate> candidates;
+    candidates.push_back(ExplicitCandidate<EulerSolver>("ExplicitEuler", stepControl));
+    candidates.push_back(ExplicitCandidate<RK23SSolver>("RK23S", stepControl));
+    candidates.push_back(ExplicitCandidate<STEKSSolver>("STEKS", stepControl));
+    candidates.push_back(ExplicitCandidate<DISPDSolver>("DISPD", stepControl));
+
+    // Производные модели ищутся заранее: кандидаты запускаются параллельно
+    double gamma = parameters.contains("RadauGamma") ? parameters["RadauGamma"].get<double>() : 0.3;
+    int I = parameters.contains("I") ? parameters["I"].get<int>() : 0;
+    int J = parameters.contains("J") ? parameters["J"].get<int>() : 0;
+    int K = parameters.contains("K") ? parameters["K"].get<int>() : 1;
+    JacobianFunction const* jacobian = taskManager.FindJacobian(taskName);
+    CsrPattern const* pattern = taskManager.FindSparsity(taskName, n);
+    candidates.push_back({"DISPF", [=](auto const& f, double initialStep, double t0, std::vector<double> const& y0,
+                                       double tEnd, Storage& storage, double tolerance, ErrorTolerances const& tolerances)
+    {
+        DISPFSolver solver(f, initialStep, gamma, I, J, K);
+        solver.SetTolerances(tolerances);
+        solver.SetStepControl(stepControl);
+        if (jacobian)
+        {
+            solver.SetJacobian(*jacobian);
+        }
+        if (pattern)
+        {
+            solver.SetSparsity(*pattern);
+        }
+        solver.Solve(t0, y0, tEnd, storage, tolerance * route::c);
+    }});
+
+    DispsEnabledFlags flags = ParseDispsFlags(parameters);
+    if (DISPSSolver::Variants(flags).empty())
+    {
+        flags = {true, true, true, true, true, true};
+    }
+    candidates.push_back({"DISPS", [=](auto const& f, double initialStep, double t0, std::vector<double> const& y0,
+                                       double tEnd, Storage& storage, double tolerance, ErrorTolerances const& tolerances)
+    {
+        DISPSSolver solver(f, initialStep, flags);
+        solver.SetTolerances(tolerances);
+        solver.SetStepControl(stepControl);
+        solver.Solve(t0, y0, tEnd, storage, tolerance);
+    }});
+
+    return candidates;
+}
+
 void route::RegisterResources(hv::HttpService& router)
 {
     router.GET("/", [](HttpRequest* req, HttpResponse* resp)
@@ -22,6 +156,145 @@ void route::RegisterResources(hv::HttpService& router)
         return 200;
     });
 
+    router.GET("/plugins", [](HttpRequest* req, HttpResponse* resp)
+    {
+        nlohmann::json response;
+        response["status"] = "success";
+        response["plugins"] = PluginManager::Instance().Names();
+        resp->SetBody(response.dump());
+        resp->content_type = APPLICATION_JSON;
+        return 200;
+    });
+
+    // Компиляция и регистрация нативного плагина модели (см. PluginManager.hpp);
+    // выключена, пока сервер не запущен с ODE_PLUGIN_COMPILE=1
+    router.POST("/plugins", [](HttpRequest* req, HttpResponse* resp)
+    {
+        if (!PluginManager::Instance().CompilationEnabled())
+        {
+            resp->SetBody("Error: plugin compilation is disabled on this server");
+            resp->content_type = TEXT_PLAIN;
+            return static_cast<int>(HTTP_STATUS_FORBIDDEN);
+        }
+
+        try
+        {
+            auto body = nlohmann::json::parse(req->body);
+            std::string name = body["Name"].get<std::string>();
+            std::string source = body["Source"].get<std::string>();
+
+            auto plugin = PluginManager::Instance().Compile(name, source);
+
+            nlohmann::json response;
+            response["status"] = "success";
+            response["name"] = plugin->name;
+            response["parameters"] = plugin->parameterNames;
+            response["jacobian"] = plugin->jacobian != nullptr;
+            response["preconditioner"] = plugin->preconditioner != nullptr;
+            resp->SetBody(response.dump());
+            resp->content_type = APPLICATION_JSON;
+            return 200;
+        }
+        catch (const std::exception& e)
+        {
+            resp->SetBody(std::string("Error: ") + e.what());
+            resp->content_type = TEXT_PLAIN;
+            return static_cast<int>(HTTP_STATUS_BAD_REQUEST);
+        }
+    });
+
+    router.GET("/stability", [](HttpRequest* req, HttpResponse* resp)
+    {
+        nlohmann::json response;
+        response["status"] = "success";
+        response["schemes"] = StabilitySchemes();
+        resp->SetBody(response.dump());
+        resp->content_type = APPLICATION_JSON;
+        return 200;
+    });
+
+    // Область устойчивости схемы: граница |R(z)| = 1 на сетке и интервал вещественной оси
+    // (см. StabilityRegion.hpp). Тело: "Scheme" или "Polynomial" (коэффициенты по возрастанию
+    // степени), необязательные "Grid" (N или [ширина, высота]), "Re" и "Im" ([min, max])
+    router.POST("/stability", [](HttpRequest* req, HttpResponse* resp)
+    {
+        try
+        {
+            auto body = nlohmann::json::parse(req->body);
+
+            std::string scheme = "Custom";
+            std::vector<double> polynomial;
+            if (body.contains("Polynomial"))
+            {
+                polynomial = body["Polynomial"].get<std::vector<double>>();
+                if (polynomial.empty())
+                    throw std::runtime_error("Polynomial must have at least one coefficient");
+            }
+            else
+            {
+                scheme = body["Scheme"].get<std::string>();
+                polynomial = StabilityPolynomial(SchemeTableau(scheme));
+            }
+
+            StabilityGrid grid;
+            if (body.contains("Grid"))
+            {
+                if (body["Grid"].is_array())
+                {
+                    grid.width = body["Grid"].at(0).get<size_t>();
+                    grid.height = body["Grid"].at(1).get<size_t>();
+                }
+                else
+                {
+                    grid.width = grid.height = body["Grid"].get<size_t>();
+                }
+            }
+
+            // По умолчанию - прямоугольник вокруг интервала устойчивости с квадратными ячейками
+            double length = std::max(StabilityInterval(polynomial), 1.0);
+            grid.reMin = -1.1 * length;
+            grid.reMax = 0.1 * length + 0.5;
+            if (body.contains("Re"))
+            {
+                grid.reMin = body["Re"].at(0).get<double>();
+                grid.reMax = body["Re"].at(1).get<double>();
+            }
+            double half = 0.5 * (grid.reMax - grid.reMin) * grid.height / grid.width;
+            grid.imMin = -half;
+            grid.imMax = half;
+            if (body.contains("Im"))
+            {
+                grid.imMin = body["Im"].at(0).get<double>();
+                grid.imMax = body["Im"].at(1).get<double>();
+            }
+
+            StabilityRegion region = ComputeStabilityRegion(polynomial, grid);
+
+            nlohmann::json response;
+            response["status"] = "success";
+            response["scheme"] = scheme;
+            response["polynomial"] = polynomial;
+            response["realInterval"] = region.realInterval;
+            response["area"] = region.area;
+            response["grid"] = {
+                { "re", { grid.reMin, grid.reMax } },
+                { "im", { grid.imMin, grid.imMax } },
+                { "width", grid.width },
+                { "height", grid.height }
+            };
+            response["contours"] = region.contours;
+            resp->SetBody(response.dump());
+            resp->content_type = APPLICATION_JSON;
+            return 200;
+        }
+        catch (const std::exception& e)
+        {
+            resp->SetBody(std::string("Error: ") + e.what());
+            resp->content_type = TEXT_PLAIN;
+            return static_cast<int>(HTTP_STATUS_BAD_REQUEST);
+        }
+    });
+
     router.POST("/solve", [](HttpContextPtr const &ctx)
     {
         try
@@ -31,62 +304,284 @@ void route::RegisterResources(hv::HttpService& router)
             std::string taskName = body["Equation"].get<std::string>();
             std::string method = body["Method"].get<std::string>();
             nlohmann::json parameters = body["Parameters"];
+
+            // Пользовательская система: по одному выражению правой части на компоненту
+            std::vector<std::string> equations;
+            if (body.contains("Equations"))
+            {
+                equations = body["Equations"].get<std::vector<std::string>>();
+            }
+
+            // Жёсткая часть правой части для метода IMEX (те же правила записи, что и Equations)
+            std::vector<std::string> implicitEquations;
+            if (body.contains("ImplicitEquations"))
+            {
+                implicitEquations = body["ImplicitEquations"].get<std::vector<std::string>>();
+            }
+
+            // Форма второго порядка q'' = g(t, q, q') для методов RKN: по выражению ускорения
+            // на координату над состоянием y0..y{2m-1} = (q, q'); без Equations задаёт и правые части
+            std::vector<std::string> accelerations;
+            if (body.contains("Accelerations"))
+            {
+                accelerations = body["Accelerations"].get<std::vector<std::string>>();
+            }
+
+            // Линейный решатель неявных методов: Auto, Dense, Banded, Sparse, Krylov
+            LinearSolverKind linearSolver = ParseLinearSolverKind(
+                body.contains("LinearSolver") ? body["LinearSolver"].get<std::string>() : "");
+
+            // Закон выбора шага одношаговых методов: Elementary, PI, PID
+            StepControlKind stepControl = ParseStepControlKind(
+                body.contains("StepControl") ? body["StepControl"].get<std::string>() : "");
+
+            // Функции событий g(t, y): поиск корней на принятых шагах, терминальные завершают решение
+            nlohmann::json eventSpecs = body.contains("Events") ? body["Events"] : nlohmann::json::array();
+
+            // Остановка в установившемся режиме: {"Tolerance": ..., "Window": 5, "JumpToEnd": false}
+            nlohmann::json steadySpec = body.contains("SteadyState") ? body["SteadyState"] : nlohmann::json();
+
+            // Допуски по компонентам: {"Atol": [...], "Rtol": 1e-6, "ErrorNorm": "Max"}
+            nlohmann::json toleranceSpec;
+            for (char const* key : {"Atol", "Rtol", "ErrorNorm"})
+            {
+                if (body.contains(key))
+                {
+                    toleranceSpec[key] = body[key];
+                }
+            }
             
-            std::thread([ctx, taskName, method, parameters]()
+            std::thread([ctx, taskName, method, parameters, equations, implicitEquations, accelerations, linearSolver, stepControl, eventSpecs, steadySpec, toleranceSpec]()
             {
                 try
                 {
                     double t0 = parameters["t0"].get<double>();
                     double tEnd = parameters["t1"].get<double>();
-                    double initialStep = 0.001;
                     double tolerance = parameters["tolerance"].get<double>();
 
+                    // Начальный шаг: явно заданный, первый принятый шаг похожего запроса
+                    // или (0) автоматическая оценка по f(t0, y0)
+                    std::vector<std::string> definition = equations;
+                    definition.insert(definition.end(), accelerations.begin(), accelerations.end());
+                    std::string const hintKey = StepHintCache::Key(taskName, definition, method, tolerance);
+                    double initialStep = parameters.contains("InitialStep")
+                        ? parameters["InitialStep"].get<double>()
+                        : StepHintCache::Find(hintKey);
+
                     Storage storage;
                     TaskManager taskManager;
                     taskManager.LoadParameters(parameters);
                     std::vector<double> y0 = ExtractInitialConditions(taskManager.parameters);
+                    if (!equations.empty())
+                    {
+                        taskManager.RegisterExpressionTask(taskName, equations);
+                    }
+                    if (!accelerations.empty())
+                    {
+                        taskManager.RegisterSecondOrderTask(taskName, accelerations, equations.empty());
+                    }
+                    if (!implicitEquations.empty())
+                    {
+                        taskManager.RegisterExpressionTask(TaskManager::ImplicitPartName(taskName), implicitEquations);
+                    }
                     auto odeFunction = taskManager.GetTask(taskName);
+                    ErrorTolerances tolerances = ParseTolerances(toleranceSpec, tolerance, y0.size());
+
+                    // DISPS собирает точки сам, события и установившийся режим проверяются в решателе
+                    std::shared_ptr<EventLocator> events;
+                    if (!eventSpecs.empty())
+                    {
+                        events = ParseEvents(eventSpecs, taskManager, odeFunction, y0.size());
+                        if (method != "DISPS")
+                        {
+                            storage.SetEvents(events);
+                        }
+                    }
+
+                    std::shared_ptr<SteadyStateDetector> steadyState;
+                    if (!steadySpec.is_null())
+                    {
+                        steadyState = std::make_shared<SteadyStateDetector>(
+                            odeFunction, tolerances, steadySpec.value("Tolerance", tolerance), tEnd, steadySpec.value("Window", size_t(5)));
+                        if (method != "DISPS")
+                        {
+                            storage.SetSteadyState(steadyState);
+                        }
+                    }
+
+                    // Статистика решения, если метод её ведёт
+                    nlohmann::json statistics;
 
                     if (method == "ExplicitEuler")
                     {
                         EulerSolver solver(odeFunction, initialStep);
+                        solver.SetTolerances(tolerances);
+                        solver.SetStepControl(stepControl);
                         solver.Solve(t0, y0, tEnd, storage, tolerance);
                     }
                     else if (method == "RungeKutta2")
                     {
                         RK2Solver solver(odeFunction, initialStep);
+                        solver.SetTolerances(tolerances);
+                        solver.SetStepControl(stepControl);
                         solver.Solve(t0, y0, tEnd, storage, tolerance);
                     }
                     else if (method == "RK23S")
                     {
                         RK23SSolver solver(odeFunction, initialStep);
+                        solver.SetTolerances(tolerances);
+                        solver.SetStepControl(stepControl);
                         solver.Solve(t0, y0, tEnd, storage, tolerance);
                     }
                     else if (method == "STEKS")
                     {
                         STEKSSolver solver(odeFunction, initialStep);
+                        solver.SetTolerances(tolerances);
+                        solver.SetStepControl(stepControl);
                         solver.Solve(t0, y0, tEnd, storage, tolerance);
                     }
                     else if (method == "DISPD")
                     {
                         DISPDSolver solver(odeFunction, initialStep);
+                        solver.SetTolerances(tolerances);
+                        solver.SetStepControl(stepControl);
                         solver.Solve(t0, y0, tEnd, storage, tolerance);
                     }
                     else if (method == "DISPF")
                     {
+                        // Доля границы устойчивости для перехода к Radau IIA (0 - без перехода)
+                        double gamma = parameters.contains("RadauGamma") ? parameters["RadauGamma"].get<double>() : 0.3;
                         DISPFSolver solver(
-                            odeFunction, initialStep, 0, parameters["I"].get<int>(),
+                            odeFunction, initialStep, gamma, parameters["I"].get<int>(),
                             parameters["J"].get<int>(), parameters["K"].get<int>());
+                        solver.SetTolerances(tolerances);
+                        solver.SetStepControl(stepControl);
+                        AttachDerivatives(solver, taskManager, taskName, y0.size());
                         solver.Solve(t0, y0, tEnd, storage, tolerance * c);
                     }
+                    else if (method == "RadauIIA")
+                    {
+                        RadauIIASolver solver(odeFunction, initialStep);
+                        solver.SetTolerances(tolerances);
+                        AttachDerivatives(solver, taskManager, taskName, y0.size());
+                        solver.Solve(t0, y0, tEnd, storage, tolerance);
+                    }
+                    else if (method == "BDF")
+                    {
+                        BDFSolver solver(odeFunction, initialStep, linearSolver);
+                        solver.SetTolerances(tolerances);
+                        AttachDerivatives(solver, taskManager, taskName, y0.size());
+                        if (auto preconditioner = taskManager.FindPreconditioner(taskName))
+                        {
+                            solver.SetPreconditioner(*preconditioner);
+                        }
+                        solver.Solve(t0, y0, tEnd, storage, tolerance);
+                    }
+                    else if (method == "IMEX")
+                    {
+                        auto implicitPart = taskManager.FindImplicitPart(taskName);
+                        if (!implicitPart)
+                        {
+                            throw std::runtime_error("IMEX method requires an implicit part: " + taskName);
+                        }
+
+                        IMEXSolver solver(odeFunction, *implicitPart, initialStep, linearSolver);
+                        solver.SetTolerances(tolerances);
+                        solver.SetStepControl(stepControl);
+                        AttachDerivatives(solver, taskManager, TaskManager::ImplicitPartName(taskName), y0.size());
+                        solver.Solve(t0, y0, tEnd, storage, tolerance);
+                    }
+                    else if (method == "ETDRK4")
+                    {
+                        auto linearPart = taskManager.FindImplicitPart(taskName);
+                        if (!linearPart)
+                        {
+                            throw std::runtime_error("ETDRK4 method requires a linear part: " + taskName);
+                        }
+
+                        ETDRK4Solver solver(odeFunction, *linearPart, initialStep, linearSolver);
+                        solver.SetTolerances(tolerances);
+                        AttachDerivatives(solver, taskManager, TaskManager::ImplicitPartName(taskName), y0.size());
+                        solver.Solve(t0, y0, tEnd, storage, tolerance);
+                    }
+                    else if (method == "ExpRosenbrock")
+                    {
+                        ExpRosenbrockSolver solver(odeFunction, initialStep, linearSolver);
+                        solver.SetTolerances(tolerances);
+                        solver.SetStepControl(stepControl);
+                        AttachDerivatives(solver, taskManager, taskName, y0.size());
+                        solver.Solve(t0, y0, tEnd, storage, tolerance);
+                    }
+                    else if (method == "RKC")
+                    {
+                        RKCSolver solver(odeFunction, initialStep);
+                        solver.SetTolerances(tolerances);
+                        solver.SetStepControl(stepControl);
+                        solver.Solve(t0, y0, tEnd, storage, tolerance);
+                    }
+                    else if (method == "Adams")
+                    {
+                        AdamsSolver solver(odeFunction, initialStep);
+                        solver.SetTolerances(tolerances);
+                        solver.Solve(t0, y0, tEnd, storage, tolerance);
+                    }
+                    else if (method == "DP5" || method == "Tsit5" || method == "DOP853")
+                    {
+                        EmbeddedRKSolver solver(odeFunction, initialStep, EmbeddedPair(method));
+                        solver.SetTolerances(tolerances);
+                        solver.SetStepControl(stepControl);
+                        // Равномерная выдача по плотной выдаче вместо точек шагов
+                        if (parameters.contains("OutputStep"))
+                        {
+                            solver.SetOutputStep(parameters["OutputStep"].get<double>());
+                        }
+                        solver.Solve(t0, y0, tEnd, storage, tolerance);
+                    }
+                    else if (method == "LSRK3" || method == "LSRK4")
+                    {
+                        LowStorageRKSolver solver(odeFunction, initialStep, LowStorageScheme(method));
+                        solver.SetTolerances(tolerances);
+                        solver.SetStepControl(stepControl);
+                        solver.Solve(t0, y0, tEnd, storage, tolerance);
+
+                        statistics["registers"] = solver.Registers();
+                    }
+                    else if (method == "RKN4" || method == "RKN5")
+                    {
+                        SecondOrderSystem system;
+                        if (!taskManager.FindSecondOrder(taskName, system))
+                        {
+                            throw std::runtime_error(method + " method requires a second-order form: " + taskName);
+                        }
+
+                        RKNSolver solver(odeFunction, system, initialStep, NystromPair(method));
+                        solver.SetTolerances(tolerances);
+                        solver.SetStepControl(stepControl);
+                        solver.Solve(t0, y0, tEnd, storage, tolerance);
+
+                        statistics["evaluations"] = solver.Evaluations();
+                    }
                     else if (method == "DISPS")
                     {
                         auto flags = ParseDispsFlags(parameters);
                         
                         DISPSSolver solver(odeFunction, initialStep, flags);
+                        solver.SetTolerances(tolerances);
                         //DISPSSolver_old solver(odeFunction, initialStep, flags);
+                        solver.SetStepControl(stepControl);
+                        solver.SetEvents(events);
+                        solver.SetSteadyState(steadyState);
                         auto results = solver.Solve(t0, y0, tEnd, tolerance);
 
+                        statistics["switches"] = solver.Switches();
+                        statistics["variants"] = nlohmann::json::array();
+                        for (auto const& usage : solver.Usage())
+                        {
+                            statistics["variants"].push_back({{"variant", usage.name}, {"steps", usage.steps},
+                                                              {"rejected", usage.rejected},
+                                                              {"evaluations", usage.evaluations}});
+                        }
+
                         for (auto& row : results)
                         {
                             double t_val = row[0];
@@ -94,11 +589,49 @@ void route::RegisterResources(hv::HttpService& router)
                             storage.Add(t_val, y_vals);
                         }
                     }
+                    else if (method == "Auto")
+                    {
+                        // Параметры модели без интервала и допуска определяют область кэша выбора
+                        std::unordered_map<std::string, double> modelParameters = taskManager.parameters;
+                        for (char const* key : {"t0", "t1", "tolerance", "InitialStep"})
+                        {
+                            modelParameters.erase(key);
+                        }
+
+                        AutoSolver solver(odeFunction, initialStep,
+                                          AutoCandidates(parameters, stepControl, taskManager, taskName, y0.size()));
+                        solver.SetTolerances(tolerances);
+                        solver.SetCacheKey(AutoSolver::Key(taskName, definition, modelParameters, tolerance));
+                        solver.Solve(t0, y0, tEnd, storage, tolerance);
+
+                        statistics["trials"] = solver.Trials();
+                        statistics["probeEvaluations"] = solver.ProbeEvaluations();
+                        statistics["trialEvaluations"] = solver.TrialEvaluations();
+                        statistics["segments"] = nlohmann::json::array();
+                        for (auto const& segment : solver.Segments())
+                        {
+                            statistics["segments"].push_back({{"method", segment.method}, {"t0", segment.t0},
+                                                              {"t1", segment.t1},
+                                                              {"evaluations", segment.evaluations}});
+                        }
+                    }
                     else
                     {
                         throw std::runtime_error("Unknown method: " + method);
                     }
 
+                    // Установившееся решение продолжается до t1 без интегрирования
+                    if (steadyState && steadyState->Detected() && steadySpec.value("JumpToEnd", false))
+                    {
+                        storage.Extend(tEnd);
+                    }
+
+                    // Первый принятый шаг - подсказка для следующих похожих запросов
+                    if (storage.Size() > 1 && !parameters.contains("OutputStep"))
+                    {
+                        StepHintCache::Store(hintKey, storage[1].first - storage[0].first);
+                    }
+
                     // Начинаем потоковую передачу
                     ctx->writer->Begin();
                     ctx->response->content_type = APPLICATION_JSON;
@@ -148,6 +681,32 @@ void route::RegisterResources(hv::HttpService& router)
                         buffer += "[]";
                     }
 
+                    // Найденные события: номер функции, t и состояние
+                    if (events)
+                    {
+                        nlohmann::json found = nlohmann::json::array();
+                        for (auto const& record : events->Records())
+                        {
+                            found.push_back({{"event", record.index}, {"t", record.t}, {"values", record.y}});
+                        }
+                        buffer += R"(,"events":)" + found.dump();
+                    }
+
+                    if (steadyState)
+                    {
+                        nlohmann::json steady = {{"detected", steadyState->Detected()}};
+                        if (steadyState->Detected())
+                        {
+                            steady["t"] = steadyState->DetectedTime();
+                        }
+                        buffer += R"(,"steadyState":)" + steady.dump();
+                    }
+
+                    if (!statistics.is_null())
+                    {
+                        buffer += R"(,"statistics":)" + statistics.dump();
+                    }
+
                     // Завершаем JSON
                     buffer += "}";
                     flush_buffer();
@@ -2,6 +2,9 @@
 
 int main()
 {
+    // Готовые плагины моделей из каталога ODE_PLUGIN_DIR (по умолчанию ./plugins)
+    PluginManager::Instance().LoadDirectory();
+
     HttpServer::UPtr server = std::make_unique<HttpServer>();
 
     server->Start(7777);
@@ -0,0 +1,80 @@
+#pragma once
+#include "Solver.hpp"
+
+// Метод Адамса-Башфорта-Моултона переменного шага и порядка (1-12) в форме PECE
+// (алгоритм STEP Шампайна-Гордона). История хранится модифицированными разделёнными
+// разностями phi, поэтому смена шага не требует интерполяции; коэффициенты g формул
+// пересчитываются только для шагов, после которых шаг менялся. На шаг - два вычисления f
+// (прогноз и коррекция), порядок выбирается по оценкам погрешности порядков k-2..k+1.
+// Предназначен для нежёстких задач с дорогой правой частью и гладким решением.
+class AdamsSolver : public Solver
+{
+public:
+    AdamsSolver(
+        std::function<std::vector<double>(
+            double,
+            std::vector<double> const &)> func,
+        double                            initialStep
+    ) : Solver(func, initialStep) {}
+
+    void Step(
+        double               t,
+        std::vector<double> &y,
+        double              &h,
+        double               tolerance) override;
+
+    void Solve(
+        double                     t0,
+        std::vector<double> const &y0,
+        double                     tEnd,
+        Storage                   &storage,
+        double                     tolerance) override;
+
+private:
+    static constexpr int MAX_ORDER = 12;
+
+    // Массивы ниже индексируются с 1, как в описании алгоритма
+    static constexpr double GSTR[14] = { 0.0, 0.5, 0.0833, 0.0417, 0.0264, 0.0188, 0.0143, 0.0114,
+                                         0.00936, 0.00789, 0.00679, 0.00592, 0.00524, 0.00468 };
+
+    size_t n = 0;
+    std::vector<double>              weight;  // Веса нормы: 1 + |y| или sc_i / tolerance (допуски по компонентам)
+    std::vector<std::vector<double>> phi;     // Разделённые разности f (столбцы 1..14), 15-16 - учёт округлений
+    std::vector<double>              yp;      // f в последней точке
+    std::vector<double>              p;       // Прогноз
+
+    double psi[MAX_ORDER + 2]   = {};
+    double alpha[MAX_ORDER + 2] = {};
+    double beta[MAX_ORDER + 2]  = {};
+    double sig[MAX_ORDER + 3]   = {};
+    double v[MAX_ORDER + 2]     = {};
+    double w[MAX_ORDER + 2]     = {};
+    double g[MAX_ORDER + 3]     = {};
+
+    int    k = 1;         // Текущий порядок
+    int    kold = 0;      // Порядок последнего принятого шага
+    int    ns = 0;        // Число шагов, сделанных с постоянным шагом
+    double hold = 0.0;    // Последний принятый шаг
+    bool   phase1 = true; // Начальная фаза: порядок и шаг растут на каждом шаге
+    bool   nornd = true;  // Без учёта распространения ошибок округления
+
+    double Norm(std::vector<double> const &v) const;
+
+    void UpdateWeights(
+        std::vector<double> const &y,
+        double                     tolerance);
+
+    // Начальные разности и шаг по f(t0, y0)
+    void Start(
+        double                     t,
+        std::vector<double> const &y,
+        double                    &h,
+        double                     tolerance);
+
+    // Один принятый шаг из (t, y): t, y и h обновляются, h - шаг для следующего шага
+    void AdvanceStep(
+        double              &t,
+        std::vector<double> &y,
+        double              &h,
+        double               tolerance);
+};
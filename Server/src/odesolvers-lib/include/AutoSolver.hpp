@@ -0,0 +1,154 @@
+#pragma once
+#include "Solver.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Запуск метода-кандидата: решение на [t0, tEnd] из y0 с начальным шагом initialStep
+// (<= 0 - автоматический выбор), допусками tolerance и tolerances и записью принятых точек
+// в storage. Правая часть вычисляется только через переданную f: по ней считаются
+// вычисления и прерываются пробные запуски.
+using AutoRunner = std::function<void(
+    std::function<std::vector<double>(
+        double,
+        std::vector<double> const &)> const &f,
+    double                     initialStep,
+    double                     t0,
+    std::vector<double> const &y0,
+    double                     tEnd,
+    Storage                   &storage,
+    double                     tolerance,
+    ErrorTolerances const     &tolerances)>;
+
+struct AutoCandidate
+{
+    std::string name;
+    AutoRunner  run;
+};
+
+// Участок решения, пройденный одним методом
+struct AutoSegment
+{
+    std::string method;
+    double      t0          = 0.0;
+    double      t1          = 0.0;
+    size_t      evaluations = 0;   // Вычисления f методом на участке (с пробным запуском)
+};
+
+// Автоматический выбор метода. Жёсткость оценивается спектральным радиусом rho матрицы
+// Якоби (несколько итераций нелинейного степенного метода по вычислениям f). Кандидаты
+// параллельно на ComputePool решают задачу на пробном отрезке; решение продолжает метод
+// с наименьшей стоимостью - числом вычислений f на единицу t, его пробный участок входит
+// в решение. Дальше решение идёт участками, перед каждым rho оценивается заново: если rho
+// изменился на порядок или метод на участке превысил ожидаемое число вычислений, выбор
+// повторяется. Выбор запоминается по ключу задачи и порядку rho, и похожие запросы
+// обходятся без пробных запусков.
+class AutoSolver : public Solver
+{
+public:
+    AutoSolver(
+        std::function<std::vector<double>(
+            double,
+            std::vector<double> const &)> func,
+        double                            initialStep,
+        std::vector<AutoCandidate>        candidates);
+
+    // Ключ кэша выбора: задача, выражения правых частей, знак и десятичный порядок каждого
+    // параметра модели, порядок допуска
+    static std::string Key(
+        std::string const                             &equation,
+        std::vector<std::string> const                &equations,
+        std::unordered_map<std::string, double> const &parameters,
+        double                                         tolerance);
+
+    // Пустой ключ - выбор не кэшируется
+    void SetCacheKey(std::string key) { cacheKey = std::move(key); }
+
+    // Участки последнего Solve, число пробных выборов, вычисления f оценками rho и пробными
+    // запусками, не вошедшими в решение
+    std::vector<AutoSegment> const& Segments() const { return segments; }
+    size_t Trials() const { return trials; }
+    size_t ProbeEvaluations() const { return probeEvaluations; }
+    size_t TrialEvaluations() const { return trialEvaluations; }
+
+    void Step(
+        double               t,
+        std::vector<double> &y,
+        double              &h,
+        double               tolerance) override;
+
+    void Solve(
+        double                     t0,
+        std::vector<double> const &y0,
+        double                     tEnd,
+        Storage                   &storage,
+        double                     tolerance) override;
+
+private:
+    static constexpr double TRIAL_FRACTION    = 0.02;  // Пробный отрезок - доля интервала решения
+    static constexpr double SEGMENT_FRACTION  = 0.1;   // Участок между оценками rho
+    static constexpr size_t TRIAL_EVALUATIONS = 20000; // Наибольшее число вычислений f пробного запуска
+    static constexpr double REFINE            = 10.0;  // Уменьшение допуска проверочного запуска
+    static constexpr size_t CHECK_EVALUATIONS = 4 * TRIAL_EVALUATIONS;
+    static constexpr double SEGMENT_SLACK     = 4.0;   // Допустимый перерасход вычислений на участке
+    static constexpr size_t SEGMENT_RESERVE   = 100;
+    static constexpr double RHO_CHANGE        = 10.0;  // Изменение rho, при котором выбор повторяется
+    static constexpr int    MAX_POWER         = 10;    // Итераций степенного метода
+    static constexpr size_t MAX_CACHE_SIZE    = 1024;
+
+    // Запуск кандидата до tEnd; запуск прерывается, когда число вычислений f достигает limit
+    struct Run
+    {
+        Storage storage;
+        size_t  evaluations = 0;
+        bool    completed   = false; // Метод завершил Solve без прерывания
+    };
+
+    std::vector<AutoCandidate> candidates;
+    std::string                cacheKey;
+    std::vector<AutoSegment>   segments;
+    size_t                     trials           = 0;
+    size_t                     probeEvaluations = 0;
+    size_t                     trialEvaluations = 0;
+    std::vector<double>        eigenvector;      // Приближение доминирующего собственного вектора (тёплый старт)
+
+    static std::mutex                                   cacheMutex;
+    static std::unordered_map<std::string, std::string> cache;
+
+    void Execute(
+        size_t                     index,
+        double                     t,
+        std::vector<double> const &y,
+        double                     h,
+        double                     tEnd,
+        double                     tolerance,
+        ErrorTolerances const     &runTolerances,
+        std::atomic<size_t> const &limit,
+        Run                       &run) const;
+
+    // Пробные запуски всех кандидатов на [t, tEnd]; возвращает номер метода с наименьшим
+    // числом вычислений f на единицу t среди точных до tFinal, его запуск - в winner
+    size_t Select(
+        double                     t,
+        std::vector<double> const &y,
+        double                     tEnd,
+        double                     tFinal,
+        double                     tolerance,
+        Run                       &winner);
+
+    // Спектральный радиус матрицы Якоби в точке (t, y), fy = f(t, y)
+    double SpectralRadius(
+        double                     t,
+        std::vector<double> const &y,
+        std::vector<double> const &fy);
+
+    // Кандидат, выбранный ранее для ключа; candidates.size() - выбора нет
+    size_t Cached(std::string const &key) const;
+
+    void Remember(
+        std::string const &key,
+        size_t             index) const;
+};
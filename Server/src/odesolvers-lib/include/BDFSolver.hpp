@@ -0,0 +1,103 @@
+#pragma once
+#include "Solver.hpp"
+#include "LinearSolvers.hpp"
+#include "Krylov.hpp"
+
+// Формулы дифференцирования назад переменного порядка 1-5 в форме Нордсика
+// (с фиксированными коэффициентами, как в LSODE): история хранится как
+// z_j = h^j y^(j) / j!, при смене шага столбцы масштабируются, при смене порядка
+// добавляются или отбрасываются. Неявные уравнения решаются модифицированным
+// методом Ньютона; матрица Якоби и разложение M = I - h*l0*J переиспользуются
+// между шагами. Линейный решатель (плотный, ленточный, разреженный) подключаемый.
+// В режиме LinearSolverKind::Krylov матрица Якоби не строится: системы Ньютона
+// решаются GMRES с произведениями J*v - точными (SetJacobianVector) или по конечным
+// разностям правой части, память O(n * KRYLOV_RESTART).
+class BDFSolver : public Solver
+{
+public:
+    BDFSolver(
+        std::function<std::vector<double>(
+            double,
+            std::vector<double> const &)> func,
+        double                            initialStep,
+        LinearSolverKind                  kind = LinearSolverKind::Auto
+    ) : Solver(func, initialStep), linearSolverKind(kind) {}
+
+    // Продвижение решения на h (возможно, несколькими внутренними шагами)
+    void Step(
+        double               t,
+        std::vector<double> &y,
+        double              &h,
+        double               tolerance) override;
+
+    void Solve(
+        double                     t0,
+        std::vector<double> const &y0,
+        double                     tEnd,
+        Storage                   &storage,
+        double                     tolerance) override;
+
+    char const *LinearSolverName() const { return linear ? linear->Name() : "Krylov"; }
+
+    // Предобусловливатель для режима Krylov (правое предобусловливание)
+    void SetPreconditioner(PreconditionerFunction p) { preconditioner = std::move(p); }
+
+private:
+    static constexpr int    MAX_ORDER    = 5;
+    static constexpr int    MAX_NEWTON   = 3;
+    static constexpr double NEWTON_TOL   = 0.2;  // Точность итераций Ньютона относительно допуска
+    static constexpr double GAMMA_CHANGE = 0.3;  // Новое разложение при изменении h*l0 более чем на 30%
+    static constexpr int    JACOBIAN_AGE = 20;   // Матрица Якоби обновляется не реже чем через 20 шагов
+    static constexpr double MAX_GROWTH   = 10.0; // Наибольшее увеличение шага
+    static constexpr double MIN_CHANGE   = 1.1;  // Меньшее увеличение шага не выполняется
+
+    static constexpr size_t KRYLOV_RESTART      = 20;
+    static constexpr size_t KRYLOV_MAX_RESTARTS = 4;
+    static constexpr double KRYLOV_FACTOR       = 0.05; // Точность GMRES относительно NEWTON_TOL
+
+    LinearSolverKind              linearSolverKind;
+    std::unique_ptr<LinearSolver> linear;
+    PreconditionerFunction        preconditioner;
+
+    size_t n = 0;
+    int    q = 1;              // Текущий порядок
+    double h = 0.0;
+    int    stepsAtOrder = 0;   // Шагов с неизменными h и q
+    bool   needJacobian = true;
+    bool   jacobianCurrent = false;
+    int    jacobianAge = 0;
+    double gammaFactored = 0.0; // h*l0, для которого построено разложение
+
+    CsrMatrix                        J;
+    std::vector<std::vector<double>> z;     // Массив Нордсика, MAX_ORDER + 2 столбца
+    std::vector<double>              scale; // Веса нормы: tolerance * (1 + |y|)
+    std::vector<double>              e;     // Накопленная поправка Ньютона
+    std::vector<double>              dPrev; // Оценка h^(q+1) y^(q+1) прошлого шага
+    bool                             haveDPrev = false;
+
+    // Коэффициенты l_j(q) корректора: Π(1 + x/i) / Σ(1/i), i = 1..q
+    static std::array<std::array<double, MAX_ORDER + 1>, MAX_ORDER + 1> const &Coefficients();
+
+    double Norm(std::vector<double> const &v) const;
+
+    void Predict();
+    void Rescale(double hNew);
+
+    // Модифицированный метод Ньютона для поправки e; false - нет сходимости
+    bool Correct(
+        double tNew,
+        double tolerance);
+
+    // Решение (I - gamma * J(y)) x = r методом GMRES, результат в r
+    void SolveKrylov(
+        double                     t,
+        std::vector<double> const &y,
+        std::vector<double> const &fy,
+        double                     gamma,
+        std::vector<double>       &r);
+
+    // Выбор шага и порядка после принятого шага
+    void AdaptAfterSuccess(
+        double                     err,
+        std::vector<double> const &d);
+};
@@ -0,0 +1,42 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Общий пул вычислительных потоков библиотеки
+class ComputePool
+{
+public:
+    static ComputePool& Instance();
+
+    ~ComputePool();
+
+    ComputePool(const ComputePool &) = delete;
+    ComputePool& operator=(const ComputePool &) = delete;
+
+    size_t ThreadCount() const { return workers.size(); }
+
+    // Выполнение body(0..count-1) на пуле. Вызывающий поток участвует в работе,
+    // поэтому вложенные вызовы из задач пула не приводят к взаимной блокировке.
+    // Первое исключение из body пробрасывается вызывающему.
+    void ParallelFor(
+        size_t                             count,
+        std::function<void(size_t)> const &body);
+
+    // Асинхронная задача без ожидания результата
+    void Submit(std::function<void()> task);
+
+private:
+    explicit ComputePool(size_t threads);
+
+    void WorkerLoop();
+
+    std::vector<std::thread>          workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex                        mutex;
+    std::condition_variable           condition;
+    bool                              stopping = false;
+};
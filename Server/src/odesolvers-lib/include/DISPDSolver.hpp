@@ -8,9 +8,11 @@ public:
         std::function<std::vector<double>(
             double,
             std::vector<double> const &)> func,
-        double                            initialStep,
-        double                            q = 1.5  // Параметр адаптации шага (q > 1)
-    ) : Solver(func, initialStep), q(q) {}
+        double                            initialStep
+    ) : Solver(func, initialStep)
+    {
+        controller.SetLimits(SAFETY, MIN_SCALE, MAX_SCALE);
+    }
 
     void Step(
         double               t,
@@ -26,10 +28,12 @@ public:
         double                     tolerance) override;
 
 private:
-    const double q;        // Параметр для формул (5.17-5.23)
     const double SAFETY    = 0.8;
     const double MIN_SCALE = 0.2;
     const double MAX_SCALE = 5.0;
+    const double STABILITY_BOUND = 18.0; // Граница V_n для схемы А
+
+    double acceptedStep = 0.0; // Длина принятого шага: Step возвращает в h следующий шаг
 
     // Параметры для схем (5.2) и (5.12)
     struct SchemeParams {
@@ -52,12 +56,17 @@ private:
     // Оценки ошибок и параметров адаптации
     double computeAprime(
         std::vector<double> const &k1,
-        std::vector<double> const &k2);
+        std::vector<double> const &k2,
+        std::vector<double> const &y,
+        double                     tolerance);
     
     double computeAddoublePrime(
         double                     h,
         std::vector<double> const &k1,
-        std::vector<double> const &yNext);
+        std::vector<double> const &yNext,
+        std::vector<double> const &y,
+        std::vector<double> const &yNew,
+        double                     tolerance);
     
     double computeV(
         std::vector<double> const &k1,
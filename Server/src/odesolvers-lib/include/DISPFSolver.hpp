@@ -1,5 +1,6 @@
 #pragma once
 #include "Solver.hpp"
+#include "RadauIIASolver.hpp"
 
 class DISPFSolver : public Solver
 {
@@ -9,6 +10,9 @@ public:
     // J - контроль устойчивости (0 - включён, 1 - выключен),
     // K - метод оценки матрицы Якоби (0 - специальной подпрограммой, 1 - степенной метод, 2 - осреднение),
     // если J == 1, то K игнорируется.
+    // gamma - доля границы устойчивости: шаг с h*lambda >= gamma * граница считается нарушением
+    // устойчивости; после серии нарушений решение продолжается неявным методом Radau IIA
+    // (0 - переход отключён).
     DISPFSolver(
         std::function<std::vector<double>(
             double,
@@ -35,15 +39,10 @@ public:
         double                     tolerance
     ) override;
 
-private:
-    enum Method 
-    {
-        DISPFA,
-        DISPFB,
-        DISPFC
-    };
-
-    const std::array<std::array<double, 5>, 5> B = {{
+    // Таблица стадий (строка i - коэффициенты при k_1..k_{i+1} в аргументе стадии k_{i+2})
+    // и наборы весов P36, P4, P72, P28 схем DISPFA/DISPFB/DISPFC; используются и анализом
+    // областей устойчивости (StabilityRegion.hpp)
+    static constexpr std::array<std::array<double, 5>, 5> B = {{
         {1.0/4.0,           0,                0,            0,          0},
         {3.0/32.0,         9.0/32.0,         0,            0,          0},
         {1932.0/2197.0,   -7200.0/2197.0,    7296.0/2197.0,  0,          0},
@@ -51,11 +50,20 @@ private:
         {-8.0/27.0,         2.0,            -3544.0/2565.0,  1859.0/4104.0, -11.0/40.0}
     }};
 
-    const std::array<double, 6> P36 = {16.0/135.0, 0.0, 6656.0/12825.0, 28561.0/56430.0, -9.0/50.0, 2.0/55.0};
-    const std::array<double, 6> P4  = {25.0/216.0, 0.0, 1408.0/2565.0, 2197.0/4104.0, -1.0/5.0, 0.0};
+    static constexpr std::array<double, 6> P36 = {16.0/135.0, 0.0, 6656.0/12825.0, 28561.0/56430.0, -9.0/50.0, 2.0/55.0};
+    static constexpr std::array<double, 6> P4  = {25.0/216.0, 0.0, 1408.0/2565.0, 2197.0/4104.0, -1.0/5.0, 0.0};
+
+    static constexpr std::array<double, 6> P72 = {0.41975960186956, 0.44944365216575, 0.1296419611922, 0.0012199235635231, -0.000066250690732054, 0.0000011118997045939};
+    static constexpr std::array<double, 6> P28 = {-0.38402741318519, 0.28983442536296, 1.0619636598535, 0.036673230572343, -0.0046504806400000, 0.00020657863636364};
+
+private:
+    enum Method 
+    {
+        DISPFA,
+        DISPFB,
+        DISPFC
+    };
 
-    const std::array<double, 6> P72 = {0.41975960186956, 0.44944365216575, 0.1296419611922, 0.0012199235635231, -0.000066250690732054, 0.0000011118997045939};
-    const std::array<double, 6> P28 = {-0.38402741318519, 0.28983442536296, 1.0619636598535, 0.036673230572343, -0.0046504806400000, 0.00020657863636364};
     const std::array<double, 5> ACoef = {1.0/4.0, 3.0/8.0, 12.0/13.0, 1.0, 0.5};
 
     double q = 1.1;
@@ -65,6 +73,8 @@ private:
     double CA1B = 0.314690666666666666667;
     double d_coef = 0.24;
 
+    static constexpr int RADAU_CHECK_INTERVAL = 10; // Проверка возврата к явной схеме каждые N шагов Radau IIA
+
     static constexpr double MAX_P = 400;
     static constexpr double MAXDOUBLE = 100.0e+300;
 
@@ -72,11 +82,13 @@ private:
     std::vector<std::vector<double>> k; // Матрица коэффициентов (n уравнений x 6)
     std::vector<double> F;              // Вектор для f(t,y)
     std::vector<double> Y0;             // Вспомогательный вектор
+    std::vector<double> errorWeight;    // Веса компонент в нормах погрешности (ErrorWeights)
 
     // Текущий выбранный метод
     Method currentMethod;
     int vnBreakCount = 0;
     bool jumpToRadau5 = false;
+    std::unique_ptr<RadauIIASolver> radau; // Неявный метод для жёсткого участка
 
     // Параметры управления порядком и устойчивостью:
     bool variableOrder;   // true, если I==0 (переменный порядок)
@@ -84,11 +96,43 @@ private:
     bool stabilityControlEnabled; // true, если J==0 (контроль устойчивости включён)
     int jacobianMethod;   // метод оценки Якоби (0,1 или 2, используется только если контроль включён)
 
+    // Наибольший устойчивый шаг h * bound / Vn для следующего шага (0 - без ограничения).
+    // При переменном порядке выход V_n за границу схем DISPFB и DISPFC - сигнал к смене
+    // схемы, поэтому их шаг не ограничивается
+    double StableStep(
+        double h,
+        double Vn,
+        double bound) const;
+
     // Вспомогательная функция для вычисления суммы стадий для уравнения eqNum и стадии stage
     double StadScalar(
         size_t eqNum,
         int    stage);
 
+    // Шаг текущим методом, t и h обновляются
+    void Advance(
+        double              &t,
+        std::vector<double> &y,
+        double              &h,
+        double               tolerance);
+
+    // Жёсткий участок: шаги Radau IIA до tEnd или до возврата к явной схеме
+    void SolveStiff(
+        double              &t,
+        std::vector<double> &y,
+        double              &h,
+        double               tEnd,
+        Storage             &storage,
+        double               tolerance);
+
+    // Подсчёт нарушений устойчивости: h * lambda сравнивается с gamma * bound
+    void CheckStability(
+        double                     t,
+        std::vector<double> const &y,
+        double                     h,
+        double                     bound,
+        int                        breakLimit);
+
     // Методы шага
     bool StepDISPFC(
         double              &t,
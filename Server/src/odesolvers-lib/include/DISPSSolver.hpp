@@ -4,6 +4,14 @@
 #include <functional>
 #include <stdexcept>
 #include <cmath>
+#include <memory>
+#include <string>
+
+#include "ErrorTolerances.hpp"
+#include "EventLocator.hpp"
+#include "SteadyStateDetector.hpp"
+#include "StepSizeController.hpp"
+#include "Storage.hpp"
 
 // Флаги выбора схем
 struct DispsEnabledFlags {
@@ -20,33 +28,104 @@ struct DispsVariant {
     int stages;             // Число стадий (3, 5 или 6)
     int order;              // Порядок метода (1, 2 или 3)
     std::vector<double> p;  // Коэффициенты
-    double gamma;           // Длина интервала устойчивости
+    double gamma;           // Длина интервала устойчивости (номинальная, из описания схемы)
+};
+
+// Использование варианта за время Solve
+struct DispsUsage {
+    std::string name;        // Disps<порядок><стадии>
+    size_t steps = 0;        // Принятые шаги
+    size_t rejected = 0;     // Отклонённые попытки
+    size_t evaluations = 0;  // Вычисления f
 };
 
 class DISPSSolver {
 public:
-    // f - функция ОДУ, initialStep - начальный шаг, flags - выбранные схемы
+    // f - функция ОДУ, initialStep - начальный шаг (<= 0 - автоматический выбор), flags - выбранные схемы
     DISPSSolver(std::function<std::vector<double>(double, const std::vector<double>&)> f,
                 double initialStep,
                 const DispsEnabledFlags& flags);
 
+    // Закон выбора шага (Elementary, PI, PID)
+    void SetStepControl(StepControlKind kind) { controller_.SetKind(kind); }
+
+    // Поиск событий на принятых шагах; терминальное событие завершает Solve в точке события
+    void SetEvents(std::shared_ptr<EventLocator> events) { events_ = std::move(events); }
+
+    // Остановка Solve при установившемся режиме
+    void SetSteadyState(std::shared_ptr<SteadyStateDetector> detector) { steadyState_ = std::move(detector); }
+
+    // Допуски по компонентам для оценок погрешности A', B', C'
+    void SetTolerances(ErrorTolerances tolerances) { tolerances_ = std::move(tolerances); }
+
+    // Коэффициенты включённых вариантов схем
+    static std::vector<DispsVariant> Variants(const DispsEnabledFlags& flags);
+
+    // Статистика последнего Solve по включённым вариантам и число смен схемы
+    const std::vector<DispsUsage>& Usage() const { return usage_; }
+    size_t Switches() const { return switches_; }
+
     // Решение ОДУ: возвращает точки [t, y...]
     std::vector<std::vector<double>> Solve(double t0,
                                            const std::vector<double>& y0,
                                            double tEnd,
                                            double tolerance);
 
+    // Решение ОДУ с записью принятых точек в storage, как у решателей Solver: события
+    // и установившийся режим проверяет storage, решение прекращается при storage.Stopped()
+    void Solve(double t0,
+               const std::vector<double>& y0,
+               double tEnd,
+               Storage& storage,
+               double tolerance);
+
 private:
     std::function<std::vector<double>(double, const std::vector<double>&)> f_;
     double stepSize_;
     std::vector<DispsVariant> variants_;
     int currentIndex_;
+    StepSizeController controller_;
+    std::shared_ptr<EventLocator> events_;
+    std::shared_ptr<SteadyStateDetector> steadyState_;
+    ErrorTolerances tolerances_;
+    std::vector<double> errorConstants_; // Константы погрешности вариантов (DispsErrorConstant)
+    std::vector<double> stabilityIntervals_; // Интервалы устойчивости полиномов вариантов (StabilityInterval)
+    std::vector<double> accuracyScales_; // Шаг по точности варианта в единицах масштаба времени решения
+    double switchTimeScale_ = 0.0;       // Масштаб времени при последней смене схемы (0 - калибровка не нужна)
+    std::vector<DispsUsage> usage_;
+    size_t switches_ = 0;
+    int stepsSinceSwitch_ = 0;
+    double lastError_ = 0.0;             // Оценка погрешности последней попытки в единицах tolerance
+    double lastVn_ = 0.0;                // V_n последней попытки
+
+    static constexpr double SAFETY    = 0.8;
+    static constexpr double FAC_MIN   = 0.2;
+    static constexpr double GROWTH[3] = { 1.2, 1.1, 1.05 }; // Наибольший рост шага для схем порядка 1, 2, 3
+    static constexpr double SWITCH_GAIN   = 0.8; // Смена схемы, если её стоимость меньше текущей хотя бы на 20%
+    static constexpr int    SWITCH_HOLD   = 5;   // Наименьшее число шагов между добровольными сменами схемы
+    static constexpr double SWITCH_GROWTH = 2.0; // Наибольший рост шага при смене схемы
+
+    // Приём точки решения (первой - начальной); true прекращает решение
+    using PointSink = std::function<bool(double, const std::vector<double>&)>;
 
+    // Интегрирование от t0 до tEnd с передачей каждой принятой точки в sink
+    void Integrate(double t0,
+                   const std::vector<double>& y0,
+                   double tEnd,
+                   double tolerance,
+                   const PointSink& sink);
+
+    // Проверка после стадии k_{q+1}, по которой известна оценка погрешности схемы порядка q:
+    // false прекращает шаг, остальные стадии не вычисляются
+    using StageCheck = std::function<bool(const std::vector<std::vector<double>>&)>;
+
+    // Шаг варианта; пустой результат - шаг прекращён проверкой check
     std::vector<double> DoOneStep(double t,
                                   const std::vector<double>& y,
                                   double h,
                                   const DispsVariant& variant,
-                                  std::vector<std::vector<double>>& kStages);
+                                  std::vector<std::vector<double>>& kStages,
+                                  const StageCheck& check);
 
     // Шаги для различных схем
     static std::vector<double> Step3Stage(double t,
@@ -54,53 +133,65 @@ private:
                                           double h,
                                           std::function<std::vector<double>(double, const std::vector<double>&)> f,
                                           const std::vector<double>& p,
-                                          std::vector<std::vector<double>>& kStages);
+                                          std::vector<std::vector<double>>& kStages,
+                                          int checkStage,
+                                          const StageCheck& check);
 
     static std::vector<double> Step5Stage(double t,
                                           const std::vector<double>& y,
                                           double h,
                                           std::function<std::vector<double>(double, const std::vector<double>&)> f,
                                           const std::vector<double>& p,
-                                          std::vector<std::vector<double>>& kStages);
+                                          std::vector<std::vector<double>>& kStages,
+                                          int checkStage,
+                                          const StageCheck& check);
 
     static std::vector<double> Step6Stage(double t,
                                           const std::vector<double>& y,
                                           double h,
                                           std::function<std::vector<double>(double, const std::vector<double>&)> f,
                                           const std::vector<double>& p,
-                                          std::vector<std::vector<double>>& kStages);
+                                          std::vector<std::vector<double>>& kStages,
+                                          int checkStage,
+                                          const StageCheck& check);
 
-    // Контроль точности и устойчивости
-    bool Control1stOrder(const std::vector<std::vector<double>>& kStages,
+    // Оценка погрешности A', B', C' схемы текущего порядка q по стадиям k1..k_{q+1} и V_n
+    double ErrorEstimate(const std::vector<std::vector<double>>& kStages,
                          const std::vector<double>& yOld,
                          const std::vector<double>& yNew,
-                         double h,
                          double tolerance,
-                         double& newH,
-                         bool& needSwitch);
+                         double& Vn) const;
 
-    bool Control2ndOrder(const std::vector<std::vector<double>>& kStages,
-                         const std::vector<double>& yOld,
-                         const std::vector<double>& yNew,
-                         double h,
-                         double tolerance,
-                         double& newH,
-                         bool& needSwitch);
+    // Контроль точности и устойчивости
+    bool Control(const std::vector<std::vector<double>>& kStages,
+                 const std::vector<double>& yOld,
+                 const std::vector<double>& yNew,
+                 double h,
+                 double tolerance,
+                 double& newH,
+                 bool& needSwitch);
 
-    bool Control3rdOrder(const std::vector<std::vector<double>>& kStages,
-                         const std::vector<double>& yOld,
-                         const std::vector<double>& yNew,
-                         double h,
-                         double tolerance,
-                         double& newH,
-                         bool& needSwitch);
+    // Шаг после принятого шага: множитель регулятора, ограниченный границей устойчивости
+    // (интервал stabilityIntervals_ текущей схемы)
+    double AcceptedStep(double h, double err, double k, double Vn, bool needSwitch);
+
+    // Шаг, допустимый для варианта index по точности (accuracyScales_ * timeScale) и по устойчивости
+    // (h * stabilityIntervals_ / V_n для принятого шага h)
+    double PredictedStep(size_t index, double h, double timeScale) const;
 
-    // Выбор оптимальной схемы
-    void SwitchScheme(int currentOrder);
+    // Выбор схемы с наименьшим числом вычислений f на единицу времени (стадии / допустимый шаг).
+    // Без forced схема меняется не чаще раза в SWITCH_HOLD шагов и только при выигрыше SWITCH_GAIN
+    void SwitchScheme(double h, bool forced);
 
     // Вспомогательные функции для работы с векторами
     static std::vector<double> Add(const std::vector<double>& a, const std::vector<double>& b);
     static std::vector<double> Mul(double alpha, const std::vector<double>& v);
     static std::vector<double> Subtract(const std::vector<double>& a, const std::vector<double>& b);
     static double Norm(const std::vector<double>& v);
+
+    // Норма разности стадий в единицах tolerance: евклидова без допусков по компонентам
+    double ErrorNorm(const std::vector<double>& diff,
+                     const std::vector<double>& yOld,
+                     const std::vector<double>& yNew,
+                     double tolerance) const;
 };
@@ -0,0 +1,56 @@
+#pragma once
+#include "DISPSSolver.hpp"
+
+#include <vector>
+
+// Построение коэффициентов p схем DISPS. Таблица стадий каждой схемы фиксирована
+// (DISPSSolver::Step3Stage/Step5Stage/Step6Stage), свободны только веса p. Условия порядка
+// и совпадение константы погрешности линейны по p, поэтому поиск идёт по их нуль-пространству:
+// максимизируется интервал устойчивости [-gamma, 0] полинома R(z) = 1 + z * sum p_i g_i(z).
+// По умолчанию константа погрешности сохраняется: оценки погрешности по разностям стадий
+// в контроле точности DISPSSolver откалиброваны под неё. Без этого условия интервал длиннее
+// (5 стадий: 49.7 для порядка 1 и 19.3 для порядка 2 против 48.35 и 7.98 с ним), но такие
+// веса нельзя подставлять в Variants без пересмотра оценок погрешности.
+
+// Матрица стадий схемы DISPS с заданным числом стадий (3, 5 или 6): строка i -
+// коэффициенты при k_1..k_{i-1} в аргументе стадии k_i
+std::vector<std::vector<double>> DispsStageMatrix(int stages);
+
+// Коэффициенты r_0..r_s полинома устойчивости R(z) = sum r_k z^k схемы с весами p
+std::vector<double> DispsStabilityPolynomial(
+    int                        stages,
+    std::vector<double> const &p);
+
+// Константа погрешности: r_{order+1} - 1/(order+1)! (главный член погрешности на y' = lambda y)
+double DispsErrorConstant(
+    int                        stages,
+    int                        order,
+    std::vector<double> const &p);
+
+// Длина интервала устойчивости [-gamma, 0] полинома R (коэффициенты по возрастанию степени).
+// damping > 0 задаёт форму с затуханием: после первого спуска R до 1 - damping
+// должно выполняться |R| <= 1 - damping. Граница - наименьший корень R(-x) = ±1 (± (1 - damping)),
+// корни ищутся точно, касания границы в экстремумах R не сокращают интервал
+double StabilityInterval(
+    std::vector<double> const &poly,
+    double                     damping = 0.0);
+
+struct DispsDesignOptions
+{
+    int      stages = 5;
+    int      order = 2;
+    double   damping = 0.0;      // Форма полинома устойчивости (см. StabilityInterval)
+    bool     matchError = true;  // Сохранить константу погрешности errorConstant
+    double   errorConstant = 0.0;
+    int      starts = 64;        // Число стартов многостартового поиска
+    unsigned seed = 1;
+};
+
+struct DispsDesignResult
+{
+    DispsVariant variant;
+    double       errorConstant;
+};
+
+// Многостартовый поиск Нелдера-Мида на общем пуле потоков
+DispsDesignResult DesignDisps(DispsDesignOptions const &options);
@@ -0,0 +1,130 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <vector>
+
+// Дуальное число для прямого автоматического дифференцирования:
+// значение и N производных по направлениям, вычисляемых за один проход.
+template <size_t N>
+struct Dual
+{
+    double                value = 0.0;
+    std::array<double, N> d{};
+
+    Dual() = default;
+    Dual(double v) : value(v) {}
+
+    Dual& operator+=(Dual const &o) { value += o.value; for (size_t i = 0; i < N; ++i) d[i] += o.d[i]; return *this; }
+    Dual& operator-=(Dual const &o) { value -= o.value; for (size_t i = 0; i < N; ++i) d[i] -= o.d[i]; return *this; }
+    Dual& operator*=(Dual const &o) { return *this = *this * o; }
+    Dual& operator/=(Dual const &o) { return *this = *this / o; }
+
+    // Цепное правило для функции одной переменной: g(u), g'(u)
+    static Dual Chain(Dual const &u, double g, double dg)
+    {
+        Dual r(g);
+        for (size_t i = 0; i < N; ++i)
+            r.d[i] = dg * u.d[i];
+        return r;
+    }
+
+    friend Dual operator+(Dual a, Dual const &b) { return a += b; }
+    friend Dual operator-(Dual a, Dual const &b) { return a -= b; }
+
+    friend Dual operator-(Dual const &a)
+    {
+        Dual r(-a.value);
+        for (size_t i = 0; i < N; ++i)
+            r.d[i] = -a.d[i];
+        return r;
+    }
+
+    friend Dual operator*(Dual const &a, Dual const &b)
+    {
+        Dual r(a.value * b.value);
+        for (size_t i = 0; i < N; ++i)
+            r.d[i] = a.d[i] * b.value + a.value * b.d[i];
+        return r;
+    }
+
+    friend Dual operator/(Dual const &a, Dual const &b)
+    {
+        double inv = 1.0 / b.value;
+        Dual r(a.value * inv);
+        for (size_t i = 0; i < N; ++i)
+            r.d[i] = (a.d[i] - r.value * b.d[i]) * inv;
+        return r;
+    }
+
+    friend Dual sin(Dual const &u)  { return Chain(u, std::sin(u.value), std::cos(u.value)); }
+    friend Dual cos(Dual const &u)  { return Chain(u, std::cos(u.value), -std::sin(u.value)); }
+    friend Dual exp(Dual const &u)  { double e = std::exp(u.value); return Chain(u, e, e); }
+    friend Dual log(Dual const &u)  { return Chain(u, std::log(u.value), 1.0 / u.value); }
+    friend Dual tanh(Dual const &u) { double th = std::tanh(u.value); return Chain(u, th, 1.0 - th * th); }
+    friend Dual fabs(Dual const &u) { return Chain(u, std::fabs(u.value), u.value < 0.0 ? -1.0 : 1.0); }
+
+    friend Dual sqrt(Dual const &u)
+    {
+        double s = std::sqrt(u.value);
+        return Chain(u, s, 0.5 / s);
+    }
+
+    friend Dual pow(Dual const &u, double p)
+    {
+        return Chain(u, std::pow(u.value, p), p * std::pow(u.value, p - 1.0));
+    }
+};
+
+// Матрица Якоби df/dy по столбцам: за один проход вычисляется N столбцов,
+// модель f должна быть шаблоном по скалярному типу: f(t, std::vector<T>) -> std::vector<T>
+template <size_t N = 4, typename Model>
+std::vector<std::vector<double>> JacobianAD(
+    Model const               &f,
+    double                     t,
+    std::vector<double> const &y)
+{
+    size_t n = y.size();
+    std::vector<std::vector<double>> J(n, std::vector<double>(n, 0.0));
+    std::vector<Dual<N>> x(n);
+
+    for (size_t first = 0; first < n; first += N)
+    {
+        for (size_t j = 0; j < n; ++j)
+        {
+            x[j] = Dual<N>(y[j]);
+            if (j >= first && j < first + N)
+                x[j].d[j - first] = 1.0;
+        }
+
+        std::vector<Dual<N>> fx = f(t, x);
+        for (size_t i = 0; i < n; ++i)
+            for (size_t k = 0; k < N && first + k < n; ++k)
+                J[i][first + k] = fx[i].d[k];
+    }
+
+    return J;
+}
+
+// Произведение матрицы Якоби на вектор J(t, y) * v без построения матрицы
+template <typename Model>
+std::vector<double> JacobianVectorProductAD(
+    Model const               &f,
+    double                     t,
+    std::vector<double> const &y,
+    std::vector<double> const &v)
+{
+    size_t n = y.size();
+    std::vector<Dual<1>> x(n);
+    for (size_t j = 0; j < n; ++j)
+    {
+        x[j] = Dual<1>(y[j]);
+        x[j].d[0] = v[j];
+    }
+
+    std::vector<Dual<1>> fx = f(t, x);
+    std::vector<double> Jv(n);
+    for (size_t i = 0; i < n; ++i)
+        Jv[i] = fx[i].d[0];
+
+    return Jv;
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include "Solver.hpp"
+#include "PhiFunctions.hpp"
+#include "LinearSolvers.hpp"
+
+// Экспоненциальный метод Рунге-Кутты ETDRK4 (Кокс-Мэттьюс, φ-коэффициенты Хохбрук-Остерманн)
+// для y' = L y + N(t, y) с постоянным оператором L. Линейная часть интегрируется точно,
+// поэтому шаг ограничивает только N: для линейных систем с гладкой правой частью
+// шаг определяется изменением вынуждающего члена.
+// L - матрица Якоби линейной части в начальной точке (её задаёт базовый класс Solver:
+// SetJacobian и SetSparsity относятся к линейной части), N = f - L y.
+// φ(hL) при n <= DENSE_LIMIT вычисляются плотно и берутся из PhiCache (общий для шагов
+// и запросов), иначе произведения φ(hL) v строятся по рациональному подпространству
+// Крылова с разложением I - PHI_SHIFT*h*L, которое хранится для каждого h
+// (LinearSolverKind::Krylov - полиномиальное подпространство без разложений).
+// Шаг выбирается из ряда h0 * 2^k, чтобы φ-функции и разложения повторно использовались.
+class ETDRK4Solver : public Solver
+{
+public:
+    // func - полная правая часть f, linearPart - её линейная часть L y
+    ETDRK4Solver(
+        std::function<std::vector<double>(
+            double,
+            std::vector<double> const &)> func,
+        std::function<std::vector<double>(
+            double,
+            std::vector<double> const &)> linearPart,
+        double                            initialStep,
+        LinearSolverKind                  kind = LinearSolverKind::Auto
+    ) : Solver(linearPart, initialStep), rhs(func), linearSolverKind(kind) {}
+
+    void Step(
+        double               t,
+        std::vector<double> &y,
+        double              &h,
+        double               tolerance) override;
+
+    void Solve(
+        double                     t0,
+        std::vector<double> const &y0,
+        double                     tEnd,
+        Storage                   &storage,
+        double                     tolerance) override;
+
+private:
+    static constexpr size_t DENSE_LIMIT   = 64;
+    static constexpr double KRYLOV_FACTOR = 1e-3;   // Точность φ(hL) v относительно допуска
+    static constexpr double GROW_ERROR    = 1.0 / 16.0; // Шаг удваивается, если ошибка ниже
+
+    std::function<std::vector<double>(double, const std::vector<double>&)> rhs;
+
+    LinearSolverKind                                 linearSolverKind;
+    std::map<double, std::unique_ptr<LinearSolver>>  shifted; // Разложения I - PHI_SHIFT*h*L по шагам
+
+    size_t              n = 0;
+    CsrMatrix           L;
+    std::vector<double> denseL;
+    std::vector<double> scale;
+    double              tol = 0.0;
+
+    double Norm(std::vector<double> const &v) const;
+
+    // N(t, y) = f(t, y) - L y
+    std::vector<double> Nonlinear(
+        double                     t,
+        std::vector<double> const &y);
+
+    // Σ φ_k(h L) v_k
+    std::vector<double> Phi(
+        double                                  h,
+        std::vector<std::vector<double>> const &v);
+
+    // Шаг ETDRK4; возвращает оценку погрешности (по вложенному решению второго порядка)
+    double TryStep(
+        double                     t,
+        std::vector<double> const &y,
+        double                     h,
+        std::vector<double>       &yNew);
+};
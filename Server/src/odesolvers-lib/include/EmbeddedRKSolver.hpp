@@ -0,0 +1,101 @@
+#pragma once
+#include "Solver.hpp"
+
+#include <string>
+
+// Вложенная пара явных методов Рунге-Кутты с плотной выдачей
+struct EmbeddedTableau
+{
+    std::string                      name;
+    int                              order;      // Порядок решения
+    int                              errorOrder; // Порядок оценки погрешности: шаг меняется как err^(-1/(errorOrder+1))
+    size_t                           stages;     // Число основных стадий; последняя - f(t + h, y_{n+1}) (FSAL)
+    std::vector<double>              c;          // Узлы всех стадий, включая дополнительные стадии плотной выдачи
+    std::vector<std::vector<double>> A;          // Строка i - коэффициенты при k_1..k_i в аргументе стадии k_{i+1}
+    std::vector<double>              b;          // Веса решения по основным стадиям
+    std::vector<double>              e;          // Веса оценки погрешности b - b^
+    std::vector<double>              e3;         // Вторая оценка (DOP853: порядок 3), пусто - не используется
+    std::vector<std::vector<double>> dense;      // b_i(theta) = sum_p dense[i][p] theta^p по всем стадиям
+};
+
+// Имена доступных пар: DP5 (Дорманд-Принс 5(4)), Tsit5 (Цитурас 5(4)), DOP853 (Дорманд-Принс 8(5,3))
+std::vector<std::string> EmbeddedPairs();
+
+EmbeddedTableau EmbeddedPair(std::string const &name);
+
+// Стандартный драйвер вложенной пары: контроль погрешности по смешанной норме
+// tol * (1 + |y|), FSAL (f в конце принятого шага - первая стадия следующего),
+// после отказа шаг не увеличивается. Плотная выдача y(t + theta h) на принятом шаге
+// требует только дополнительных стадий таблицы (у DOP853 - трёх), они вычисляются
+// лишь при запросе точки внутри шага.
+class EmbeddedRKSolver : public Solver
+{
+public:
+    EmbeddedRKSolver(
+        std::function<std::vector<double>(
+            double,
+            std::vector<double> const &)> func,
+        double                            initialStep,
+        EmbeddedTableau                   tableau
+    ) : Solver(func, initialStep), tableau(std::move(tableau))
+    {
+        controller.SetLimits(SAFETY, FAC_MIN, FAC_MAX);
+    }
+
+    // Выдача решения на равномерной сетке с шагом outputStep по плотной выдаче
+    // вместо точек принятых шагов (0 - точки шагов)
+    void SetOutputStep(double step) { outputStep = step; }
+
+    void Step(
+        double               t,
+        std::vector<double> &y,
+        double              &h,
+        double               tolerance) override;
+
+    void Solve(
+        double                     t0,
+        std::vector<double> const &y0,
+        double                     tEnd,
+        Storage                   &storage,
+        double                     tolerance) override;
+
+    // Значение плотной выдачи в точке t последнего принятого шага
+    std::vector<double> Interpolate(double t);
+
+private:
+    static constexpr double SAFETY  = 0.9;
+    static constexpr double FAC_MIN = 0.2;
+    static constexpr double FAC_MAX = 10.0;
+
+    EmbeddedTableau tableau;
+    double          outputStep = 0.0;
+
+    size_t n = 0;
+    bool   fsalInEstimate = false;
+    std::vector<double>              scale;
+    std::vector<std::vector<double>> k;     // Производные стадий (по всем стадиям таблицы)
+    std::vector<double>              stage; // Аргумент стадии
+
+    // Последний принятый шаг [stepStart, stepStart + stepLength] для плотной выдачи
+    double              stepStart = 0.0;
+    double              stepLength = 0.0;
+    std::vector<double> yStart;
+    bool                denseReady = false;
+
+    double Norm(std::vector<double> const &v) const;
+
+    // Аргумент стадии i: y + h * sum_j A[i][j] k_j
+    void StageArgument(
+        size_t                     i,
+        std::vector<double> const &y,
+        double                     h);
+
+    // Основные стадии со второй (k_1 уже вычислена), yNew - решение;
+    // возвращает норму оценки погрешности относительно допуска
+    double TryStep(
+        double                     t,
+        std::vector<double> const &y,
+        double                     h,
+        std::vector<double>       &yNew,
+        double                     tolerance);
+};
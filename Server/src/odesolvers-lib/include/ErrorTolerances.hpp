@@ -0,0 +1,85 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+// Норма взвешенной погрешности: RMS (по умолчанию) или максимум по компонентам
+enum class ErrorNormKind
+{
+    RMS,
+    Max
+};
+
+// Имя из запроса: RMS (по умолчанию, пустая строка), Max
+ErrorNormKind ParseErrorNormKind(std::string const &name);
+
+// Допуски по компонентам. Масштаб погрешности компоненты i:
+// sc_i = atol_i + rtol_i * max(|y_i|, |ŷ_i|) (ŷ - решение в конце шага);
+// вектор из одного элемента относится ко всем компонентам. Без заданных допусков
+// atol_i = rtol_i = tolerance, т. е. sc_i = tolerance * (1 + max(|y_i|, |ŷ_i|)).
+// Шаг принимается, если норма e_i / sc_i не больше 1.
+class ErrorTolerances
+{
+public:
+    ErrorTolerances() = default;
+
+    ErrorTolerances(
+        std::vector<double> atol,
+        std::vector<double> rtol,
+        ErrorNormKind       norm = ErrorNormKind::RMS);
+
+    // Заданы ли допуски по компонентам (иначе решатели с собственными нормами
+    // сравнивают погрешность со скалярным допуском, как прежде)
+    bool Componentwise() const { return !atol.empty() || !rtol.empty(); }
+
+    ErrorNormKind NormKind() const { return norm; }
+
+    // Проверка размеров векторов допусков для системы размерности n
+    void Validate(size_t n) const;
+
+    // Масштабы sc_i
+    void Scales(
+        double                     tolerance,
+        std::vector<double> const &y,
+        std::vector<double> const &yNew,
+        std::vector<double>       &scale) const;
+
+    // Норма v_i / scale_i
+    double Norm(
+        std::vector<double> const &v,
+        std::vector<double> const &scale) const;
+
+    // Норма e_i / sc_i без промежуточного вектора масштабов
+    double Norm(
+        std::vector<double> const &e,
+        std::vector<double> const &y,
+        std::vector<double> const &yNew,
+        double                     tolerance) const;
+
+    // Масштаб sc_i одной компоненты - для норм, накапливаемых прямо в циклах решателя
+    double Scale(
+        size_t i,
+        double tolerance,
+        double y,
+        double yNew) const
+    {
+        return Absolute(i, tolerance) + Relative(i, tolerance) * std::max(std::fabs(y), std::fabs(yNew));
+    }
+
+    // atol_i и rtol_i; не заданные - tolerance
+    double Absolute(size_t i, double tolerance) const
+    {
+        return atol.empty() ? tolerance : atol[atol.size() == 1 ? 0 : i];
+    }
+
+    double Relative(size_t i, double tolerance) const
+    {
+        return rtol.empty() ? tolerance : rtol[rtol.size() == 1 ? 0 : i];
+    }
+
+private:
+    std::vector<double> atol;
+    std::vector<double> rtol;
+    ErrorNormKind       norm = ErrorNormKind::RMS;
+};
@@ -9,7 +9,10 @@ public:
             double,
             std::vector<double> const &)> func,
         double                            initialStep)
-        : Solver(func, initialStep) {}
+        : Solver(func, initialStep)
+    {
+        controller.SetLimits(SAFETY_FACTOR, MIN_FACTOR, MAX_FACTOR);
+    }
 
     void Step(
         double               t,
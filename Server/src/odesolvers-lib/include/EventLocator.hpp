@@ -0,0 +1,82 @@
+#pragma once
+#include <functional>
+#include <vector>
+
+// Функции событий g_i(t, y): все значения за одно вычисление
+using EventFunction = std::function<std::vector<double>(
+    double,
+    std::vector<double> const &)>;
+
+struct EventSettings
+{
+    bool terminal  = false; // Остановить интегрирование в точке события
+    int  direction = 0;     // 0 - любая смена знака g_i, +1 - только рост, -1 - только убывание
+};
+
+// Сведения решателя о принятом шаге в точку (t, y) для уточнения корней
+struct StepOutput
+{
+    double start = 0.0; // Начало шага плотной выдачи
+    // Плотная выдача решателя: y(t) на [start, t] (пусто - интерполянт Эрмита)
+    std::function<std::vector<double>(double)> dense;
+    // f(t, y), если решатель её уже вычислил (nullptr - вычисляется при необходимости)
+    std::vector<double> const *derivative = nullptr;
+};
+
+struct EventRecord
+{
+    size_t              index; // Номер функции события
+    double              t;
+    std::vector<double> y;
+};
+
+// Поиск событий g_i(t, y) = 0 на принятых шагах. Смена знака g_i между концами шага
+// означает корень; он уточняется методом Иллинойс по плотной выдаче решателя, если она
+// покрывает проверяемый отрезок, иначе по кубическому интерполянту Эрмита по y и f в концах.
+// f в концах берётся из StepOutput::derivative текущей и предыдущей точек, недостающие
+// значения вычисляются (до двух вычислений f на шаг с событием).
+// Несколько корней одной функции внутри шага (чётное число смен знака) не обнаруживаются.
+class EventLocator
+{
+public:
+    EventLocator(
+        EventFunction              events,
+        std::vector<EventSettings> settings,
+        std::function<std::vector<double>(
+            double,
+            std::vector<double> const &)> func);
+
+    // Начальная точка интегрирования; записанные события сбрасываются
+    void Start(
+        double                     t,
+        std::vector<double> const &y,
+        std::vector<double> const *derivative = nullptr);
+
+    // Проверка шага из предыдущей точки в (t, y). События на шаге записываются по порядку t;
+    // при терминальном событии (t, y) заменяется точкой события и возвращается true
+    bool Check(
+        double              &t,
+        std::vector<double> &y,
+        StepOutput const    &step = {});
+
+    std::vector<EventRecord> const &Records() const { return records; }
+
+private:
+    static constexpr int    MAX_ITERATIONS = 60;
+    static constexpr double ROOT_TOLERANCE = 1e-12; // Точность корня в долях шага
+
+    EventFunction              g;
+    std::vector<EventSettings> settings;
+    std::function<std::vector<double>(double, std::vector<double> const &)> f;
+
+    double              tPrev = 0.0;
+    std::vector<double> yPrev;
+    std::vector<double> gPrev;
+    std::vector<double> fPrev; // f(tPrev, yPrev), если известна
+    std::vector<EventRecord> records;
+
+    bool Crossed(
+        size_t i,
+        double before,
+        double after) const;
+};
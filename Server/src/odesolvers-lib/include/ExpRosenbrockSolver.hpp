@@ -0,0 +1,53 @@
+#pragma once
+#include "Solver.hpp"
+#include "PhiFunctions.hpp"
+#include "LinearSolvers.hpp"
+
+// Экспоненциальный метод Розенброка exprb32 (Хохбрук, Остерманн, Швайцер): на каждом шаге
+// f(t, y) линеаризуется матрицей Якоби J в начале шага, J y интегрируется точно,
+// остаток g = f - J y - поправкой с φ3. Порядок 3, вложенное решение второго порядка
+// (экспоненциальный метод Эйлера) даёт оценку погрешности. Произведения φ(hJ) v
+// строятся по рациональному подпространству Крылова с разложением I - PHI_SHIFT*h*J
+// подключаемым линейным решателем (LinearSolverKind::Krylov - полиномиальное
+// подпространство без разложений), поэтому метод годится и для больших разреженных систем.
+class ExpRosenbrockSolver : public Solver
+{
+public:
+    ExpRosenbrockSolver(
+        std::function<std::vector<double>(
+            double,
+            std::vector<double> const &)> func,
+        double                            initialStep,
+        LinearSolverKind                  kind = LinearSolverKind::Auto
+    ) : Solver(func, initialStep), linearSolverKind(kind)
+    {
+        controller.SetLimits(SAFETY, FAC_MIN, FAC_MAX);
+    }
+
+    void Step(
+        double               t,
+        std::vector<double> &y,
+        double              &h,
+        double               tolerance) override;
+
+    void Solve(
+        double                     t0,
+        std::vector<double> const &y0,
+        double                     tEnd,
+        Storage                   &storage,
+        double                     tolerance) override;
+
+private:
+    static constexpr double KRYLOV_FACTOR = 1e-3;
+    static constexpr double SAFETY        = 0.9;
+    static constexpr double FAC_MIN       = 0.2;
+    static constexpr double FAC_MAX       = 5.0;
+
+    LinearSolverKind              linearSolverKind;
+    std::unique_ptr<LinearSolver> shifted;
+
+    size_t              n = 0;
+    std::vector<double> scale;
+
+    double Norm(std::vector<double> const &v) const;
+};
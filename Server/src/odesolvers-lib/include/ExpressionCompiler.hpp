@@ -0,0 +1,112 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <stdexcept>
+
+#include "SparseJacobian.hpp"
+
+// Откомпилированная система правых частей y' = f(t, y, p).
+// Регистровый байт-код: регистр 0 - t, затем y[0..n), параметры p[0..m),
+// константы и временные значения. Константы и параметры свёрнуты и
+// дедуплицированы на этапе компиляции, общие подвыражения вычисляются один раз.
+class ExpressionProgram
+{
+public:
+    enum OpCode : uint8_t
+    {
+        OpAdd,
+        OpSub,
+        OpMul,
+        OpDiv,
+        OpNeg,
+        OpPow,
+        OpSqr,
+        OpSqrt,
+        OpExp,
+        OpLog,
+        OpSin,
+        OpCos,
+        OpTan,
+        OpSinh,
+        OpCosh,
+        OpTanh,
+        OpAtan,
+        OpAbs,
+        OpMin,
+        OpMax
+    };
+
+    struct Instruction
+    {
+        OpCode   op;
+        uint32_t dst;
+        uint32_t a;
+        uint32_t b;
+    };
+
+    // Вычисление всех правых частей: out[i] = f_i(t, y, params)
+    void Evaluate(
+        double        t,
+        double const *y,
+        double const *params,
+        double       *out) const;
+
+    size_t Dimension() const { return outputs.size(); }
+    size_t InstructionCount() const { return code.size(); }
+    std::vector<std::string> const &ParameterNames() const { return parameterNames; }
+
+    // Точная структура матрицы Якоби: от каких y_j зависит каждое f_i
+    CsrPattern DependencyPattern() const;
+
+    // Зависит ли хотя бы одна из функций от y_j, first <= j < last
+    bool DependsOn(
+        size_t first,
+        size_t last) const;
+
+private:
+    friend class ExpressionCompiler;
+
+    size_t                   dimension = 0;
+    std::vector<std::string> parameterNames;
+    std::vector<double>      registerTemplate; // Начальное содержимое регистров (константы)
+    std::vector<Instruction> code;
+    std::vector<uint32_t>    outputs;          // Регистры с результатами f_i
+
+    uint32_t YRegister(size_t i) const { return static_cast<uint32_t>(1 + i); }
+    uint32_t ParameterRegister(size_t i) const { return static_cast<uint32_t>(1 + dimension + i); }
+
+    // Отсортированные номера y_j, от которых зависит каждый результат
+    std::vector<std::vector<uint32_t>> OutputDependencies() const;
+};
+
+class ExpressionCompiler
+{
+public:
+    // Компиляция системы выражений (по одному на компоненту y).
+    // Переменные: t, y0..y{n-1}, константы pi и e; прочие идентификаторы - параметры.
+    // dimension - число переменных y (0 - по числу выражений; иначе выражения - функции
+    // состояния, например функции событий). Результат кэшируется по хэшу исходного текста.
+    static std::shared_ptr<ExpressionProgram const> Compile(
+        std::vector<std::string> const &expressions,
+        size_t                          dimension = 0);
+
+private:
+    struct CacheEntry
+    {
+        std::string                              source;
+        std::shared_ptr<ExpressionProgram const> program;
+    };
+
+    static constexpr size_t MAX_CACHE_SIZE = 256;
+
+    static std::mutex                              cacheMutex;
+    static std::unordered_map<size_t, CacheEntry>  cache;
+
+    static std::shared_ptr<ExpressionProgram const> Build(
+        std::vector<std::string> const &expressions,
+        size_t                          dimension);
+};
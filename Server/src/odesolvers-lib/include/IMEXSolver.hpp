@@ -0,0 +1,105 @@
+#pragma once
+#include "Solver.hpp"
+#include "LinearSolvers.hpp"
+
+// Аддитивный метод Рунге-Кутты (IMEX) для f = f_explicit + f_implicit, порядок 2.
+// Нежёсткая часть интегрируется явными стадиями схемы DISPS23 (те же коэффициенты,
+// интервал устойчивости 6), жёсткая часть - L-устойчивым методом ESDIRK с теми же
+// узлами и весами: каждая неявная стадия решает (I - h*GAMMA*J_implicit) Y = r,
+// разложение одно на все стадии и переиспользуется между шагами.
+// Шаг ограничивается точностью и оценкой h*rho(J_explicit) только явной части.
+// Базовый класс Solver описывает жёсткую часть: SetJacobian и SetSparsity
+// относятся к f_implicit.
+class IMEXSolver : public Solver
+{
+public:
+    // func - полная правая часть f, implicitPart - её жёсткая часть
+    IMEXSolver(
+        std::function<std::vector<double>(
+            double,
+            std::vector<double> const &)> func,
+        std::function<std::vector<double>(
+            double,
+            std::vector<double> const &)> implicitPart,
+        double                            initialStep,
+        LinearSolverKind                  kind = LinearSolverKind::Auto
+    ) : Solver(implicitPart, initialStep), rhs(func), linearSolverKind(kind)
+    {
+        controller.SetLimits(SAFETY, FAC_MIN, FAC_MAX);
+    }
+
+    void Step(
+        double               t,
+        std::vector<double> &y,
+        double              &h,
+        double               tolerance) override;
+
+    void Solve(
+        double                     t0,
+        std::vector<double> const &y0,
+        double                     tEnd,
+        Storage                   &storage,
+        double                     tolerance) override;
+
+private:
+    // Явная часть: DISPS23, узлы 0, 2/3, 2/3
+    static constexpr double C2  = 2.0 / 3.0;
+    static constexpr double E21 = 2.0 / 3.0;
+    static constexpr double E31 = 1.0 / 3.0;
+    static constexpr double E32 = 1.0 / 3.0;
+
+    // Неявная часть: ESDIRK с GAMMA = 1 - 1/sqrt(2); I31, I32 выбраны так, чтобы
+    // функция устойчивости с весами DISPS23 обращалась в ноль на бесконечности
+    static constexpr double GAMMA = 0.29289321881345247560;
+    static constexpr double I21   = 0.37377344785321419107;
+    static constexpr double I31   = 0.05861124903796264701;
+    static constexpr double I32   = 0.31516219881525154406;
+
+    // Веса DISPS23 (B3 = 3/4 - B2, точное условие второго порядка)
+    static constexpr double B1 = 0.25;
+    static constexpr double B2 = 0.461290700433682;
+    static constexpr double B3 = 0.288709299566318;
+
+    static constexpr double STABILITY_BOUND = 6.0;  // Интервал устойчивости явной части
+    static constexpr double ERROR_FACTOR    = 0.5;  // Отношение главного члена ошибки к h*(F3 - F2)
+    static constexpr double SAFETY          = 0.9;
+    static constexpr double FAC_MIN         = 0.2;
+    static constexpr double FAC_MAX         = 5.0;
+    static constexpr int    MAX_NEWTON      = 5;
+    static constexpr double NEWTON_TOL      = 0.1;  // Точность итераций Ньютона относительно допуска
+    static constexpr double GAMMA_CHANGE    = 0.3;  // Новое разложение при изменении h*GAMMA более чем на 30%
+    static constexpr int    JACOBIAN_AGE    = 20;
+
+    std::function<std::vector<double>(double, const std::vector<double>&)> rhs;
+
+    LinearSolverKind              linearSolverKind;
+    std::unique_ptr<LinearSolver> linear;
+
+    size_t n = 0;
+    bool   needJacobian = true;
+    bool   jacobianCurrent = false;
+    int    jacobianAge = 0;
+    double gammaFactored = 0.0; // h*GAMMA, для которого построено разложение
+    double eta = 1.0;           // Оценка theta / (1 - theta) скорости сходимости Ньютона
+
+    CsrMatrix           J;
+    std::vector<double> scale;
+
+    double Norm(std::vector<double> const &v) const;
+
+    // Неявная стадия Y = r + h*GAMMA*f_implicit(t, Y); fi - f_implicit(t, Y).
+    // false - нет сходимости итераций Ньютона
+    bool SolveStage(
+        double                     t,
+        double                     h,
+        std::vector<double> const &r,
+        std::vector<double>       &Y,
+        std::vector<double>       &fi);
+
+    // Попытка шага; true - шаг принят, h - следующий шаг
+    bool TryStep(
+        double              &t,
+        std::vector<double> &y,
+        double              &h,
+        double               tolerance);
+};
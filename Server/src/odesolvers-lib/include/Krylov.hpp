@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+struct GmresResult
+{
+    size_t iterations = 0;   // Число умножений на матрицу
+    double residual   = 0.0; // Взвешенная норма невязки
+    bool   converged  = false;
+};
+
+// Решение A x = b методом GMRES(restart) с правым предобусловливанием без
+// хранения матрицы: нужна только процедура умножения A на вектор. Память -
+// restart + 1 векторов базиса. Норма невязки - среднеквадратичная с весами
+// weights (как в оценке погрешности метода), начальное приближение x = 0.
+GmresResult Gmres(
+    std::function<void(std::vector<double> const &, std::vector<double> &)> const &multiply,
+    std::function<void(std::vector<double> &)> const                              &precondition,
+    std::vector<double> const                                                     &b,
+    std::vector<double>                                                           &x,
+    std::vector<double> const                                                     &weights,
+    double                                                                         tolerance,
+    size_t                                                                         restart,
+    size_t                                                                         maxRestarts);
@@ -0,0 +1,90 @@
+#pragma once
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <stdexcept>
+
+// Абсолютная величина для вещественного и комплексного случаев
+inline double Magnitude(double x) { return std::fabs(x); }
+inline double Magnitude(std::complex<double> const &x) { return std::abs(x); }
+
+// LU-разложение плотной матрицы n x n (по строкам) с частичным выбором ведущего элемента.
+// Разложение хранится и повторно используется для любого числа правых частей.
+template <typename T>
+class DenseLU
+{
+public:
+    // Возвращает false, если матрица вырождена
+    bool Factorize(
+        std::vector<T> matrix,
+        size_t         size)
+    {
+        n = size;
+        lu = std::move(matrix);
+        pivots.resize(n);
+
+        for (size_t k = 0; k < n; ++k)
+        {
+            size_t p = k;
+            double best = Magnitude(lu[k * n + k]);
+            for (size_t i = k + 1; i < n; ++i)
+            {
+                double v = Magnitude(lu[i * n + k]);
+                if (v > best)
+                {
+                    best = v;
+                    p = i;
+                }
+            }
+
+            pivots[k] = p;
+            if (best == 0.0)
+                return false;
+
+            if (p != k)
+                for (size_t j = 0; j < n; ++j)
+                    std::swap(lu[k * n + j], lu[p * n + j]);
+
+            T inv = T(1.0) / lu[k * n + k];
+            for (size_t i = k + 1; i < n; ++i)
+            {
+                T m = lu[i * n + k] * inv;
+                lu[i * n + k] = m;
+                if (m == T(0.0))
+                    continue;
+                for (size_t j = k + 1; j < n; ++j)
+                    lu[i * n + j] -= m * lu[k * n + j];
+            }
+        }
+
+        return true;
+    }
+
+    // Решение A x = b, результат записывается в b
+    void Solve(std::vector<T> &b) const
+    {
+        // Перестановки применяются целиком до прямого хода, как в LAPACK getrs
+        for (size_t k = 0; k < n; ++k)
+            if (pivots[k] != k)
+                std::swap(b[k], b[pivots[k]]);
+
+        for (size_t k = 0; k < n; ++k)
+            for (size_t i = k + 1; i < n; ++i)
+                b[i] -= lu[i * n + k] * b[k];
+
+        for (size_t k = n; k-- > 0;)
+        {
+            T sum = b[k];
+            for (size_t j = k + 1; j < n; ++j)
+                sum -= lu[k * n + j] * b[j];
+            b[k] = sum / lu[k * n + k];
+        }
+    }
+
+    size_t Size() const { return n; }
+
+private:
+    size_t              n = 0;
+    std::vector<T>      lu;
+    std::vector<size_t> pivots;
+};
@@ -0,0 +1,126 @@
+#pragma once
+#include "SparseJacobian.hpp"
+#include "LinearAlgebra.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Решатели линейных систем с матрицей итераций неявных методов M = I - gamma * J.
+// Разложение строится один раз и используется для любого числа правых частей,
+// пока метод не изменит gamma или матрицу Якоби.
+class LinearSolver
+{
+public:
+    virtual ~LinearSolver() = default;
+
+    // Разложение M = I - gamma * J; false - матрица вырождена
+    virtual bool Factorize(
+        CsrMatrix const &J,
+        double           gamma) = 0;
+
+    // Решение M x = b, результат записывается в b
+    virtual void Solve(std::vector<double> &b) const = 0;
+
+    virtual char const *Name() const = 0;
+};
+
+enum class LinearSolverKind
+{
+    Auto,   // Выбор по размеру и структуре матрицы Якоби
+    Dense,
+    Banded,
+    Sparse,
+    Krylov  // Без матрицы: GMRES с производными по направлению (только BDFSolver)
+};
+
+LinearSolverKind ParseLinearSolverKind(std::string const &name);
+
+// Ширина ленты: J[i][j] != 0 только при -lower <= j - i <= upper
+void Bandwidth(
+    CsrPattern const &pattern,
+    size_t           &lower,
+    size_t           &upper);
+
+// Упорядочение минимальной степени для уменьшения заполнения при разложении
+std::vector<size_t> MinimumDegreeOrder(CsrPattern const &pattern);
+
+std::unique_ptr<LinearSolver> MakeLinearSolver(
+    LinearSolverKind  kind,
+    CsrPattern const &pattern);
+
+class DenseLinearSolver : public LinearSolver
+{
+public:
+    bool Factorize(
+        CsrMatrix const &J,
+        double           gamma) override;
+
+    void Solve(std::vector<double> &b) const override { lu.Solve(b); }
+
+    char const *Name() const override { return "Dense"; }
+
+private:
+    DenseLU<double> lu;
+};
+
+// Ленточное LU-разложение с частичным выбором ведущего элемента (как LAPACK gbtrf):
+// из-за перестановок верхняя лента расширяется на lower диагоналей.
+class BandedLinearSolver : public LinearSolver
+{
+public:
+    BandedLinearSolver(
+        size_t lower,
+        size_t upper)
+        : kl(lower), ku(upper) {}
+
+    bool Factorize(
+        CsrMatrix const &J,
+        double           gamma) override;
+
+    void Solve(std::vector<double> &b) const override;
+
+    char const *Name() const override { return "Banded"; }
+
+private:
+    size_t              n = 0;
+    size_t              kl;
+    size_t              ku;
+    size_t              width = 0; // 2 * kl + ku + 1 элементов на строку
+    std::vector<double> band;
+    std::vector<size_t> pivots;
+
+    double &At(size_t i, size_t j) { return band[i * width + (j + kl - i)]; }
+    double  At(size_t i, size_t j) const { return band[i * width + (j + kl - i)]; }
+};
+
+// Разреженное LU-разложение без выбора ведущего элемента. Строки и столбцы
+// переставляются в порядке минимальной степени, структура заполнения вычисляется
+// один раз для данной структуры J, повторные разложения только пересчитывают числа.
+// Для M = I - gamma * J с небольшим gamma диагональ преобладает, что и делает отказ
+// от выбора ведущего элемента допустимым; нулевой ведущий элемент сообщается как
+// вырожденность, и метод уменьшает шаг.
+class SparseLinearSolver : public LinearSolver
+{
+public:
+    explicit SparseLinearSolver(CsrPattern const &pattern);
+
+    bool Factorize(
+        CsrMatrix const &J,
+        double           gamma) override;
+
+    void Solve(std::vector<double> &b) const override;
+
+    char const *Name() const override { return "Sparse"; }
+
+    size_t FillNonZeros() const { return lu.pattern.NonZeros(); }
+
+private:
+    CsrMatrix           lu;          // L (без единичной диагонали) и U в одной структуре
+    std::vector<size_t> permutation; // Новый номер -> исходный номер неизвестной
+    std::vector<size_t> diagonal;    // Позиция диагонального элемента в каждой строке
+    std::vector<size_t> sourcePos;   // Позиция элемента J в структуре LU
+    mutable std::vector<double> work;
+
+    void Symbolic(CsrPattern const &pattern);
+};
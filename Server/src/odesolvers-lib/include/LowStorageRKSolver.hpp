@@ -0,0 +1,84 @@
+#pragma once
+#include "Solver.hpp"
+
+#include <string>
+
+// Явная схема Рунге-Кутты в 2N-форме Уильямсона:
+// dQ = A_i dQ + h f(t + c_i h, S), S = S + B_i dQ, i = 1..s, S в начале шага - y_n
+// Оценка погрешности: increment * dQ_{s-1} + h * sum_i e_i k_i. Веса e_i при стадиях 1..s-1
+// копятся в отдельном регистре; если отличен от нуля только e_s, регистр не нужен.
+struct LowStorageTableau
+{
+    std::string         name;
+    int                 order;          // Порядок решения
+    int                 errorOrder;     // Порядок оценки погрешности
+    std::vector<double> A;              // A_1 = 0
+    std::vector<double> B;
+    std::vector<double> c;
+    std::vector<double> e;              // Веса оценки погрешности по стадиям
+    double              increment = 0.0; // Вес dQ после предпоследней стадии в оценке
+};
+
+// Имена доступных схем: LSRK3 (Уильямсон 3(2), 3 стадии), LSRK4 (Карпентер-Кеннеди 4(3), 5 стадий)
+std::vector<std::string> LowStorageSchemes();
+
+LowStorageTableau LowStorageScheme(std::string const &name);
+
+// Экономный по памяти адаптивный явный метод для систем очень большой размерности.
+// Кроме решения y_n (нужного для повтора отклонённого шага) хранятся два регистра: состояние
+// стадии S, обновляемое на месте и становящееся y_{n+1}, и приращение dQ. Каждая стадия -
+// одно вычисление f и один проход по компонентам; на последней стадии в том же проходе
+// считается норма оценки погрешности с масштабами по y_n и y_{n+1}. У LSRK3 оценка строится
+// из dQ и последней стадии (2 регистра), у LSRK4 оценке 3-го порядка нужен третий регистр.
+// Значение f, возвращаемое правой частью, живёт только в пределах стадии.
+class LowStorageRKSolver : public Solver
+{
+public:
+    LowStorageRKSolver(
+        std::function<std::vector<double>(
+            double,
+            std::vector<double> const &)> func,
+        double                            initialStep,
+        LowStorageTableau                 tableau
+    ) : Solver(func, initialStep), tableau(std::move(tableau))
+    {
+        controller.SetLimits(SAFETY, FAC_MIN, FAC_MAX);
+    }
+
+    void Step(
+        double               t,
+        std::vector<double> &y,
+        double              &h,
+        double               tolerance) override;
+
+    void Solve(
+        double                     t0,
+        std::vector<double> const &y0,
+        double                     tEnd,
+        Storage                   &storage,
+        double                     tolerance) override;
+
+    // Число регистров размера состояния помимо решения
+    size_t Registers() const { return ErrorRegister() ? 3 : 2; }
+
+private:
+    static constexpr double SAFETY  = 0.9;
+    static constexpr double FAC_MIN = 0.2;
+    static constexpr double FAC_MAX = 10.0;
+
+    LowStorageTableau tableau;
+
+    std::vector<double> stage;     // S
+    std::vector<double> increment; // dQ
+    std::vector<double> error;     // Накопленная оценка погрешности (только при ErrorRegister)
+
+    bool ErrorRegister() const;
+
+    // Все стадии шага из y; stage - решение, возвращает норму оценки погрешности
+    // относительно допуска
+    double TryStep(
+        double                     t,
+        std::vector<double> const &y,
+        double                     h,
+        double                     tolerance);
+};
@@ -0,0 +1,68 @@
+#pragma once
+#include <cmath>
+#include <vector>
+
+// Встроенные модели, записанные один раз как шаблоны по скалярному типу T:
+// T = double - обычное вычисление правой части, T = Dual<N> - точные производные (Dual.hpp).
+// Модели второго порядка x'' = g(t, x, x') с состоянием y = (x, x') дополнительно задают
+// Acceleration (g по полному состоянию) и VelocityFree (g не зависит от x')
+
+struct VanDerPolModel
+{
+    double mu;
+    double p;
+
+    template <typename T>
+    std::vector<T> operator()(double t, std::vector<T> const &y) const
+    {
+        return { y[1], Acceleration(t, y)[0] };
+    }
+
+    template <typename T>
+    std::vector<T> Acceleration(double, std::vector<T> const &y) const
+    {
+        return { (mu * (1.0 - y[0] * y[0]) * y[1] - y[0]) / p };
+    }
+
+    bool VelocityFree() const { return mu == 0.0; }
+};
+
+struct ForcedOscillatorModel
+{
+    double omega;
+    double gamma;
+    double F;
+    double omegaDrive;
+
+    template <typename T>
+    std::vector<T> operator()(double t, std::vector<T> const &y) const
+    {
+        return { y[1], Acceleration(t, y)[0] };
+    }
+
+    template <typename T>
+    std::vector<T> Acceleration(double t, std::vector<T> const &y) const
+    {
+        return { -omega * omega * y[0] - gamma * y[1] + F * std::cos(omegaDrive * t) };
+    }
+
+    bool VelocityFree() const { return gamma == 0.0; }
+};
+
+struct RobertsonModel
+{
+    double k1;
+    double k2;
+    double k3;
+
+    template <typename T>
+    std::vector<T> operator()(double, std::vector<T> const &y) const
+    {
+        return
+        {
+            -k1 * y[0] + k2 * y[1] * y[2],
+            k1 * y[0] - k2 * y[1] * y[2] - k3 * y[1] * y[1],
+            k3 * y[1] * y[1]
+        };
+    }
+};
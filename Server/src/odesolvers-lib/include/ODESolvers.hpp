@@ -5,5 +5,22 @@
 #include "STEKSSolver.hpp"
 #include "DISPDSolver.hpp"
 #include "DISPFSolver.hpp"
+#include "RadauIIASolver.hpp"
+#include "BDFSolver.hpp"
+#include "IMEXSolver.hpp"
+#include "ETDRK4Solver.hpp"
+#include "ExpRosenbrockSolver.hpp"
+#include "RKCSolver.hpp"
+#include "EmbeddedRKSolver.hpp"
+#include "RKNSolver.hpp"
+#include "LowStorageRKSolver.hpp"
+#include "AdamsSolver.hpp"
 #include "DISPSSolver.hpp"
 #include "DISPSSolver_old.hpp"
+#include "DispsDesign.hpp"
+#include "AutoSolver.hpp"
+#include "StabilityRegion.hpp"
+#include "StepHintCache.hpp"
+#include "EventLocator.hpp"
+#include "SteadyStateDetector.hpp"
+#include "ErrorTolerances.hpp"
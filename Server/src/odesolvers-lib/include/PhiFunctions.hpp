@@ -0,0 +1,69 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// φ-функции экспоненциальных интеграторов: φ_0(z) = e^z, φ_{k+1}(z) = (φ_k(z) - 1/k!) / z.
+// Матрицы хранятся плотно, по строкам.
+
+// exp(A) матрицы n x n: аппроксимация Паде (6, 6) с масштабированием и возведением в квадрат
+std::vector<double> Expm(
+    std::vector<double> A,
+    size_t              n);
+
+// φ_0(A)..φ_p(A) одной экспонентой блочной матрицы порядка (p + 1) n:
+// [[A, I, 0], [0, 0, I], [0, 0, 0]] -> верхняя блочная строка [φ_0, φ_1, φ_2]
+std::vector<std::vector<double>> PhiMatrices(
+    std::vector<double> const &A,
+    size_t                     n,
+    size_t                     p);
+
+// Σ φ_k(h A) v_k, k = 0..v.size() - 1, без хранения A (нужно только умножение на вектор).
+// Экспонента расширенной матрицы [[h A, W], [0, J]] (Аль-Мохи, Хайэм) на подпространстве
+// Крылова размерности до MAX_KRYLOV, при недостаточной точности - подшагами по времени.
+// tolerance - допустимая погрешность относительно нормы результата.
+std::vector<double> PhiKrylov(
+    std::function<void(std::vector<double> const &, std::vector<double> &)> const &multiply,
+    double                                                                         h,
+    std::vector<std::vector<double>> const                                        &v,
+    double                                                                         tolerance);
+
+// Сдвиг рационального подпространства Крылова: solveShifted решает (I - PHI_SHIFT * h * A) x = b
+constexpr double PHI_SHIFT = 0.1;
+
+// То же по рациональному подпространству Крылова (сдвиг-обращение, ван ден Эсхоф и Хохбрук):
+// базис строится для (I - PHI_SHIFT * h * A)^{-1}, поэтому сходимость не зависит от жёсткости A
+// (для разностного лапласиана - от шага сетки). solveShifted решает систему, результат в b.
+std::vector<double> PhiKrylovShiftInvert(
+    std::function<void(std::vector<double> &)> const &solveShifted,
+    std::vector<std::vector<double>> const           &v,
+    double                                            tolerance);
+
+// Кэш φ_0..φ_3(h L) постоянного оператора L: общий для шагов и запросов,
+// ключ - значения L и шаг h.
+class PhiCache
+{
+public:
+    using Matrices = std::vector<std::vector<double>>;
+
+    static std::shared_ptr<Matrices const> Get(
+        std::vector<double> const &L,
+        size_t                     n,
+        double                     h);
+
+private:
+    struct CacheEntry
+    {
+        std::vector<double>             op;
+        double                          h;
+        std::shared_ptr<Matrices const> phi;
+    };
+
+    static constexpr size_t MAX_CACHE_SIZE = 64;
+
+    static std::mutex                             cacheMutex;
+    static std::unordered_map<size_t, CacheEntry> cache;
+};
@@ -0,0 +1,93 @@
+#pragma once
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <stdexcept>
+
+// C-интерфейс плагина модели:
+//   extern "C" void ode_rhs(double t, const double *y, double *dydt, size_t n, const double *p);
+// Необязательные символы:
+//   extern "C" void ode_jacobian(double t, const double *y, double *J, size_t n, const double *p);
+//       J - матрица Якоби n x n, по строкам
+//   extern "C" size_t ode_sparsity(size_t n, size_t *rowPtr, size_t *colIndex);
+//       структура матрицы Якоби в CSR; возвращает число ненулевых элементов,
+//       при colIndex == nullptr только сообщает его
+//   extern "C" void ode_rhs_implicit(double t, const double *y, double *dydt, size_t n, const double *p);
+//       жёсткая часть ode_rhs для метода IMEX (остальное интегрируется явно)
+//   extern "C" void ode_preconditioner(double t, const double *y, double gamma, double *v, size_t n, const double *p);
+//       приближённое решение (I - gamma * J) x = v на месте (для BDF в режиме Krylov)
+//   extern "C" const char *ode_parameters; // Имена параметров через запятую: "k1,k2,k3"
+//   extern "C" const char *ode_name;       // Имя задачи для готовых .so (иначе - имя файла)
+using PluginRhs      = void (*)(double, double const *, double *, size_t, double const *);
+using PluginJacobian = void (*)(double, double const *, double *, size_t, double const *);
+using PluginSparsity = size_t (*)(size_t, size_t *, size_t *);
+using PluginPreconditioner = void (*)(double, double const *, double, double *, size_t, double const *);
+
+struct ModelPlugin
+{
+    std::string              name;
+    std::string              path;
+    std::shared_ptr<void>    handle; // dlclose при освобождении последней ссылки
+    PluginRhs                rhs      = nullptr;
+    PluginRhs                rhsImplicit = nullptr;
+    PluginJacobian           jacobian = nullptr;
+    PluginSparsity           sparsity = nullptr;
+    PluginPreconditioner     preconditioner = nullptr;
+    std::vector<std::string> parameterNames;
+};
+
+class PluginManager
+{
+public:
+    static PluginManager& Instance();
+
+    // Каталог готовых плагинов и кэша откомпилированных исходников
+    void SetDirectory(std::string const &directory);
+    std::string const& Directory() const { return directory; }
+
+    // Компиляция исходников по запросу (POST /plugins) исполняет присланный код в процессе
+    // сервера, поэтому выключена по умолчанию; включается переменной окружения
+    // ODE_PLUGIN_COMPILE=1 или SetCompilationEnabled
+    bool CompilationEnabled() const { return compilationEnabled; }
+    void SetCompilationEnabled(bool enabled) { compilationEnabled = enabled; }
+
+    // Загрузка всех *.so из каталога плагинов и откомпилированных ранее плагинов
+    // по индексу кэша (при старте сервера)
+    size_t LoadDirectory();
+
+    // Загрузка готового плагина; пустое имя - берётся из ode_name или имени файла
+    std::shared_ptr<ModelPlugin const> Load(
+        std::string const &path,
+        std::string        name = "");
+
+    // Компиляция исходника системным компилятором (-O3 -march=native) и регистрация.
+    // Результат кэшируется на диске по хэшу исходника, повторная компиляция не выполняется;
+    // имя плагина и хэш записываются в индекс кэша. Без CompilationEnabled - исключение.
+    std::shared_ptr<ModelPlugin const> Compile(
+        std::string const &name,
+        std::string const &source);
+
+    std::shared_ptr<ModelPlugin const> Find(std::string const &name) const;
+    std::vector<std::string> Names() const;
+
+private:
+    PluginManager();
+
+    static constexpr char const *INDEX_FILE = "index"; // Строки "имя хэш" в каталоге кэша
+
+    std::string directory;
+    bool        compilationEnabled = false;
+
+    mutable std::mutex                                                   mutex;
+    std::mutex                                                           compileMutex;
+    std::unordered_map<std::string, std::shared_ptr<ModelPlugin const>>  plugins;
+
+    static uint64_t Hash(std::string const &text);
+
+    // Индекс кэша: имя плагина -> хэш откомпилированной библиотеки
+    std::unordered_map<std::string, std::string> ReadIndex() const;
+
+    void WriteIndex(std::unordered_map<std::string, std::string> const &index) const;
+};
@@ -9,7 +9,10 @@ public:
             double,
             std::vector<double> const &)> func,
         double                            initialStep)
-        : Solver(func, initialStep) {}
+        : Solver(func, initialStep)
+    {
+        controller.SetLimits(SAFETY, MIN_SCALE, MAX_SCALE);
+    }
 
     void Step(
         double               t,
@@ -39,10 +42,16 @@ private:
     const double MIN_SCALE = 0.2;
     const double MAX_SCALE = 5.0;
 
-    double computeError(
+    // Условие точности (4.7): нужны только k1, k2
+    double computePrecisionError(
         std::vector<double> const &k1,
         std::vector<double> const &k2,
-        const std::vector<double> &k3,
-        double                     h,
+        std::vector<double> const &y,
         double                     tolerance);
+
+    // Условие устойчивости (4.14)
+    double computeStabilityError(
+        std::vector<double> const &k1,
+        std::vector<double> const &k2,
+        const std::vector<double> &k3);
 };
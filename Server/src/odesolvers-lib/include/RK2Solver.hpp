@@ -32,4 +32,6 @@ private:
     const double SAFETY_FACTOR = 0.9;
     const double MAX_FACTOR    = 5.0;
     const double MIN_FACTOR    = 0.2;
+
+    double acceptedStep = 0.0; // Длина принятого шага: Step возвращает в h следующий шаг
 };
@@ -0,0 +1,79 @@
+#pragma once
+#include "Solver.hpp"
+
+// Стабилизированный явный метод Рунге-Кутты-Чебышёва RKC второго порядка
+// (Зоммейер, Шампайн, Вервер). Число стадий s выбирается на каждом шаге по оценке
+// спектрального радиуса rho матрицы Якоби: интервал устойчивости растёт как 0.653*s^2,
+// поэтому s ~ sqrt(h*rho). Стадии строятся трёхчленной рекуррентностью полиномов
+// Чебышёва: память - постоянное число векторов при любом s, линейной алгебры нет.
+// Рассчитан на умеренно жёсткие системы с собственными числами вблизи отрицательной
+// вещественной оси (диффузия); rho оценивается нелинейным степенным методом по
+// вычислениям f, поэтому матрица Якоби не нужна.
+class RKCSolver : public Solver
+{
+public:
+    RKCSolver(
+        std::function<std::vector<double>(
+            double,
+            std::vector<double> const &)> func,
+        double                            initialStep
+    ) : Solver(func, initialStep)
+    {
+        controller.SetLimits(SAFETY, FAC_MIN, FAC_MAX);
+    }
+
+    void Step(
+        double               t,
+        std::vector<double> &y,
+        double              &h,
+        double               tolerance) override;
+
+    void Solve(
+        double                     t0,
+        std::vector<double> const &y0,
+        double                     tEnd,
+        Storage                   &storage,
+        double                     tolerance) override;
+
+private:
+    static constexpr double DAMPING      = 2.0 / 13.0; // Демпфирование: w0 = 1 + DAMPING / s^2
+    static constexpr double STAGE_FACTOR = 1.54;       // s = 1 + sqrt(1 + 1.54*h*rho), 1.54 ~ 1/0.653
+    static constexpr int    MIN_STAGES   = 2;
+    static constexpr int    MAX_STAGES   = 1000;
+    static constexpr int    RHO_INTERVAL = 25;         // Переоценка rho через 25 принятых шагов
+    static constexpr int    MAX_POWER    = 50;         // Итераций степенного метода
+    static constexpr double RHO_SAFETY   = 1.2;
+    static constexpr double SAFETY       = 0.8;
+    static constexpr double FAC_MIN      = 0.1;
+    static constexpr double FAC_MAX      = 10.0;
+
+    size_t n = 0;
+    double rho = 0.0;
+    int    rhoAge = RHO_INTERVAL;
+
+    std::vector<double> scale;
+    std::vector<double> eigenvector; // Приближение доминирующего собственного вектора (тёплый старт)
+
+    // Рабочие векторы стадий: Y_{j-2}, Y_{j-1}, Y_j и F_{j-1}
+    std::vector<double> yPrev2, yPrev1, yStage, fStage;
+
+    double Norm(std::vector<double> const &v) const;
+
+    // Спектральный радиус матрицы Якоби в точке (t, y) степенным методом, fy = f(t, y)
+    double SpectralRadius(
+        double                     t,
+        std::vector<double> const &y,
+        std::vector<double> const &fy);
+
+    // Шаг из s стадий: yNew - решение, fNew = f(t + h, yNew); возвращает норму оценки
+    // погрешности относительно допуска
+    double TryStep(
+        double                     t,
+        std::vector<double> const &y,
+        std::vector<double> const &fy,
+        double                     h,
+        int                        s,
+        std::vector<double>       &yNew,
+        std::vector<double>       &fNew,
+        double                     tolerance);
+};
@@ -0,0 +1,100 @@
+#pragma once
+#include "Solver.hpp"
+
+#include <string>
+
+// Форма второго порядка q'' = g(t, q, q') системы с состоянием y = (q, q') размерности n = 2m:
+// сначала m координат, затем m скоростей
+struct SecondOrderSystem
+{
+    // Ускорения g(t, y) по полному состоянию y, m компонент
+    std::function<std::vector<double>(
+        double,
+        std::vector<double> const &)> acceleration;
+    bool velocityFree = false; // g не зависит от q' (частный случай q'' = g(t, q))
+};
+
+// Вложенная пара методов Рунге-Кутты-Нюстрёма. Стадия i:
+// Q_i = q + c_i h q' + h^2 sum_j Abar[i][j] g_j, V_i = q' + h sum_j A[i][j] g_j, g_i = g(t + c_i h, Q_i, V_i)
+// q_{n+1} = q + h q' + h^2 sum bbar_i g_i, q'_{n+1} = q' + h sum b_i g_i
+struct NystromTableau
+{
+    std::string                      name;
+    int                              order;        // Порядок решения
+    int                              errorOrder;   // Порядок оценки погрешности
+    bool                             velocityFree; // Только для q'' = g(t, q): скорости стадий не вычисляются
+    std::vector<double>              c;
+    std::vector<std::vector<double>> Abar;         // Коэффициенты координат стадий
+    std::vector<std::vector<double>> A;            // Коэффициенты скоростей стадий (пусто при velocityFree)
+    std::vector<double>              bbar;
+    std::vector<double>              b;
+    std::vector<double>              ebar;         // Оценка погрешности координат bbar - bbar^
+    std::vector<double>              e;            // Оценка погрешности скоростей b - b^
+};
+
+// Имена доступных пар: RKN4 (Нюстрём 4(3) для q'' = g(t, q), 3 вычисления g на шаг с FSAL),
+// RKN5 (пара Нюстрёма, индуцированная DP5(4): Abar = A^2, bbar = bA, для общего q'' = g(t, q, q'))
+std::vector<std::string> NystromPairs();
+
+NystromTableau NystromPair(std::string const &name);
+
+// Адаптивный метод Рунге-Кутты-Нюстрёма: интегрирует форму второго порядка напрямую, g вычисляется
+// только для m ускорений, а в частном случае q'' = g(t, q) скорости стадий не строятся.
+// Последняя стадия - g в новой точке (FSAL). Погрешность - по всему состоянию (q, q') в норме
+// допусков, как у EmbeddedRKSolver. f - правая часть первого порядка (q', g), нужна лишь для
+// оценки начального шага.
+class RKNSolver : public Solver
+{
+public:
+    RKNSolver(
+        std::function<std::vector<double>(
+            double,
+            std::vector<double> const &)> func,
+        SecondOrderSystem                 system,
+        double                            initialStep,
+        NystromTableau                    tableau);
+
+    void Step(
+        double               t,
+        std::vector<double> &y,
+        double              &h,
+        double               tolerance) override;
+
+    void Solve(
+        double                     t0,
+        std::vector<double> const &y0,
+        double                     tEnd,
+        Storage                   &storage,
+        double                     tolerance) override;
+
+    // Вычисления g за последний Solve
+    size_t Evaluations() const { return evaluations; }
+
+private:
+    static constexpr double SAFETY  = 0.9;
+    static constexpr double FAC_MIN = 0.2;
+    static constexpr double FAC_MAX = 10.0;
+
+    SecondOrderSystem system;
+    NystromTableau    tableau;
+
+    size_t m = 0;
+    size_t evaluations = 0;
+    std::vector<double>              scale;
+    std::vector<double>              estimate;
+    std::vector<std::vector<double>> g;     // Ускорения стадий
+    std::vector<double>              stage; // Состояние стадии (Q_i, V_i)
+
+    std::vector<double> Acceleration(
+        double                     t,
+        std::vector<double> const &y);
+
+    // Стадии со второй (g_1 уже вычислена), yNew - решение;
+    // возвращает норму оценки погрешности относительно допуска
+    double TryStep(
+        double                     t,
+        std::vector<double> const &y,
+        double                     h,
+        std::vector<double>       &yNew,
+        double                     tolerance);
+};
@@ -0,0 +1,105 @@
+#pragma once
+#include "Solver.hpp"
+#include "LinearAlgebra.hpp"
+
+#include <complex>
+
+// Неявный метод Radau IIA (3 стадии, порядок 5) по схеме RADAU5 Хайрера-Ваннера:
+// упрощённые итерации Ньютона в базисе собственных векторов матрицы A^{-1}
+// (одна вещественная и одна комплексная система размерности n), LU-разложения
+// повторно используются между шагами, матрица Якоби обновляется только при
+// медленной сходимости или отказе итераций Ньютона.
+class RadauIIASolver : public Solver
+{
+public:
+    RadauIIASolver(
+        std::function<std::vector<double>(
+            double,
+            std::vector<double> const &)> func,
+        double                            initialStep
+    ) : Solver(func, initialStep) {}
+
+    void Step(
+        double               t,
+        std::vector<double> &y,
+        double              &h,
+        double               tolerance) override;
+
+    void Solve(
+        double                     t0,
+        std::vector<double> const &y0,
+        double                     tEnd,
+        Storage                   &storage,
+        double                     tolerance) override;
+
+    // Пошаговое использование (например, из DISPFSolver): Reset задаёт начальную точку,
+    // Advance выполняет один принятый шаг, не выходя за tEnd.
+    void Reset(
+        double                     t,
+        std::vector<double> const &y,
+        double                     h);
+
+    void Advance(
+        double              &t,
+        std::vector<double> &y,
+        double               tEnd,
+        double               tolerance);
+
+    double CurrentStep() const { return h; }
+
+    // Передача производных модели от другого решателя
+    void ShareDerivatives(
+        JacobianFunction            jac,
+        std::shared_ptr<CsrPattern> pattern)
+    {
+        jacobian = std::move(jac);
+        sparsity = std::move(pattern);
+    }
+
+private:
+    static constexpr int    MAX_NEWTON = 7;
+    static constexpr double SAFETY     = 0.9;
+    static constexpr double FAC_MIN    = 0.2;  // Не более чем в 5 раз уменьшение шага
+    static constexpr double FAC_MAX    = 8.0;  // Не более чем в 8 раз увеличение шага
+    static constexpr double THETA_JAC  = 0.1;  // Порог скорости сходимости для новой матрицы Якоби
+    static constexpr double KEEP_MIN   = 1.0;  // Шаг не меняется, если hNew/h в [1.0, 1.2]:
+    static constexpr double KEEP_MAX   = 1.2;  // тогда повторно используются LU-разложения
+
+    size_t n = 0;
+    double h = 0.0;
+    bool   first = true;
+    bool   rejected = false;
+    bool   jacobianCurrent = false; // Матрица Якоби вычислена в текущей точке
+    bool   needJacobian = true;
+    bool   needFactor = true;
+    double faccon = 1.0;
+    double theta = 0.0;
+    double hAccepted = 0.0;   // Шаг и ошибка предыдущего принятого шага (регулятор Густафссона)
+    double errAccepted = 1e-2;
+
+    std::vector<double> J;            // Плотная матрица Якоби n x n
+    std::vector<double> f0;           // f(t, y) в начале шага
+    std::vector<double> z1, z2, z3;   // Приращения стадий Y_i - y
+    std::vector<double> w1, w2, w3;   // Они же в преобразованном базисе
+    std::vector<double> z1Prev, z2Prev, z3Prev; // Стадии принятого шага для экстраполяции
+    bool haveExtrapolation = false;
+
+    DenseLU<double>               realLU;
+    DenseLU<std::complex<double>> complexLU;
+
+    void ComputeJacobian(
+        double                     t,
+        std::vector<double> const &y,
+        double                     tolerance);
+
+    bool Factorize();
+
+    // Начальное приближение стадий по коллокационному многочлену прошлого шага
+    void Extrapolate();
+
+    // Попытка шага; true - шаг принят, h - следующий шаг
+    bool TryStep(
+        double              &t,
+        std::vector<double> &y,
+        double               tolerance);
+};
@@ -9,7 +9,10 @@ public:
             double,
             std::vector<double> const &)> func,
         double                            initialStep
-    ) : Solver(func, initialStep) {}
+    ) : Solver(func, initialStep)
+    {
+        controller.SetLimits(SAFETY, MIN_SCALE, MAX_SCALE);
+    }
 
     void Step(
         double               t,
@@ -29,13 +32,20 @@ private:
     const double MIN_SCALE = 0.2;
     const double MAX_SCALE = 5.0;
 
-    double computeError(
+    // Условие устойчивости: нужны только k1, k2, k3
+    double computeStabilityError(
         std::vector<double> const &k1,
         std::vector<double> const &k2,
+        std::vector<double> const &k3
+    );
+
+    // Условие точности
+    double computePrecisionError(
+        std::vector<double> const &k1,
         std::vector<double> const &k3,
         std::vector<double> const &k4,
         std::vector<double> const &k5,
-        double                     h,
+        std::vector<double> const &y,
         double                     tolerance
     );
 };
@@ -1,6 +1,9 @@
 #pragma once
 #include "Storage.hpp"
 #include "CommonFunctions.hpp"
+#include "SparseJacobian.hpp"
+#include "StepSizeController.hpp"
+#include "ErrorTolerances.hpp"
 
 #include <functional>
 #include <array>
@@ -11,10 +14,30 @@
 #include <stdexcept>
 #include <limits>
 #include <map>
+#include <memory>
+
+// Матрица Якоби df/dy (n x n, по строкам)
+using JacobianFunction = std::function<std::vector<std::vector<double>>(
+    double,
+    std::vector<double> const &)>;
+
+// Произведение матрицы Якоби на вектор J(t, y) * v без построения матрицы
+using JacobianVectorFunction = std::function<std::vector<double>(
+    double,
+    std::vector<double> const &,
+    std::vector<double> const &)>;
+
+// Предобусловливатель неявных методов: приближённое решение (I - gamma * J) x = v, результат в v
+using PreconditionerFunction = std::function<void(
+    double,
+    std::vector<double> const &,
+    double,
+    std::vector<double> &)>;
 
 class Solver
 {
 public:
+    // initialStep <= 0 - начальный шаг выбирается автоматически (StartingStep)
     Solver(
         std::function<std::vector<double>(
             double,
@@ -24,6 +47,23 @@ public:
     
     virtual ~Solver() = default;
 
+    // Точная матрица Якоби модели (например, из автоматического дифференцирования);
+    // без неё решатели используют конечные разности
+    void SetJacobian(JacobianFunction jac) { jacobian = std::move(jac); }
+
+    // Точное произведение J * v (автоматическое дифференцирование) для безматричных методов;
+    // без него J * v - разностное отношение правой части
+    void SetJacobianVector(JacobianVectorFunction jvp) { jacobianVector = std::move(jvp); }
+
+    // Объявленная структура матрицы Якоби; без неё структура определяется пробными вычислениями
+    void SetSparsity(CsrPattern pattern) { sparsity = std::make_shared<CsrPattern>(std::move(pattern)); }
+
+    // Закон выбора шага (Elementary, PI, PID); ограничения множителя шага задаёт решатель
+    void SetStepControl(StepControlKind kind) { controller.SetKind(kind); }
+
+    // Допуски по компонентам (atol, rtol) и норма погрешности; без них - скалярный допуск Solve
+    void SetTolerances(ErrorTolerances value) { tolerances = std::move(value); }
+
     virtual void Step(
         double               t,
         std::vector<double> &y,
@@ -40,5 +80,84 @@ public:
 
 protected:
     std::function<std::vector<double>(double, const std::vector<double>&)> f;
+    JacobianFunction jacobian;
+    JacobianVectorFunction jacobianVector;
     double stepSize;
+    StepSizeController controller;
+    ErrorTolerances    tolerances;
+
+    std::shared_ptr<CsrPattern>     sparsity;
+    std::unique_ptr<SparseJacobian> sparseJacobian;
+    CsrMatrix                       exactJacobian;
+    std::vector<double>             differenceScale;
+
+    // Матрица Якоби в CSR: точная, если задана, иначе сжатые конечные разности
+    // по раскраске столбцов (число вычислений f равно числу цветов). tolerance > 0 -
+    // приращения разностей по масштабам погрешности sc_j при этом допуске
+    CsrMatrix const& JacobianCsr(
+        double                     t,
+        std::vector<double> const &y,
+        std::vector<double> const *f0 = nullptr,
+        double                     tolerance = 0.0);
+
+    // f в принятой точке (first same as last): шаг, вычисливший f(t_{n+1}, y_{n+1}) для оценки
+    // погрешности, сохраняет её, и первая стадия следующего шага берёт значение отсюда.
+    // Значение привязано к точке (t, y): после отказа шага, интерполяции или иного изменения
+    // состояния запрошенная точка не совпадёт с сохранённой, и f будет вычислена заново.
+    void StoreDerivative(
+        double                     t,
+        std::vector<double> const &y,
+        std::vector<double> const &fy);
+
+    // f(t, y), из сохранённого значения при совпадении точки
+    std::vector<double> Derivative(
+        double                     t,
+        std::vector<double> const &y);
+
+    void ResetDerivative() { derivativeValid = false; }
+
+    // Точка решения в storage; сохранённая в ней f (StoreDerivative) передаётся поиску событий
+    void AddPoint(
+        Storage                   &storage,
+        double                     t,
+        std::vector<double> const &y);
+
+    // Норма вектора погрешности e шага y -> yNew в единицах скалярного допуска: при заданных
+    // допусках по компонентам tolerance * ||e_i / sc_i|| (RMS или max), иначе собственная норма
+    // метода - евклидова (ErrorNorm) или максимум модулей (ErrorMaxNorm). Сравнения
+    // с tolerance и константы условий точности методов при этом не меняются.
+    double ErrorNorm(
+        std::vector<double> const &e,
+        std::vector<double> const &y,
+        std::vector<double> const &yNew,
+        double                     tolerance) const;
+
+    double ErrorMaxNorm(
+        std::vector<double> const &e,
+        std::vector<double> const &y,
+        std::vector<double> const &yNew,
+        double                     tolerance) const;
+
+    // Множители компонент для норм, накапливаемых прямо в циклах стадий: tolerance / sc_i
+    // (sc_i по y в начале шага) при заданных допусках по компонентам, иначе 1
+    void ErrorWeights(
+        std::vector<double> const &y,
+        double                     tolerance,
+        std::vector<double>       &weight) const;
+
+    // Шаг первого шага: заданный в конструкторе или, если он не положителен, оценка
+    // EstimateInitialStep для метода порядка order (одно дополнительное вычисление f);
+    // f(t0, y0) сохраняется и берётся первой стадией
+    double StartingStep(
+        double                     t0,
+        std::vector<double> const &y0,
+        double                     tEnd,
+        double                     tolerance,
+        int                        order);
+
+private:
+    bool                derivativeValid = false;
+    double              derivativeT = 0.0;
+    std::vector<double> derivativeY;
+    std::vector<double> derivativeF;
 };
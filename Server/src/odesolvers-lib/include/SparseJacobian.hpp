@@ -0,0 +1,75 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <vector>
+#include <stdexcept>
+
+// Структура разреженной матрицы n x n в формате CSR (номера столбцов в строке упорядочены)
+struct CsrPattern
+{
+    size_t              n = 0;
+    std::vector<size_t> rowPtr;   // n + 1 элементов
+    std::vector<size_t> colIndex; // nnz элементов
+
+    size_t NonZeros() const { return colIndex.size(); }
+
+    static CsrPattern Dense(size_t n);
+};
+
+// Разреженная матрица в формате CSR
+struct CsrMatrix
+{
+    CsrPattern          pattern;
+    std::vector<double> values;
+
+    std::vector<double> Multiply(std::vector<double> const &x) const;
+
+    static CsrMatrix FromDense(std::vector<std::vector<double>> const &dense);
+};
+
+// Матрица Якоби сжатыми конечными разностями:
+// столбцы раскрашиваются по Кертису-Пауэллу-Риду (столбцы одного цвета не имеют
+// общих строк), каждая группа цветов стоит одного вычисления правой части,
+// группы вычисляются параллельно на ComputePool.
+class SparseJacobian
+{
+public:
+    using Function = std::function<std::vector<double>(double, std::vector<double> const &)>;
+
+    SparseJacobian(
+        Function   func,
+        CsrPattern pattern);
+
+    // Автоматическое определение структуры: возмущение каждой компоненты
+    // в случайной точке около y (n + 1 вычислений, параллельно)
+    static CsrPattern DetectPattern(
+        Function const            &func,
+        double                     t,
+        std::vector<double> const &y);
+
+    // Вычисление матрицы Якоби в точке (t, y); f0 = f(t, y), если уже известно.
+    // Приращение компоненты j: sqrt(eps) * max(|y_j|, scale_j), как в LSODE, где scale_j -
+    // масштаб погрешности решателя atol_j + rtol_j |y_j|; без scale - MIN_SCALE
+    CsrMatrix const& Evaluate(
+        double                     t,
+        std::vector<double> const &y,
+        std::vector<double> const *f0 = nullptr,
+        std::vector<double> const *scale = nullptr);
+
+    size_t ColorCount() const { return groups.size(); }
+    CsrPattern const& Pattern() const { return jac.pattern; }
+
+private:
+    // Нижняя граница приращения без масштабов решателя: компоненты порядка 1e-11
+    // (например, y2 задачи Робертсона) при границе 1 получали бы неверный столбец
+    static constexpr double MIN_SCALE = 1e-6;
+
+    Function  f;
+    CsrMatrix jac;
+
+    // Для каждого цвета - столбцы группы; для каждого столбца - пары (строка, позиция в CSR)
+    std::vector<std::vector<size_t>>                      groups;
+    std::vector<std::vector<std::pair<size_t, size_t>>>   columnEntries;
+
+    void Colorize();
+};
@@ -0,0 +1,51 @@
+#pragma once
+#include <string>
+#include <utility>
+#include <vector>
+
+// Анализ областей устойчивости явных схем: R(z) = 1 + sum_k b^T A^{k-1} 1 z^k - полином
+// устойчивости (y' = lambda y, z = h lambda), область - множество |R(z)| <= 1.
+
+// Явная схема Рунге-Кутты: строка i матрицы A - коэффициенты при k_1..k_i в аргументе
+// стадии k_{i+1} (первая стадия - y), b - веса по всем стадиям
+struct ExplicitTableau
+{
+    std::string                      name;
+    std::vector<std::vector<double>> A;
+    std::vector<double>              b;
+};
+
+// Имена схем библиотеки, доступных для анализа
+std::vector<std::string> StabilitySchemes();
+
+// Таблица схемы по имени (Euler, RK2, RK23S, STEKS, Disps13..Disps36, DISPF_P36/P4/P72/P28)
+ExplicitTableau SchemeTableau(std::string const &name);
+
+// Коэффициенты r_0..r_s полинома устойчивости по возрастанию степени
+std::vector<double> StabilityPolynomial(ExplicitTableau const &tableau);
+
+// Прямоугольник комплексной плоскости и число узлов сетки по осям
+struct StabilityGrid
+{
+    double reMin  = -4.0;
+    double reMax  = 1.0;
+    double imMin  = -2.5;
+    double imMax  = 2.5;
+    size_t width  = 1024;
+    size_t height = 1024;
+};
+
+struct StabilityRegion
+{
+    double realInterval = 0.0; // Длина интервала устойчивости [-realInterval, 0]
+    double area         = 0.0; // Площадь области |R| <= 1 внутри прямоугольника
+    // Граница |R(z)| = 1: ломаные из точек (Re z, Im z); замкнутая ломаная повторяет первую точку
+    std::vector<std::vector<std::pair<double, double>>> contours;
+};
+
+// |R(z)| на сетке считается схемой Горнера по строкам (циклы по точкам строки векторизуются),
+// полосы строк обрабатываются параллельно на общем пуле потоков. Граница строится
+// методом marching squares по соседним строкам, поэтому память не зависит от высоты сетки.
+StabilityRegion ComputeStabilityRegion(
+    std::vector<double> const &poly,
+    StabilityGrid const       &grid);
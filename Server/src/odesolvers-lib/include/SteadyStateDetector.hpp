@@ -0,0 +1,60 @@
+#pragma once
+#include "ErrorTolerances.hpp"
+
+#include <functional>
+#include <vector>
+
+// Обнаружение установившегося режима на принятых шагах. Все величины измеряются в норме допусков
+// решателя (ErrorTolerances: масштабы sc_i = atol_i + rtol_i |y_i|, без допусков по компонентам -
+// tolerance * (1 + |y_i|)). Шаг считается «спокойным», если норма изменения состояния за шаг не больше 1.
+// После window спокойных шагов подряд проверяется производная: ||f(t, y)|| <= 1
+// (одно вычисление f на window шагов) и оценивается уход решения до конца интервала tEnd. Он мал, если
+// мал уход при текущей производной, ||f|| * (tEnd - t), или изменение за окно убывает от окна к окну
+// геометрически со знаменателем rho <= DECAY и остаток ряда ||dy|| * rho / (1 - rho) в пределах
+// допуска. Малая, но не затухающая производная на длинном интервале установившимся режимом не считается.
+class SteadyStateDetector
+{
+public:
+    SteadyStateDetector(
+        std::function<std::vector<double>(
+            double,
+            std::vector<double> const &)> func,
+        ErrorTolerances                   tolerances,
+        double                            tolerance,
+        double                            tEnd,
+        size_t                            window = 5);
+
+    // Начальная точка интегрирования
+    void Start(
+        double                     t,
+        std::vector<double> const &y);
+
+    // Проверка принятого шага в (t, y); true - режим установился
+    bool Check(
+        double                     t,
+        std::vector<double> const &y);
+
+    bool Detected() const { return detected; }
+    double DetectedTime() const { return detectedTime; }
+
+private:
+    std::function<std::vector<double>(double, std::vector<double> const &)> f;
+    ErrorTolerances tolerances;
+    double tolerance;
+    double tEnd;
+    size_t window;
+
+    static constexpr double DECAY = 0.5; // Наибольшее отношение изменений за соседние окна
+
+    std::vector<double> yPrev;
+    std::vector<double> windowStart;       // Состояние в начале текущего окна
+    double previousChange = -1.0;          // Норма изменения за предыдущее окно (< 0 - нет окна)
+    size_t quietSteps   = 0;
+    bool   detected     = false;
+    double detectedTime = 0.0;
+
+    // Норма v в масштабах допусков решателя в точке y
+    double Norm(
+        std::vector<double> const &v,
+        std::vector<double> const &y) const;
+};
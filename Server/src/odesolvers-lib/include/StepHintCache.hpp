@@ -0,0 +1,31 @@
+#pragma once
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Кэш начальных шагов сервера: первый принятый шаг решённой задачи запоминается и служит
+// начальным шагом похожих запросов - той же задачи (имя и выражения правых частей), того же
+// метода и допуска того же десятичного порядка. Без подсказки шаг выбирается автоматически.
+class StepHintCache
+{
+public:
+    static std::string Key(
+        std::string const              &equation,
+        std::vector<std::string> const &equations,
+        std::string const              &method,
+        double                          tolerance);
+
+    // Подсказка для ключа; 0 - нет (автоматический выбор шага)
+    static double Find(std::string const &key);
+
+    static void Store(
+        std::string const &key,
+        double             step);
+
+private:
+    static constexpr size_t MAX_CACHE_SIZE = 1024;
+
+    static std::mutex                              cacheMutex;
+    static std::unordered_map<std::string, double> cache;
+};
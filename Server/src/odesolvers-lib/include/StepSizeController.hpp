@@ -0,0 +1,91 @@
+#pragma once
+#include "ErrorTolerances.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// Закон выбора следующего шага по нормам погрешности err_n, err_{n-1}, err_{n-2}
+// (err - оценка погрешности относительно допуска, шаг принимается при err <= 1):
+// h_{n+1} = h_n * safety * err_n^(-b1/k) * err_{n-1}^(-b2/k) * err_{n-2}^(-b3/k), err ~ h^k
+enum class StepControlKind
+{
+    Elementary, // b = (1, 0, 0): множитель только по последней оценке
+    PI,         // b = (0.7, -0.4, 0): ПИ-регулятор Густафссона, гасит колебания шага
+    PID         // b = (0.58, -0.21, 0.1): цифровой ПИД-фильтр, дифференциальная часть реагирует на тренд погрешности
+};
+
+// Имя из запроса: Elementary (по умолчанию, пустая строка), PI, PID
+StepControlKind ParseStepControlKind(std::string const &name);
+
+// Регулятор длины шага одношаговых методов. Хранит нормы погрешности последних принятых
+// шагов; после отказа следующий принятый шаг не увеличивается. Ограничения множителя
+// (safety, facMin, facMax) задаёт решатель, закон - запрос.
+class StepSizeController
+{
+public:
+    StepSizeController(
+        double safety = 0.9,
+        double facMin = 0.2,
+        double facMax = 5.0
+    ) : safety(safety), facMin(facMin), facMax(facMax) {}
+
+    void SetKind(StepControlKind value) { kind = value; }
+    StepControlKind Kind() const { return kind; }
+
+    void SetLimits(
+        double safetyFactor,
+        double minFactor,
+        double maxFactor);
+
+    // Начало интегрирования: история погрешностей сбрасывается
+    void Reset();
+
+    // Множитель следующего шага после принятого шага (err <= 1)
+    double Accept(
+        double err,
+        double k);
+
+    // Множитель повторной попытки после отказа (err > 1): по последней оценке, не больше REJECT_MAX
+    double Reject(
+        double err,
+        double k);
+
+    // Шаг h, ограниченный наибольшим устойчивым шагом hStab (оценка h * граница / V_n);
+    // hStab <= 0 - ограничения нет
+    static double Limit(
+        double h,
+        double hStab);
+
+private:
+    static constexpr double ERR_MIN     = 1e-10; // Нижняя граница нормы: err = 0 не даёт бесконечного множителя
+    static constexpr double REJECT_MAX  = 0.9;
+    // Нижняя граница хранимых норм: очень точный шаг не должен уменьшать следующие (как в DOPRI5)
+    static constexpr double HISTORY_MIN = 1e-4;
+
+    StepControlKind kind = StepControlKind::Elementary;
+    double safety;
+    double facMin;
+    double facMax;
+
+    double errPrev  = 1.0; // err_{n-1}, err_{n-2}: 1 - нейтральное значение в начале
+    double errPrev2 = 1.0;
+    bool   rejected = false;
+};
+
+// Оценка начального шага (Хайрер, Нёрсетт, Ваннер, т. 1, II.4) для метода порядка order:
+// по f0 = f(t0, y0) и одному дополнительному вычислению f в точке y0 + h0 f0 оцениваются
+// масштаб решения и вторая производная, шаг выбирается так, чтобы h^(order+1) max(|f|, |f'|)
+// был порядка 0.01 в норме допусков решателя (масштабы sc_i по y0, см. ErrorTolerances; без
+// допусков по компонентам - tolerance * (1 + |y0|)). Шаг не больше |tEnd - t0|.
+double EstimateInitialStep(
+    std::function<std::vector<double>(
+        double,
+        std::vector<double> const &)> const &f,
+    double                                   t0,
+    std::vector<double> const               &y0,
+    std::vector<double> const               &f0,
+    double                                   tEnd,
+    double                                   tolerance,
+    int                                      order,
+    ErrorTolerances const                   &tolerances = ErrorTolerances());
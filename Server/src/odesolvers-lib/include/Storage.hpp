@@ -1,13 +1,33 @@
 #pragma once
+#include "EventLocator.hpp"
+#include "SteadyStateDetector.hpp"
+
+#include <memory>
 #include <vector>
 #include <stdexcept>
 
 class Storage
 {
 public:
+    // Точки добавляются после каждого принятого шага. С поиском событий точки проверяются
+    // EventLocator; после терминального события последней точкой становится точка события,
+    // последующие точки не добавляются, а решатели прекращают интегрирование (Stopped).
+    // Так же решение останавливается при обнаружении установившегося режима.
+    // step - плотная выдача и f в точке, если они есть у решателя (для уточнения событий)
     void Add(
         double                     time,
-        std::vector<double> const &values);
+        std::vector<double> const &values,
+        StepOutput const          &step = {});
+
+    void SetEvents(std::shared_ptr<EventLocator> locator) { events = std::move(locator); }
+
+    void SetSteadyState(std::shared_ptr<SteadyStateDetector> detector) { steadyState = std::move(detector); }
+
+    // Произошло терминальное событие или режим установился
+    bool Stopped() const { return stopped; }
+
+    // Продолжение установившегося решения последним значением до time
+    void Extend(double time);
 
     std::pair<double, std::vector<double>>& operator[](size_t index);
     const std::pair<double, std::vector<double>>& operator[](size_t index) const;
@@ -16,4 +36,7 @@ public:
 
 private:
     std::vector<std::pair<double, std::vector<double>>> data;
-};
\ No newline at end of file
+    std::shared_ptr<EventLocator> events;
+    std::shared_ptr<SteadyStateDetector> steadyState;
+    bool stopped = false;
+};
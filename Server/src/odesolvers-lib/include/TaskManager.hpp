@@ -1,5 +1,11 @@
 #pragma once
 #include "HttpService.h"
+#include "ExpressionCompiler.hpp"
+#include "PluginManager.hpp"
+#include "Models.hpp"
+#include "Dual.hpp"
+#include "Solver.hpp"
+#include "RKNSolver.hpp"
 
 #include <functional>
 #include <vector>
@@ -16,12 +22,130 @@ using ODEFunction = std::function<std::vector<double>(double, std::vector<double
 class TaskManager
 {
 private:
+    static constexpr char const *IMPLICIT_SUFFIX = "/implicit";
+
     std::unordered_map<std::string, ODEFunction> tasks;
+    std::unordered_map<std::string, JacobianFunction> jacobians;
+    std::unordered_map<std::string, JacobianVectorFunction> jacobianVectors;
+    std::unordered_map<std::string, CsrPattern> sparsity;
+    std::unordered_map<std::string, PreconditionerFunction> preconditioners;
+
+    // Формы второго порядка
+    std::unordered_map<std::string, SecondOrderSystem> secondOrder;
+
+    // Привязка шаблонных моделей: модель строится один раз из текущих значений параметров
+    // при первом запросе задачи (когда параметры уже загружены), правая часть и производные
+    // хранят её копию и не обращаются к parameters при параллельных вычислениях
+    std::unordered_map<std::string, std::vector<std::function<void()>>> models;
+
+    bool BindModel(std::string const &taskName);
+
+    // Привязка плагина из PluginManager к текущим значениям параметров
+    bool BindPlugin(std::string const &taskName);
+
+    // Значение параметра встроенной модели
+    double Parameter(std::string const &name) const;
+
+    // Значения параметров выражений в порядке ParameterNames() (what - для сообщения об ошибке)
+    std::vector<double> BindParameters(
+        ExpressionProgram const &program,
+        std::string const       &what) const;
+
+    // Регистрация шаблонной модели: правая часть, матрица Якоби и произведение J * v
+    // автоматическим дифференцированием (N - число столбцов, вычисляемых за один проход)
+    template <size_t N, typename Factory>
+    void RegisterModel(
+        std::string const &taskName,
+        Factory            makeModel)
+    {
+        models[taskName].push_back([this, taskName, makeModel]()
+        {
+            auto model = makeModel();
+            tasks[taskName] = [model](double t, const std::vector<double>& y)
+            {
+                return model(t, y);
+            };
+
+            jacobians[taskName] = [model](double t, const std::vector<double>& y)
+            {
+                return JacobianAD<N>(model, t, y);
+            };
+
+            jacobianVectors[taskName] = [model](double t, const std::vector<double>& y, const std::vector<double>& v)
+            {
+                return JacobianVectorProductAD(model, t, y, v);
+            };
+        });
+    }
+
+    // Форма второго порядка шаблонной модели (Acceleration, VelocityFree - см. Models.hpp)
+    template <typename Factory>
+    void RegisterSecondOrderModel(
+        std::string const &taskName,
+        Factory            makeModel)
+    {
+        models[taskName].push_back([this, taskName, makeModel]()
+        {
+            auto model = makeModel();
+            secondOrder[taskName] = SecondOrderSystem{[model](double t, const std::vector<double>& y)
+            {
+                return model.Acceleration(t, y);
+            }, model.VelocityFree()};
+        });
+    }
 
 public:
     TaskManager();
 
     void LoadParameters(json const &params);
-    const ODEFunction& GetTask(std::string const &taskName) const;
+    const ODEFunction& GetTask(std::string const &taskName);
+
+    // Аналитическая матрица Якоби задачи, если она известна (иначе nullptr)
+    const JacobianFunction* FindJacobian(std::string const &taskName) const;
+
+    // Произведение J * v задачи автоматическим дифференцированием, если модель встроенная (иначе nullptr)
+    const JacobianVectorFunction* FindJacobianVector(std::string const &taskName) const;
+
+    // Объявленная структура матрицы Якоби размерности n, если она известна (иначе nullptr)
+    const CsrPattern* FindSparsity(
+        std::string const &taskName,
+        size_t             n);
+
+    // Жёсткая часть правой части для метода IMEX (f = f_explicit + f_implicit), если задана
+    // (иначе nullptr). Хранится как отдельная задача с именем ImplicitPartName(taskName),
+    // поэтому её производные ищутся по этому имени.
+    const ODEFunction* FindImplicitPart(std::string const &taskName);
+
+    static std::string ImplicitPartName(std::string const &taskName) { return taskName + IMPLICIT_SUFFIX; }
+
+    // Форма второго порядка q'' = g(t, q, q') задачи, если объявлена (иначе false)
+    bool FindSecondOrder(
+        std::string const &taskName,
+        SecondOrderSystem &system) const;
+
+    // Предобусловливатель задачи для безматричных методов, если он известен (иначе nullptr)
+    const PreconditionerFunction* FindPreconditioner(std::string const &taskName) const;
+
+    // Регистрация пользовательской системы, заданной выражениями правых частей
+    void RegisterExpressionTask(
+        std::string const              &taskName,
+        std::vector<std::string> const &expressions);
+
+    // Регистрация формы второго порядка выражениями ускорений: m выражений над состоянием
+    // y0..y{2m-1} = (q, q'); независимость от скоростей определяется по выражениям.
+    // firstOrder - зарегистрировать и эквивалентную систему первого порядка (q', g)
+    // (если правые части не заданы отдельно). Регистрация правых частей выражениями
+    // сбрасывает форму второго порядка задачи
+    void RegisterSecondOrderTask(
+        std::string const              &taskName,
+        std::vector<std::string> const &expressions,
+        bool                            firstOrder);
+
+    // Функции событий g_i(t, y), заданные выражениями над состоянием размерности n
+    // (те же правила записи и параметры, что и у правых частей)
+    EventFunction CompileEvents(
+        std::vector<std::string> const &expressions,
+        size_t                          n) const;
+
     std::unordered_map<std::string, double> parameters;
 };
@@ -0,0 +1,391 @@
+#include "../include/AdamsSolver.hpp"
+
+namespace
+{
+    constexpr double ROUND = std::numeric_limits<double>::epsilon();
+    constexpr double FOURU = 4.0 * ROUND;
+}
+
+double AdamsSolver::Norm(std::vector<double> const &x) const
+{
+    return tolerances.Norm(x, weight);
+}
+
+void AdamsSolver::UpdateWeights(
+    std::vector<double> const &y,
+    double                     tolerance)
+{
+    if (!tolerances.Componentwise())
+    {
+        weight.resize(n);
+        for (size_t l = 0; l < n; ++l)
+            weight[l] = 1.0 + std::fabs(y[l]);
+        return;
+    }
+
+    // Погрешность сравнивается с tolerance, поэтому масштабы sc_i делятся на него
+    tolerances.Scales(tolerance, y, y, weight);
+    for (double &value : weight)
+        value /= tolerance;
+}
+
+void AdamsSolver::Start(
+    double                     t,
+    std::vector<double> const &y,
+    double                    &h,
+    double                     tolerance)
+{
+    n = y.size();
+    UpdateWeights(y, tolerance);
+
+    phi.assign(17, std::vector<double>(n, 0.0));
+    p.assign(n, 0.0);
+    yp = Derivative(t, y);
+    phi[1] = yp;
+
+    // Начальный шаг: погрешность формулы первого порядка h^2 |f| / 4 не больше допуска
+    double sum = Norm(yp);
+    double absh = std::fabs(h);
+    if (tolerance < 16.0 * sum * h * h)
+        absh = 0.25 * std::sqrt(tolerance / sum);
+    h = std::max(absh, FOURU * std::fabs(t));
+
+    sig[1] = 1.0;
+    g[1] = 1.0;
+    g[2] = 0.5;
+    hold = 0.0;
+    k = 1;
+    kold = 0;
+    ns = 0;
+    phase1 = true;
+
+    // Очень малый допуск: учёт распространения ошибок округления (столбцы 15 и 16)
+    nornd = 0.5 * tolerance > 100.0 * ROUND;
+}
+
+void AdamsSolver::AdvanceStep(
+    double              &t,
+    std::vector<double> &y,
+    double              &h,
+    double               tolerance)
+{
+    double const p5eps = 0.5 * tolerance;
+    int ifail = 0;
+    int knew = k;
+    double erk = 0.0, erkm1 = 0.0, erkm2 = 0.0, absh = 0.0;
+
+    UpdateWeights(y, tolerance);
+
+    while (true)
+    {
+        // 1. Коэффициенты формул для текущего шага
+        int const kp1 = k + 1;
+        int const kp2 = k + 2;
+        int const km1 = k - 1;
+        int const km2 = k - 2;
+
+        if (h != hold)
+            ns = 0;
+        if (ns <= kold)
+            ++ns;
+        int const nsp1 = ns + 1;
+
+        if (k >= ns)
+        {
+            beta[ns] = 1.0;
+            alpha[ns] = 1.0 / ns;
+            double temp1 = h * ns;
+            sig[nsp1] = 1.0;
+            for (int i = nsp1; i <= k; ++i)
+            {
+                double temp2 = psi[i - 1];
+                psi[i - 1] = temp1;
+                beta[i] = beta[i - 1] * psi[i - 1] / temp2;
+                temp1 = temp2 + h;
+                alpha[i] = h / temp1;
+                sig[i + 1] = i * alpha[i] * sig[i];
+            }
+            psi[k] = temp1;
+
+            // Коэффициенты g через вспомогательные v, w
+            if (ns == 1)
+            {
+                for (int iq = 1; iq <= k; ++iq)
+                {
+                    v[iq] = 1.0 / (iq * (iq + 1.0));
+                    w[iq] = v[iq];
+                }
+            }
+            else
+            {
+                // Порядок повышен: диагональная часть v
+                if (k > kold)
+                {
+                    v[k] = 1.0 / (k * (kp1 + 0.0));
+                    for (int j = 1; j <= ns - 2; ++j)
+                    {
+                        int i = k - j;
+                        v[i] -= alpha[j + 1] * v[i + 1];
+                    }
+                }
+
+                int limit1 = kp1 - ns;
+                for (int iq = 1; iq <= limit1; ++iq)
+                {
+                    v[iq] -= alpha[ns] * v[iq + 1];
+                    w[iq] = v[iq];
+                }
+                g[nsp1] = w[1];
+            }
+
+            for (int i = ns + 2; i <= kp1; ++i)
+            {
+                int limit2 = kp2 - i;
+                for (int iq = 1; iq <= limit2; ++iq)
+                    w[iq] -= alpha[i - 1] * w[iq + 1];
+                g[i] = w[1];
+            }
+        }
+
+        // 2. Прогноз, вычисление f и оценки погрешности порядков k, k-1, k-2
+        for (int i = nsp1; i <= k; ++i)
+        {
+            for (size_t l = 0; l < n; ++l)
+                phi[i][l] *= beta[i];
+        }
+
+        for (size_t l = 0; l < n; ++l)
+        {
+            phi[kp2][l] = phi[kp1][l];
+            phi[kp1][l] = 0.0;
+            p[l] = 0.0;
+        }
+        for (int j = 1; j <= k; ++j)
+        {
+            int i = kp1 - j;
+            for (size_t l = 0; l < n; ++l)
+            {
+                p[l] += g[i] * phi[i][l];
+                phi[i][l] += phi[i + 1][l];
+            }
+        }
+
+        if (nornd)
+        {
+            for (size_t l = 0; l < n; ++l)
+                p[l] = y[l] + h * p[l];
+        }
+        else
+        {
+            for (size_t l = 0; l < n; ++l)
+            {
+                double tau = h * p[l] - phi[15][l];
+                p[l] = y[l] + tau;
+                phi[16][l] = (p[l] - y[l]) - tau;
+            }
+        }
+
+        double const told = t;
+        t += h;
+        absh = std::fabs(h);
+        yp = f(t, p);
+
+        double sumk = 0.0, sumkm1 = 0.0, sumkm2 = 0.0;
+        for (size_t l = 0; l < n; ++l)
+        {
+            double temp3 = 1.0 / weight[l];
+            double temp4 = yp[l] - phi[1][l];
+            if (km2 > 0)
+                sumkm2 += ((phi[km1][l] + temp4) * temp3) * ((phi[km1][l] + temp4) * temp3);
+            if (km2 >= 0)
+                sumkm1 += ((phi[k][l] + temp4) * temp3) * ((phi[k][l] + temp4) * temp3);
+            sumk += (temp4 * temp3) * (temp4 * temp3);
+        }
+        if (km2 > 0)
+            erkm2 = absh * sig[km1] * GSTR[km2] * std::sqrt(sumkm2 / n);
+        if (km2 >= 0)
+            erkm1 = absh * sig[k] * GSTR[km1] * std::sqrt(sumkm1 / n);
+        double temp5 = absh * std::sqrt(sumk / n);
+        double err = temp5 * (g[k] - g[kp1]);
+        erk = temp5 * sig[kp1] * GSTR[k];
+
+        knew = k;
+        if (km2 > 0)
+        {
+            if (std::max(erkm1, erkm2) <= erk)
+                knew = km1;
+        }
+        else if (km2 == 0)
+        {
+            if (erkm1 <= 0.5 * erk)
+                knew = km1;
+        }
+
+        if (err <= tolerance)
+            break;
+
+        // 3. Отказ: восстановление t, phi и psi
+        phase1 = false;
+        t = told;
+        for (int i = 1; i <= k; ++i)
+        {
+            double temp1 = 1.0 / beta[i];
+            for (size_t l = 0; l < n; ++l)
+                phi[i][l] = temp1 * (phi[i][l] - phi[i + 1][l]);
+        }
+        for (int i = 2; i <= k; ++i)
+            psi[i - 1] = psi[i] - h;
+
+        // На третьем отказе - первый порядок, далее оптимальный шаг
+        ++ifail;
+        double temp2 = 0.5;
+        if (ifail >= 3)
+        {
+            if (ifail > 3 && p5eps < 0.25 * erk)
+                temp2 = std::sqrt(p5eps / erk);
+            knew = 1;
+        }
+        h *= temp2;
+        k = knew;
+
+        if (!(std::fabs(h) >= FOURU * std::fabs(t)) || !std::isfinite(err))
+            throw std::runtime_error("Adams: step size too small");
+    }
+
+    // 4. Шаг принят: коррекция и вычисление f
+    int const kp1 = k + 1;
+    int const kp2 = k + 2;
+    int const km1 = k - 1;
+
+    kold = k;
+    hold = h;
+
+    double temp1 = h * g[kp1];
+    if (nornd)
+    {
+        for (size_t l = 0; l < n; ++l)
+            y[l] = p[l] + temp1 * (yp[l] - phi[1][l]);
+    }
+    else
+    {
+        for (size_t l = 0; l < n; ++l)
+        {
+            double rho = temp1 * (yp[l] - phi[1][l]) - phi[16][l];
+            y[l] = p[l] + rho;
+            phi[15][l] = (y[l] - p[l]) - rho;
+        }
+    }
+    yp = f(t, y);
+
+    // Разности для следующего шага
+    for (size_t l = 0; l < n; ++l)
+    {
+        phi[kp1][l] = yp[l] - phi[1][l];
+        phi[kp2][l] = phi[kp1][l] - phi[kp2][l];
+    }
+    for (int i = 1; i <= k; ++i)
+    {
+        for (size_t l = 0; l < n; ++l)
+            phi[i][l] += phi[kp1][l];
+    }
+
+    // Оценка погрешности порядка k+1 и выбор порядка следующего шага:
+    // в начальной фазе порядок растёт всегда, после решения понизить - понижается,
+    // при переменном шаге оценка ненадёжна и порядок не меняется
+    if (knew == km1 || k == MAX_ORDER)
+        phase1 = false;
+
+    bool raise = false, lower = false;
+    double erkp1 = 0.0;
+    if (phase1)
+    {
+        raise = true;
+    }
+    else if (knew == km1)
+    {
+        lower = true;
+    }
+    else if (kp1 <= ns)
+    {
+        erkp1 = absh * GSTR[kp1] * Norm(phi[kp2]);
+        if (k == 1)
+        {
+            raise = erkp1 < 0.5 * erk;
+        }
+        else if (erkm1 <= std::min(erk, erkp1))
+        {
+            lower = true;
+        }
+        else
+        {
+            raise = erkp1 < erk && k != MAX_ORDER;
+        }
+    }
+
+    if (raise)
+    {
+        k = kp1;
+        erk = erkp1;
+    }
+    else if (lower)
+    {
+        k = km1;
+        erk = erkm1;
+    }
+
+    // Шаг для следующего шага: удвоение, если погрешность мала и для шага 2h
+    double hnew = h + h;
+    if (!phase1 && !(p5eps >= erk * std::ldexp(1.0, k + 1)))
+    {
+        hnew = h;
+        if (!(p5eps >= erk))
+        {
+            double r = std::pow(p5eps / erk, 1.0 / (k + 1));
+            hnew = absh * std::max(0.5, std::min(0.9, r));
+            hnew = std::max(hnew, FOURU * std::fabs(t));
+        }
+    }
+    h = hnew;
+}
+
+void AdamsSolver::Step(
+    double               t,
+    std::vector<double> &y,
+    double              &hStep,
+    double               tolerance)
+{
+    Storage local;
+    Solve(t, y, t + hStep, local, tolerance);
+    y = local[local.Size() - 1].second;
+}
+
+void AdamsSolver::Solve(
+    double                     t0,
+    std::vector<double> const &y0,
+    double                     tEnd,
+    Storage                   &storage,
+    double                     tolerance)
+{
+    double t = t0;
+    std::vector<double> y = y0;
+    double h = StartingStep(t, y, tEnd, tolerance, 1);
+
+    Start(t, y, h, tolerance);
+    storage.Add(t, y);
+
+    while (t < tEnd && !storage.Stopped())
+    {
+        // Последний шаг укорачивается до tEnd: формулы переменного шага это допускают
+        bool last = t + h >= tEnd;
+        if (last)
+            h = tEnd - t;
+
+        if (h <= 10.0 * ROUND * std::max(1.0, std::fabs(t)))
+            throw std::runtime_error("Adams: step size too small");
+
+        AdvanceStep(t, y, h, tolerance);
+        if (last && t + 10.0 * ROUND * std::max(1.0, std::fabs(tEnd)) >= tEnd)
+            t = tEnd;
+        storage.Add(t, y);
+    }
+}
@@ -0,0 +1,415 @@
+#include "../include/AutoSolver.hpp"
+#include "../include/ComputePool.hpp"
+
+#include <map>
+
+std::mutex AutoSolver::cacheMutex;
+std::unordered_map<std::string, std::string> AutoSolver::cache;
+
+namespace
+{
+    // Прерывание запуска по числу вычислений f. Не наследует std::runtime_error:
+    // решатели перехватывают его как отказ шага и продолжали бы вычисления
+    class EvaluationLimit : public std::exception
+    {
+    public:
+        char const* what() const noexcept override { return "Auto: evaluation limit reached"; }
+    };
+
+    double Norm2(std::vector<double> const &v)
+    {
+        double sum = 0.0;
+        for (double x : v)
+            sum += x * x;
+        return std::sqrt(sum);
+    }
+
+    // Знак и десятичный порядок: значения одного порядка попадают в одну область
+    std::string Decade(double value)
+    {
+        if (value == 0.0 || !std::isfinite(value))
+            return "0";
+        int decade = static_cast<int>(std::floor(std::log10(std::fabs(value))));
+        return (value < 0.0 ? "-" : "+") + std::to_string(decade);
+    }
+}
+
+AutoSolver::AutoSolver(
+    std::function<std::vector<double>(
+        double,
+        std::vector<double> const &)> func,
+    double                            initialStep,
+    std::vector<AutoCandidate>        candidates)
+    : Solver(func, initialStep), candidates(std::move(candidates))
+{
+    if (this->candidates.empty())
+        throw std::invalid_argument("Auto: no candidate methods");
+}
+
+std::string AutoSolver::Key(
+    std::string const                             &equation,
+    std::vector<std::string> const                &equations,
+    std::unordered_map<std::string, double> const &parameters,
+    double                                         tolerance)
+{
+    std::string key = equation + '|' + Decade(tolerance);
+    for (auto const &expression : equations)
+    {
+        key += '|';
+        key += expression;
+    }
+
+    // Параметры в порядке имён: ключ не зависит от порядка полей запроса
+    std::map<std::string, double> const sorted(parameters.begin(), parameters.end());
+    for (auto const &[name, value] : sorted)
+    {
+        key += '|' + name + '=' + Decade(value);
+    }
+    return key;
+}
+
+void AutoSolver::Step(
+    double               t,
+    std::vector<double> &y,
+    double              &hStep,
+    double               tolerance)
+{
+    Storage local;
+    Solve(t, y, t + hStep, local, tolerance);
+    y = local[local.Size() - 1].second;
+}
+
+double AutoSolver::SpectralRadius(
+    double                     t,
+    std::vector<double> const &y,
+    std::vector<double> const &fy)
+{
+    size_t const n = y.size();
+    double const sqrtEps = std::sqrt(std::numeric_limits<double>::epsilon());
+
+    // Как в RKCSolver: sigma = |f(y + d) - f(y)| / |d| вдоль приближения собственного вектора
+    double yNorm = Norm2(y);
+    double dyNorm = yNorm > 0.0 ? sqrtEps * yNorm : sqrtEps;
+
+    std::vector<double> d = eigenvector.size() == n ? eigenvector : fy;
+    double dNorm = Norm2(d);
+    if (dNorm == 0.0)
+    {
+        std::fill(d.begin(), d.end(), 1.0);
+        dNorm = std::sqrt(static_cast<double>(n));
+    }
+    for (size_t i = 0; i < n; ++i)
+        d[i] *= dyNorm / dNorm;
+
+    std::vector<double> z(n);
+    double sigma = 0.0;
+    for (int iter = 0; iter < MAX_POWER; ++iter)
+    {
+        for (size_t i = 0; i < n; ++i)
+            z[i] = y[i] + d[i];
+        std::vector<double> fz = f(t, z);
+        probeEvaluations++;
+        for (size_t i = 0; i < n; ++i)
+            fz[i] -= fy[i];
+
+        double dfNorm = Norm2(fz);
+        double sigmaOld = sigma;
+        sigma = dfNorm / dyNorm;
+        if (iter > 0 && std::fabs(sigma - sigmaOld) <= 0.1 * sigma)
+            break;
+
+        if (dfNorm > 0.0)
+        {
+            for (size_t i = 0; i < n; ++i)
+                d[i] = fz[i] * (dyNorm / dfNorm);
+        }
+        else
+        {
+            size_t index = static_cast<size_t>(iter) % n;
+            d[index] = -d[index];
+        }
+    }
+
+    eigenvector = d;
+    return sigma;
+}
+
+void AutoSolver::Execute(
+    size_t                     index,
+    double                     t,
+    std::vector<double> const &y,
+    double                     h,
+    double                     tEnd,
+    double                     tolerance,
+    ErrorTolerances const     &runTolerances,
+    std::atomic<size_t> const &limit,
+    Run                       &run) const
+{
+    std::atomic<size_t> count{0};
+    auto counted = [this, &count, &limit](double time, std::vector<double> const &state)
+    {
+        if (count.load() >= limit.load())
+            throw EvaluationLimit();
+        ++count;
+        return f(time, state);
+    };
+
+    try
+    {
+        candidates[index].run(counted, h, t, y, tEnd, run.storage, tolerance, runTolerances);
+        run.completed = true;
+    }
+    catch (EvaluationLimit const &)
+    {
+    }
+    catch (std::exception const &)
+    {
+        // Метод не справился с задачей: в выборе учитывается пройденная им часть
+    }
+    run.evaluations = count.load();
+
+    // Решение обрывается на первой точке с нечисловыми значениями
+    Storage const &points = run.storage;
+    for (size_t i = 0; i < points.Size(); ++i)
+    {
+        bool finite = std::isfinite(points[i].first);
+        for (double value : points[i].second)
+            finite = finite && std::isfinite(value);
+        if (finite)
+            continue;
+
+        Storage valid;
+        for (size_t k = 0; k < i; ++k)
+            valid.Add(points[k].first, points[k].second);
+        run.storage = std::move(valid);
+        run.completed = false;
+        break;
+    }
+}
+
+size_t AutoSolver::Select(
+    double                     t,
+    std::vector<double> const &y,
+    double                     tEnd,
+    double                     tFinal,
+    double                     tolerance,
+    Run                       &winner)
+{
+    trials++;
+
+    // Точность методов при одном допуске различна. Завершивший отрезок кандидат повторяет
+    // его с допуском в REFINE раз меньше: разность результатов оценивает глобальную
+    // погрешность, и метод точен, если она, продолженная линейно до tFinal, не больше
+    // допуска. Пробные отрезки одинаковы, поэтому после проверки точного метода остальные
+    // запуски прерываются, как только число их вычислений f превысит его
+    ErrorTolerances refined;
+    if (tolerances.Componentwise())
+    {
+        std::vector<double> atol(y.size()), rtol(y.size());
+        for (size_t i = 0; i < y.size(); ++i)
+        {
+            atol[i] = tolerances.Absolute(i, tolerance) / REFINE;
+            rtol[i] = tolerances.Relative(i, tolerance) / REFINE;
+        }
+        refined = ErrorTolerances(atol, rtol, tolerances.NormKind());
+    }
+
+    double const growth = (tFinal - t) / (tEnd - t);
+    std::vector<Run> runs(candidates.size());
+    std::vector<Run> checks(candidates.size());
+    std::vector<char> accurate(candidates.size(), 0);
+    std::atomic<size_t> limit{TRIAL_EVALUATIONS};
+    ComputePool::Instance().ParallelFor(candidates.size(), [&](size_t i)
+    {
+        Execute(i, t, y, 0.0, tEnd, tolerance, tolerances, limit, runs[i]);
+
+        Storage const &coarse = runs[i].storage;
+        if (coarse.Size() < 2 || !(coarse[coarse.Size() - 1].first >= tEnd))
+            return;
+
+        std::atomic<size_t> checkLimit{CHECK_EVALUATIONS};
+        Execute(i, t, y, 0.0, tEnd, tolerance / REFINE, refined, checkLimit, checks[i]);
+        Storage const &fine = checks[i].storage;
+        if (fine.Size() < 2 || !(fine[fine.Size() - 1].first >= tEnd))
+            return;
+
+        std::vector<double> const &reference = fine[fine.Size() - 1].second;
+        std::vector<double> error = coarse[coarse.Size() - 1].second;
+        for (size_t c = 0; c < error.size(); ++c)
+            error[c] -= reference[c];
+        if (!(growth * tolerances.Norm(error, reference, reference, tolerance) <= 1.0))
+            return;
+
+        accurate[i] = 1;
+        size_t current = limit.load();
+        while (runs[i].evaluations < current && !limit.compare_exchange_weak(current, runs[i].evaluations))
+        {
+        }
+    });
+
+    // Без точных методов выбирается самый дешёвый из продвинувшихся
+    bool anyAccurate = std::find(accurate.begin(), accurate.end(), 1) != accurate.end();
+    size_t best = candidates.size();
+    double bestCost = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < runs.size(); ++i)
+    {
+        trialEvaluations += checks[i].evaluations;
+
+        Storage const &points = runs[i].storage;
+        if (points.Size() < 2 || (anyAccurate && !accurate[i]))
+            continue;
+
+        double progress = points[points.Size() - 1].first - t;
+        double cost = static_cast<double>(runs[i].evaluations) / progress;
+        if (progress > 0.0 && cost < bestCost)
+        {
+            best = i;
+            bestCost = cost;
+        }
+    }
+
+    if (best == candidates.size())
+        throw std::runtime_error("Auto: no candidate method advanced the solution at t = " + std::to_string(t));
+
+    for (size_t i = 0; i < runs.size(); ++i)
+    {
+        if (i != best)
+            trialEvaluations += runs[i].evaluations;
+    }
+    winner = std::move(runs[best]);
+    return best;
+}
+
+size_t AutoSolver::Cached(std::string const &key) const
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = cache.find(key);
+    if (it == cache.end())
+        return candidates.size();
+
+    for (size_t i = 0; i < candidates.size(); ++i)
+    {
+        if (candidates[i].name == it->second)
+            return i;
+    }
+    return candidates.size();
+}
+
+void AutoSolver::Remember(
+    std::string const &key,
+    size_t             index) const
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (cache.size() >= MAX_CACHE_SIZE)
+        cache.clear();
+    cache[key] = candidates[index].name;
+}
+
+void AutoSolver::Solve(
+    double                     t0,
+    std::vector<double> const &y0,
+    double                     tEnd,
+    Storage                   &storage,
+    double                     tolerance)
+{
+    double t = t0;
+    std::vector<double> y = y0;
+    storage.Add(t, y);
+
+    segments.clear();
+    trials = 0;
+    probeEvaluations = 0;
+    trialEvaluations = 0;
+    eigenvector.clear();
+
+    double const length = tEnd - t0;
+    double h = stepSize;
+    size_t current = candidates.size();
+    double rhoChoice = 0.0;
+    double cost = 0.0;      // Вычислений f на единицу t выбранным методом (0 - неизвестно)
+    bool reselect = true;
+    bool measure = false;   // Повторный выбор после прерванного участка - только пробными запусками
+
+    // Точки запуска после начальной добавляются в решение (до терминального события);
+    // участок продолжает предыдущий, если метод не сменился
+    auto append = [&](size_t index, Run const &run)
+    {
+        Storage const &points = run.storage;
+        double tStart = t;
+        for (size_t i = 1; i < points.Size() && !storage.Stopped(); ++i)
+            storage.Add(points[i].first, points[i].second);
+
+        t = storage[storage.Size() - 1].first;
+        y = storage[storage.Size() - 1].second;
+        if (points.Size() > 1)
+        {
+            h = points[points.Size() - 1].first - points[points.Size() - 2].first;
+            cost = static_cast<double>(run.evaluations) / (points[points.Size() - 1].first - tStart);
+        }
+
+        if (!segments.empty() && segments.back().method == candidates[index].name && segments.back().t1 == tStart)
+        {
+            segments.back().t1 = t;
+            segments.back().evaluations += run.evaluations;
+        }
+        else
+        {
+            segments.push_back({candidates[index].name, tStart, t, run.evaluations});
+        }
+    };
+
+    while (t < tEnd && !storage.Stopped())
+    {
+        // Жёсткость: rho не меньше 1 / длина интервала, ниже задача нежёсткая при любом методе
+        std::vector<double> fy = f(t, y);
+        probeEvaluations++;
+        double rho = std::max(SpectralRadius(t, y, fy), 1.0 / length);
+        if (rho > RHO_CHANGE * rhoChoice || rho * RHO_CHANGE < rhoChoice)
+            reselect = true;
+
+        if (reselect)
+        {
+            reselect = false;
+            rhoChoice = rho;
+            std::string const key = cacheKey.empty() ? std::string() : cacheKey + "|rho" + Decade(rho);
+            size_t cached = key.empty() || measure ? candidates.size() : Cached(key);
+            if (cached < candidates.size())
+            {
+                // Ранее выбранный метод: стоимость неизвестна до первого участка
+                if (cached != current)
+                    cost = 0.0;
+                current = cached;
+            }
+            else
+            {
+                Run trial;
+                size_t chosen = Select(t, y, std::min(tEnd, t + TRIAL_FRACTION * length), tEnd, tolerance, trial);
+                if (!key.empty())
+                    Remember(key, chosen);
+
+                current = chosen;
+                append(current, trial);
+                continue;
+            }
+        }
+
+        // Участок выбранным методом; перерасход вычислений относительно измеренной стоимости
+        // означает, что поведение решения изменилось, и выбор повторяется с достигнутой точки
+        double tNext = std::min(tEnd, t + SEGMENT_FRACTION * length);
+        std::atomic<size_t> limit{cost > 0.0
+            ? static_cast<size_t>(SEGMENT_SLACK * cost * (tNext - t)) + SEGMENT_RESERVE
+            : std::numeric_limits<size_t>::max()};
+
+        Run run;
+        Execute(current, t, y, h, tNext, tolerance, tolerances, limit, run);
+        reselect = measure = !run.completed;
+        if (run.storage.Size() < 2)
+        {
+            if (run.completed)
+                throw std::runtime_error("Auto: " + candidates[current].name + " made no progress at t = " + std::to_string(t));
+            continue;
+        }
+
+        append(current, run);
+    }
+}
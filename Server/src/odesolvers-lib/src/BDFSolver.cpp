@@ -0,0 +1,383 @@
+#include "../include/BDFSolver.hpp"
+
+std::array<std::array<double, BDFSolver::MAX_ORDER + 1>, BDFSolver::MAX_ORDER + 1> const &BDFSolver::Coefficients()
+{
+    static auto const table = []()
+    {
+        std::array<std::array<double, MAX_ORDER + 1>, MAX_ORDER + 1> l{};
+        for (int order = 1; order <= MAX_ORDER; ++order)
+        {
+            // Многочлен Π(1 + x/i), i = 1..order
+            std::array<double, MAX_ORDER + 1> p{};
+            p[0] = 1.0;
+            for (int i = 1; i <= order; ++i)
+                for (int j = i; j >= 1; --j)
+                    p[j] += p[j - 1] / i;
+
+            for (int j = 0; j <= order; ++j)
+                l[order][j] = p[j] / p[1];
+        }
+        return l;
+    }();
+
+    return table;
+}
+
+double BDFSolver::Norm(std::vector<double> const &v) const
+{
+    return tolerances.Norm(v, scale);
+}
+
+void BDFSolver::Predict()
+{
+    // Умножение на матрицу Паскаля: экстраполяция многочлена истории на t + h
+    for (int k = 0; k < q; ++k)
+    {
+        for (int j = q; j > k; --j)
+        {
+            double       *lower = z[j - 1].data();
+            double const *upper = z[j].data();
+            for (size_t i = 0; i < n; ++i)
+                lower[i] += upper[i];
+        }
+    }
+}
+
+void BDFSolver::Rescale(double hNew)
+{
+    double r = hNew / h;
+    double rj = 1.0;
+    for (int j = 1; j <= q; ++j)
+    {
+        rj *= r;
+        for (size_t i = 0; i < n; ++i)
+            z[j][i] *= rj;
+    }
+
+    h = hNew;
+    stepsAtOrder = 0;
+    haveDPrev = false;
+}
+
+bool BDFSolver::Correct(
+    double tNew,
+    double tolerance)
+{
+    double l0 = Coefficients()[q][0];
+    double gamma = h * l0;
+    bool matrixFree = linearSolverKind == LinearSolverKind::Krylov;
+    std::vector<double> y(n), r(n);
+
+    while (true)
+    {
+        if (!matrixFree && needJacobian)
+        {
+            J = JacobianCsr(tNew, z[0], nullptr, tolerance);
+            needJacobian = false;
+            jacobianCurrent = true;
+            jacobianAge = 0;
+            gammaFactored = 0.0;
+        }
+
+        if (!matrixFree && (gammaFactored == 0.0 || std::fabs(gamma / gammaFactored - 1.0) > GAMMA_CHANGE))
+        {
+            if (!linear->Factorize(J, gamma))
+                return false;
+            gammaFactored = gamma;
+        }
+
+        e.assign(n, 0.0);
+        y = z[0];
+        double crate = 1.0;
+        double delOld = 0.0;
+
+        for (int m = 0; m < MAX_NEWTON; ++m)
+        {
+            std::vector<double> fy = f(tNew, y);
+            for (size_t i = 0; i < n; ++i)
+                r[i] = h * fy[i] - z[1][i] - e[i];
+
+            if (matrixFree)
+            {
+                SolveKrylov(tNew, y, fy, gamma, r);
+            }
+            else
+            {
+                linear->Solve(r);
+
+                // Поправка на отличие текущего h*l0 от использованного в разложении
+                if (gamma != gammaFactored)
+                {
+                    double c = 2.0 / (1.0 + gamma / gammaFactored);
+                    for (size_t i = 0; i < n; ++i)
+                        r[i] *= c;
+                }
+            }
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                e[i] += r[i];
+                y[i] = z[0][i] + l0 * e[i];
+            }
+
+            double del = l0 * Norm(r);
+            if (m > 0)
+                crate = std::max(0.3 * crate, del / delOld);
+
+            if (del * std::min(1.0, 1.5 * crate) <= NEWTON_TOL)
+                return true;
+
+            if (m > 0 && del > 2.0 * delOld)
+                break;
+
+            delOld = del;
+        }
+
+        // Нет сходимости: сначала обновляется устаревшая матрица Якоби, затем уменьшается шаг
+        if (matrixFree || jacobianCurrent)
+            return false;
+        needJacobian = true;
+    }
+}
+
+void BDFSolver::SolveKrylov(
+    double                     t,
+    std::vector<double> const &y,
+    std::vector<double> const &fy,
+    double                     gamma,
+    std::vector<double>       &r)
+{
+    double const sqrtEps = std::sqrt(std::numeric_limits<double>::epsilon());
+
+    double yNorm = 0.0;
+    for (double v : y)
+        yNorm += v * v;
+    yNorm = std::sqrt(yNorm);
+
+    // (I - gamma J) v: J v точно, если известно, иначе (f(y + sigma v) - f(y)) / sigma
+    std::vector<double> shifted(n);
+    auto multiply = [&](std::vector<double> const &v, std::vector<double> &out)
+    {
+        if (jacobianVector)
+        {
+            out = jacobianVector(t, y, v);
+            for (size_t i = 0; i < n; ++i)
+                out[i] = v[i] - gamma * out[i];
+            return;
+        }
+
+        double vNorm = 0.0;
+        for (double vi : v)
+            vNorm += vi * vi;
+        vNorm = std::sqrt(vNorm);
+
+        out.resize(n);
+        if (vNorm == 0.0)
+        {
+            std::fill(out.begin(), out.end(), 0.0);
+            return;
+        }
+
+        double sigma = sqrtEps * (1.0 + yNorm) / vNorm;
+        for (size_t i = 0; i < n; ++i)
+            shifted[i] = y[i] + sigma * v[i];
+        std::vector<double> fs = f(t, shifted);
+        for (size_t i = 0; i < n; ++i)
+            out[i] = v[i] - gamma * (fs[i] - fy[i]) / sigma;
+    };
+
+    std::function<void(std::vector<double> &)> precondition;
+    if (preconditioner)
+        precondition = [&](std::vector<double> &v) { preconditioner(t, y, gamma, v); };
+
+    std::vector<double> weights(n);
+    for (size_t i = 0; i < n; ++i)
+        weights[i] = 1.0 / scale[i];
+
+    std::vector<double> x;
+    Gmres(multiply, precondition, r, x, weights, KRYLOV_FACTOR * NEWTON_TOL, KRYLOV_RESTART, KRYLOV_MAX_RESTARTS);
+    r.swap(x);
+}
+
+void BDFSolver::AdaptAfterSuccess(
+    double                     err,
+    std::vector<double> const &d)
+{
+    ++stepsAtOrder;
+    if (stepsAtOrder <= q)
+    {
+        dPrev = d;
+        haveDPrev = true;
+        return;
+    }
+
+    // Допустимое изменение шага для порядков q - 1, q, q + 1 (смещения как в LSODE)
+    double rSame = 1.0 / (1.2 * std::pow(err, 1.0 / (q + 1)) + 1e-6);
+    double rDown = 0.0;
+    double rUp = 0.0;
+
+    if (q > 1)
+    {
+        double qFactorial = 1.0;
+        for (int i = 2; i <= q; ++i)
+            qFactorial *= i;
+        double errDown = qFactorial / q * Norm(z[q]);
+        rDown = 1.0 / (1.3 * std::pow(errDown, 1.0 / q) + 1e-6);
+    }
+
+    if (q < MAX_ORDER && haveDPrev)
+    {
+        std::vector<double> diff(n);
+        for (size_t i = 0; i < n; ++i)
+            diff[i] = d[i] - dPrev[i];
+        double errUp = Norm(diff) / (q + 2);
+        rUp = 1.0 / (1.4 * std::pow(errUp, 1.0 / (q + 2)) + 1e-6);
+    }
+
+    dPrev = d;
+    haveDPrev = true;
+
+    double r = rSame;
+    int newOrder = q;
+    if (rUp > r)
+    {
+        r = rUp;
+        newOrder = q + 1;
+    }
+    if (rDown > r)
+    {
+        r = rDown;
+        newOrder = q - 1;
+    }
+
+    if (r < MIN_CHANGE)
+        return;
+
+    if (newOrder == q + 1)
+    {
+        // Новый столбец z_(q+1) = h^(q+1) y^(q+1) / (q+1)!
+        double factorial = 1.0;
+        for (int i = 2; i <= q + 1; ++i)
+            factorial *= i;
+        for (size_t i = 0; i < n; ++i)
+            z[q + 1][i] = d[i] / factorial;
+    }
+    q = newOrder;
+
+    Rescale(h * std::min(r, MAX_GROWTH));
+}
+
+void BDFSolver::Step(
+    double               t,
+    std::vector<double> &y,
+    double              &hStep,
+    double               tolerance)
+{
+    Storage local;
+    Solve(t, y, t + hStep, local, tolerance);
+    y = local[local.Size() - 1].second;
+}
+
+void BDFSolver::Solve(
+    double                     t0,
+    std::vector<double> const &y0,
+    double                     tEnd,
+    Storage                   &storage,
+    double                     tolerance)
+{
+    auto const &l = Coefficients();
+
+    double t = t0;
+    n = y0.size();
+    q = 1;
+    h = StartingStep(t, y0, tEnd, tolerance, 1);
+    stepsAtOrder = 0;
+    haveDPrev = false;
+
+    std::vector<double> f0 = Derivative(t, y0);
+    z.assign(MAX_ORDER + 2, std::vector<double>(n, 0.0));
+    z[0] = y0;
+    for (size_t i = 0; i < n; ++i)
+        z[1][i] = h * f0[i];
+
+    gammaFactored = 0.0;
+    if (linearSolverKind == LinearSolverKind::Krylov)
+    {
+        linear.reset();
+        needJacobian = false;
+    }
+    else
+    {
+        J = JacobianCsr(t, y0, &f0, tolerance);
+        needJacobian = false;
+        jacobianCurrent = true;
+        jacobianAge = 0;
+        linear = MakeLinearSolver(linearSolverKind, J.pattern);
+    }
+
+    scale.resize(n);
+    std::vector<double> d(n);
+    int failures = 0;
+
+    storage.Add(t, y0);
+
+    while (t < tEnd && !storage.Stopped())
+    {
+        bool last = t + h >= tEnd;
+        if (last)
+            Rescale(tEnd - t);
+
+        if (h <= 10.0 * std::numeric_limits<double>::epsilon() * std::max(1.0, std::fabs(t)))
+            throw std::runtime_error("BDF: step size too small");
+
+        tolerances.Scales(tolerance, z[0], z[0], scale);
+
+        Predict();
+        double tNew = last ? tEnd : t + h;
+
+        double err = 0.0;
+        bool converged = Correct(tNew, tolerance);
+        if (converged)
+        {
+            double l0 = l[q][0];
+            for (size_t i = 0; i < n; ++i)
+                d[i] = l0 * e[i];
+            err = l0 / (q + 1) * Norm(e);
+        }
+
+        if (!converged || err > 1.0)
+        {
+            // Откат предсказания (обратная матрица Паскаля) и повтор с меньшим шагом
+            for (int k = q - 1; k >= 0; --k)
+                for (int j = k + 1; j <= q; ++j)
+                    for (size_t i = 0; i < n; ++i)
+                        z[j - 1][i] -= z[j][i];
+
+            ++failures;
+            double factor = converged
+                ? std::max(0.2, 0.9 * std::pow(err, -1.0 / (q + 1)))
+                : 0.25;
+            if (failures >= 2 && q > 1)
+                --q;
+            if (failures >= 3)
+                factor = std::min(factor, 0.1);
+
+            Rescale(h * factor);
+            continue;
+        }
+
+        for (int j = 0; j <= q; ++j)
+            for (size_t i = 0; i < n; ++i)
+                z[j][i] += l[q][j] * e[i];
+
+        t = tNew;
+        storage.Add(t, z[0]);
+
+        failures = 0;
+        jacobianCurrent = false;
+        if (linear && ++jacobianAge >= JACOBIAN_AGE)
+            needJacobian = true;
+
+        AdaptAfterSuccess(err, d);
+    }
+}
@@ -0,0 +1,129 @@
+#include "../include/ComputePool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+ComputePool& ComputePool::Instance()
+{
+    static ComputePool instance(std::max(1u, std::thread::hardware_concurrency()));
+    return instance;
+}
+
+ComputePool::ComputePool(size_t threads)
+{
+    for (size_t i = 0; i < threads; ++i)
+        workers.emplace_back([this]() { WorkerLoop(); });
+}
+
+ComputePool::~ComputePool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+
+    for (auto &worker : workers)
+        worker.join();
+}
+
+void ComputePool::WorkerLoop()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (stopping && tasks.empty())
+                return;
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
+
+void ComputePool::Submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push(std::move(task));
+    }
+    condition.notify_one();
+}
+
+void ComputePool::ParallelFor(
+    size_t                             count,
+    std::function<void(size_t)> const &body)
+{
+    if (count == 0)
+        return;
+
+    if (count == 1 || workers.empty())
+    {
+        for (size_t i = 0; i < count; ++i)
+            body(i);
+        return;
+    }
+
+    // Общее состояние переживает вызов: помощник может стартовать уже после возврата
+    struct State
+    {
+        std::function<void(size_t)> body;
+        size_t                      count;
+        std::atomic<size_t>         next{0};
+        std::atomic<size_t>         active{0};
+        std::mutex                  mutex;
+        std::condition_variable     done;
+        std::exception_ptr          error;
+    };
+
+    auto state = std::make_shared<State>();
+    state->body = body;
+    state->count = count;
+
+    auto work = [](State &s)
+    {
+        size_t i;
+        while ((i = s.next.fetch_add(1)) < s.count)
+        {
+            try
+            {
+                s.body(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(s.mutex);
+                if (!s.error)
+                    s.error = std::current_exception();
+                s.next = s.count;
+            }
+        }
+    };
+
+    size_t helpers = std::min(workers.size(), count - 1);
+    for (size_t h = 0; h < helpers; ++h)
+    {
+        Submit([state, work]()
+        {
+            state->active.fetch_add(1);
+            work(*state);
+            if (state->active.fetch_sub(1) == 1)
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->done.notify_all();
+            }
+        });
+    }
+
+    work(*state);
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&]() { return state->active.load() == 0; });
+
+    if (state->error)
+        std::rethrow_exception(state->error);
+}
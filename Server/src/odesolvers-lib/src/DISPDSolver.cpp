@@ -14,12 +14,12 @@ void DISPDSolver::Step(
     while (!stepAccepted && attempts < 10) 
     {
         computeKTerms(t, yTemp, h, k1, k2, k3);
-        double Aprime = computeAprime(k1, k2);
-        double sn = log(tolerance / (pow(q, 2*attempts) * Aprime)) / (2 * log(q));
 
-        if (sn < 0) 
+        // Погрешность (5.17) по стадиям: отказ до вычисления f в конце шага
+        double errA = computeAprime(k1, k2, yTemp, tolerance) / tolerance;
+        if (errA > 1.0) 
         {
-            h *= pow(q, sn);
+            h *= controller.Reject(errA, 2.0);
             attempts++;
             continue;
         }
@@ -35,37 +35,33 @@ void DISPDSolver::Step(
                 )
             )
         );
-        std::vector<double> kNext = MultiplyScalarByVector(h, f(t + h, yNext));
-        double AddPrime = computeAddoublePrime(h, k1, kNext);
-        double vn = log(tolerance / (pow(q, 2*attempts) * AddPrime)) / (2 * log(q));
+        std::vector<double> fNext = f(t + h, yNext);
+        std::vector<double> kNext = MultiplyScalarByVector(h, fNext);
+        double err = std::max(errA, computeAddoublePrime(h, k1, kNext, yTemp, yNext, tolerance) / tolerance);
 
-        if (vn < 0) 
+        if (err > 1.0) 
         {
-            h *= pow(q, vn);
+            h *= controller.Reject(err, 2.0);
             attempts++;
             continue;
         }
 
-        // Проверка устойчивости через V_n
+        // Проверка устойчивости через V_n: наибольший устойчивый шаг h * 18 / V_n
         double V = computeV(k1, k2, k3);
-        double rn = log(18.0 / (pow(q, attempts) * V)) / log(q);
+        double hStab = V > 0.0 ? SAFETY * h * STABILITY_BOUND / V : 0.0;
 
-        // Адаптация шага
-        double scale = SAFETY * std::min(
-            std::min(pow(q, sn), pow(q, vn)),
-            std::min(pow(q, rn), MAX_SCALE)
-        );
-        scale = std::clamp(scale, MIN_SCALE, MAX_SCALE);
-
-        if (V > 18.0 / pow(q, attempts) || Aprime > tolerance / pow(q, 2*attempts)) 
+        if (V > STABILITY_BOUND) 
         {
-            h *= scale;
+            h = std::max(hStab, MIN_SCALE * h);
             attempts++;
         } 
         else 
         {
+            // f(t + h, y_{n+1}) - первая стадия следующего шага
+            StoreDerivative(t + h, yNext, fNext);
+            acceptedStep = h;
             y = yNext;
-            h *= scale;
+            h = StepSizeController::Limit(h * controller.Accept(err, 2.0), hStab);
             stepAccepted = true;
         }
     }
@@ -90,7 +86,7 @@ void DISPDSolver::computeKTerms(
     std::vector<double>       &k2,
     std::vector<double>       &k3) 
 {
-    k1 = MultiplyScalarByVector(h, f(t, y));
+    k1 = MultiplyScalarByVector(h, Derivative(t, y));
     
     std::vector<double> y2 = AddVectors(y, MultiplyScalarByVector(2.0/3.0, k1));
     k2 = MultiplyScalarByVector(h, f(t, y2));
@@ -104,19 +100,24 @@ void DISPDSolver::computeKTerms(
 
 double DISPDSolver::computeAprime(
     std::vector<double> const &k1,
-    std::vector<double> const &k2) 
+    std::vector<double> const &k2,
+    std::vector<double> const &y,
+    double                     tolerance) 
 {
     std::vector<double> diff = SubtractVectors(k2, k1);
-    return (std::abs(1 - 6 * currentScheme.g) / 4.0) * Norm(diff);
+    return (std::abs(1 - 6 * currentScheme.g) / 4.0) * ErrorNorm(diff, y, y, tolerance);
 }
 
 double DISPDSolver::computeAddoublePrime(
     double                     h,
     std::vector<double> const &k1,
-    std::vector<double> const &yNext) 
+    std::vector<double> const &yNext,
+    std::vector<double> const &y,
+    std::vector<double> const &yNew,
+    double                     tolerance) 
 {
     std::vector<double> diff = SubtractVectors(MultiplyScalarByVector(h, yNext), k1);
-    return (std::abs(1 - 6 * currentScheme.g) / 6.0) * Norm(diff);
+    return (std::abs(1 - 6 * currentScheme.g) / 6.0) * ErrorNorm(diff, y, yNew, tolerance);
 }
 
 double DISPDSolver::computeV(
@@ -165,11 +166,13 @@ void DISPDSolver::Solve(
 {
     double t = t0;
     std::vector<double> y = y0;
-    double h = stepSize;
     storage.Add(t, y);
+    ResetDerivative();
+    controller.Reset();
+    double h = StartingStep(t, y, tEnd, tolerance, 1);
     switchScheme(false);  // Начинаем с алгоритма А
 
-    while (t < tEnd) 
+    while (t < tEnd && !storage.Stopped())
     {
         double hAttempt = std::min(h, tEnd - t);
         if (hAttempt < 1e-12) break;
@@ -177,8 +180,8 @@ void DISPDSolver::Solve(
         try 
         {
             Step(t, y, hAttempt, tolerance);
-            t += hAttempt;
-            storage.Add(t, y);
+            t = acceptedStep >= tEnd - t ? tEnd : t + acceptedStep;
+            AddPoint(storage, t, y);
             h = hAttempt;
         } 
         catch (const std::runtime_error&) 
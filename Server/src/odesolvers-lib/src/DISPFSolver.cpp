@@ -37,6 +37,9 @@ DISPFSolver::DISPFSolver(
         currentMethod = DISPFA;
     }
 
+    // Множитель шага: уменьшение после отказа в 1.1-2 раза, увеличение не более чем в 2 раза
+    controller.SetLimits(1.0, 0.5, 2.0);
+
     stabilityControlEnabled = (J == 0);
     if (stabilityControlEnabled)
         jacobianMethod = K;
@@ -46,6 +49,15 @@ void DISPFSolver::Step(
     std::vector <double> &y,
     double               &h,
     double                tolerance)
+{
+    Advance(t, y, h, tolerance);
+}
+
+void DISPFSolver::Advance(
+    double               &t,
+    std::vector <double> &y,
+    double               &h,
+    double                tolerance)
 {
     switch(currentMethod)
     {
@@ -60,6 +72,7 @@ void DISPFSolver::Step(
             break;
     }
 }
+
 void DISPFSolver::Solve(
     double                      t0,
     std::vector <double> const &y0,
@@ -68,28 +81,106 @@ void DISPFSolver::Solve(
     double                      tolerance)
 {
     double t = t0;
-    double h = stepSize;
     std::vector < double > y = y0;
+    double h = StartingStep(t, y, tEnd, tolerance, 4);
     vnBreakCount = 0;
     jumpToRadau5 = false;
+    controller.Reset();
 
-    k.resize(y.size(), std::vector < double > (6, 0.0));
+    k.assign(y.size(), std::vector < double > (6, 0.0));
     F.resize(y.size());
     Y0.resize(y.size());
     storage.Add(t, y);
 
-    while (t < tEnd)
+    // Схемы DISPFA и DISPFB используют k[][0] = h * f(t, y) с предыдущего шага
+    F = Derivative(t, y);
+    StoreDerivative(t, y, F);
+    for (size_t i = 0; i < y.size(); ++i)
+        k[i][0] = F[i] * h;
+
+    while (t < tEnd && !storage.Stopped())
     {
         if (t + h > tEnd)
+        {
+            double factor = (tEnd - t) / h;
             h = tEnd - t;
+            for (size_t i = 0; i < y.size(); ++i)
+                k[i][0] *= factor;
+        }
 
-        Step(t, y, h, tolerance);
+        // Методы шага сами увеличивают t на принятый шаг и затем меняют h
+        Advance(t, y, h, tolerance);
+        AddPoint(storage, t, y);
 
-        if (jumpToRadau5 && GAMMA != 0.0 && (tEnd - t) > h)
-            break;
-        
-        t += h;
+        if (jumpToRadau5 && GAMMA != 0.0 && t < tEnd && !storage.Stopped())
+            SolveStiff(t, y, h, tEnd, storage, tolerance);
+    }
+}
+
+void DISPFSolver::SolveStiff(
+    double              &t,
+    std::vector<double> &y,
+    double              &h,
+    double               tEnd,
+    Storage             &storage,
+    double               tolerance)
+{
+    if (!radau)
+    {
+        radau = std::make_unique<RadauIIASolver>(f, h);
+        radau->ShareDerivatives(jacobian, sparsity);
+        radau->SetTolerances(tolerances);
+    }
+    radau->Reset(t, y, h);
+
+    int steps = 0;
+    while (t < tEnd && !storage.Stopped())
+    {
+        radau->Advance(t, y, tEnd, tolerance);
         storage.Add(t, y);
+
+        // Задача перестала быть жёсткой: шаг Radau IIA устойчив и для явной схемы DISPFA
+        if (++steps % RADAU_CHECK_INTERVAL == 0 && t < tEnd)
+        {
+            double lambda_est = EstimateJacobianEigenvalue(t, y);
+            if (radau->CurrentStep() * lambda_est < GAMMA * 72.0)
+                break;
+        }
+    }
+
+    h = radau->CurrentStep();
+    currentMethod = variableOrder || fixedOrder == 1 ? DISPFA
+                  : fixedOrder == 2                  ? DISPFB
+                                                     : DISPFC;
+    vnBreakCount = 0;
+    jumpToRadau5 = false;
+
+    F = f(t, y);
+    StoreDerivative(t, y, F);
+    for (size_t i = 0; i < y.size(); ++i)
+        k[i][0] = F[i] * h;
+}
+
+void DISPFSolver::CheckStability(
+    double                     t,
+    std::vector<double> const &y,
+    double                     h,
+    double                     bound,
+    int                        breakLimit)
+{
+    if (!stabilityControlEnabled)
+        return;
+
+    double lambda_est = EstimateJacobianEigenvalue(t, y);
+    if (GAMMA != 0.0 && h * lambda_est >= GAMMA * bound)
+    {
+        vnBreakCount++;
+        if (vnBreakCount > breakLimit)
+            jumpToRadau5 = true;
+    }
+    else
+    {
+        vnBreakCount = 0;
     }
 }
 
@@ -110,6 +201,16 @@ double DISPFSolver::CalcVn(
     return Vn / 9.0;
 }
 
+double DISPFSolver::StableStep(
+    double h,
+    double Vn,
+    double bound) const
+{
+    if (Vn <= 0.0 || (variableOrder && currentMethod != DISPFA))
+        return 0.0;
+    return h * bound / Vn;
+}
+
 double DISPFSolver::StadScalar(
     size_t eqNum,
     int    stage)
@@ -128,20 +229,8 @@ double DISPFSolver::EstimateJacobianEigenvalue(
     std::vector<double> const &y)
 {
     size_t n = y.size();
-    std::vector < std::vector < double >> J(n, std::vector < double > (n, 0.0));
-    double eps = 1e-8;
-    std::vector < double > f0 = f(t, y);
-
-    for (size_t j = 0; j < n; j++)
-    {
-        std::vector < double > y_pert = y;
-        y_pert[j] += eps;
-        std::vector < double > f_pert = f(t, y_pert);
-        for (size_t i = 0; i < n; i++)
-        {
-            J[i][j] = (f_pert[i] - f0[i]) / eps;
-        }
-    }
+    // Точная матрица Якоби или сжатые конечные разности по раскраске столбцов
+    CsrMatrix const &J = JacobianCsr(t, y);
 
     if (jacobianMethod == 2)
     {
@@ -149,9 +238,9 @@ double DISPFSolver::EstimateJacobianEigenvalue(
         for (size_t i = 0; i < n; i++)
         {
             double row_max = 0.0;
-            for (size_t j = 0; j < n; j++)
+            for (size_t k = J.pattern.rowPtr[i]; k < J.pattern.rowPtr[i + 1]; k++)
             {
-                row_max = std::max(row_max, std::fabs(J[i][j]));
+                row_max = std::max(row_max, std::fabs(J.values[k]));
             }
             sum += row_max;
         }
@@ -165,14 +254,7 @@ double DISPFSolver::EstimateJacobianEigenvalue(
 
         for (int iter = 0; iter < 100; iter++)
         {
-            std::vector < double > y_vec(n, 0.0);
-            for (size_t i = 0; i < n; i++)
-            {
-                for (size_t j = 0; j < n; j++)
-                {
-                    y_vec[i] += J[i][j] * x[j];
-                }
-            }
+            std::vector < double > y_vec = J.Multiply(x);
 
             double norm = 0.0;
             for (double val: y_vec)
@@ -197,8 +279,9 @@ bool DISPFSolver::StepDISPFC(
     double               tolerance)
 {
     size_t n = y.size();
-    // Вычисляем f(t,y) и заполняем k[][0]
-    std::vector < double > ff = f(t, y);
+    ErrorWeights(y, tolerance, errorWeight);
+    // f(t,y) - сохранённая в конце предыдущего шага DISPFC
+    std::vector < double > ff = Derivative(t, y);
 
     for (size_t i = 0; i < n; ++i)
         k[i][0] = ff[i] * h;
@@ -222,7 +305,7 @@ bool DISPFSolver::StepDISPFC(
             double cn1 = 0.0;
             for (int j = 0; j < 6; ++j)
                 cn1 += (P36[j] - P4[j]) * k[i][j];
-            cn1 = std::fabs(cn1);
+            cn1 = std::fabs(cn1) * errorWeight[i];
             Cn1 = std::max(Cn1, cn1);
         }
 
@@ -230,8 +313,7 @@ bool DISPFSolver::StepDISPFC(
         // Если ошибка слишком велика, уменьшаем шаг (используем непрерывную корректировку)
         if (Cn1 > tolerance)
         {
-            double factor = std::pow(tolerance / Cn1, 1.0 / 5.0); // порядок ошибки 4 => 1/(4+1)=1/5
-            factor = std::min(0.9, std::max(0.5, factor));
+            double factor = controller.Reject(Cn1 / tolerance, 5.0); // порядок ошибки 4 => 1/(4+1)=1/5
             h *= factor;
             for (size_t i = 0; i < n; ++i)
                 k[i][0] *= factor;
@@ -251,36 +333,25 @@ bool DISPFSolver::StepDISPFC(
         t += h;
         // Оценка ошибки по разности f(t,y)*h и k[][0]
         ff = f(t, y);
+        StoreDerivative(t, y, ff);
         double An1 = 0.0;
         for (size_t i = 0; i < n; ++i)
         {
-            double diff = std::fabs(ff[i] * h - k[i][0]);
+            double diff = std::fabs(ff[i] * h - k[i][0]) * errorWeight[i];
             An1 = std::max(An1, diff);
         }
 
         An1 *= CA1B * d_coef;
         double Vn = CalcVn(k);
         // Контроль устойчивости (если включён)
-        if (stabilityControlEnabled)
-        {
-            double lambda_est = EstimateJacobianEigenvalue(t, y);
-            if (lambda_est != 0.0 && (h * lambda_est) / 72.0 < GAMMA)
-            {
-                vnBreakCount++;
-                if (vnBreakCount >= 35)
-                    jumpToRadau5 = true;
-            }
-            else
-            {
-                vnBreakCount = 0;
-            }
-        }
+        CheckStability(t, y, h, 3.6, 34);
 
         // Корректировка шага для следующего шага на основе ошибки An1
-        double factor = std::pow(tolerance / An1, 1.0 / 5.0);
-        // Ограничиваем коэффициент увеличения
-        factor = std::min(2.0, std::max(0.9, factor));
-        h *= factor;
+        h = StepSizeController::Limit(h * controller.Accept(An1 / tolerance, 5.0), StableStep(h, Vn, 3.6));
+
+        // k[][0] = h * f(t, y) для DISPFA/DISPFB при переключении метода
+        for (size_t i = 0; i < n; ++i)
+            k[i][0] = ff[i] * h;
 
         // Если порядок переменный, возможное переключение метода
         if (variableOrder && Vn > 3.6 && An1 <= tolerance)
@@ -299,6 +370,7 @@ bool DISPFSolver::StepDISPFA(
     double               tolerance)
 {
     size_t n = y.size();
+    ErrorWeights(y, tolerance, errorWeight);
     double An, An1, Vn;
 
     while (true)
@@ -314,14 +386,13 @@ bool DISPFSolver::StepDISPFA(
         // 2a. Вычисляем An
         An = 0.0;
         for (size_t i = 0; i < n; ++i)
-            An = std::max(An, std::fabs(k[i][1] - k[i][0]));
+            An = std::max(An, std::fabs(k[i][1] - k[i][0]) * errorWeight[i]);
 
         An *= CA1A;
         // Если ошибка слишком велика, уменьшаем шаг
         if (An > tolerance)
         {
-            double factor = std::pow(tolerance / An, 1.0 / 5.0);
-            factor = std::min(0.9, std::max(0.5, factor));
+            double factor = controller.Reject(An / tolerance, 5.0);
             h *= factor;
 
             for (size_t i = 0; i < n; ++i)
@@ -360,7 +431,7 @@ bool DISPFSolver::StepDISPFA(
     An1 = 0.0;
 
     for (size_t i = 0; i < n; ++i)
-        An1 = std::max(An1, std::fabs(f_end[i] * h - k[i][0]));
+        An1 = std::max(An1, std::fabs(f_end[i] * h - k[i][0]) * errorWeight[i]);
 
     An1 *= CA1A;
     // 9a. Оценка Vn
@@ -369,8 +440,7 @@ bool DISPFSolver::StepDISPFA(
     // Если ошибка слишком велика, уменьшаем шаг
     if (An1 > tolerance)
     {
-        double factor = std::pow(tolerance / An1, 1.0 / 5.0);
-        factor = std::min(0.9, std::max(0.5, factor));
+        double factor = controller.Reject(An1 / tolerance, 5.0);
         h *= factor;
         for (size_t i = 0; i < n; ++i)
             k[i][0] *= factor;
@@ -381,30 +451,16 @@ bool DISPFSolver::StepDISPFA(
     // 7a. Принимаем шаг
     t += h;
     y = Y0;
+    StoreDerivative(t, y, f_end);
     double Vn1 = CalcVn(k);
     double rn = (Vn1 != 0.0) ? Lnq * std::log(72.0 / Vn1) : MAXDOUBLE;
     // Корректировка шага для следующего шага
-    double factor = std::pow(tolerance / An1, 1.0 / 5.0);
-    factor = std::min(2.0, std::max(0.9, factor));
-    h *= factor;
+    h = StepSizeController::Limit(h * controller.Accept(An1 / tolerance, 5.0), StableStep(h, Vn1, 72.0));
 
     for (size_t i = 0; i < n; ++i)
         k[i][0] = f_end[i] * h;
 
-    if (stabilityControlEnabled)
-    {
-        double lambda_est = EstimateJacobianEigenvalue(t, y);
-        if (lambda_est != 0.0 && (h * lambda_est) / 72.0 < GAMMA)
-        {
-            vnBreakCount++;
-            if (vnBreakCount > 40)
-                jumpToRadau5 = true;
-        }
-        else
-        {
-            vnBreakCount = 0;
-        }
-    }
+    CheckStability(t, y, h, 72.0, 40);
 
     if (variableOrder && std::pow(q, std::min(Vn, rn)) * Vn1 < 28.5)
         currentMethod = DISPFB;
@@ -419,6 +475,7 @@ bool DISPFSolver::StepDISPFB(
     double               tolerance)
 {
     size_t n = y.size();
+    ErrorWeights(y, tolerance, errorWeight);
     double An, An1, Vn, Cn1;
     while (true)
     {
@@ -432,13 +489,12 @@ bool DISPFSolver::StepDISPFB(
 
         An = 0.0;
         for (size_t i = 0; i < n; ++i)
-            An = std::max(An, std::fabs(k[i][1] - k[i][0]));
+            An = std::max(An, std::fabs(k[i][1] - k[i][0]) * errorWeight[i]);
 
         An *= CA1B * d_coef;
         if (An > tolerance)
         {
-            double factor = std::pow(tolerance / An, 1.0 / 5.0);
-            factor = std::min(0.9, std::max(0.5, factor));
+            double factor = controller.Reject(An / tolerance, 5.0);
             h *= factor;
 
             for (size_t i = 0; i < n; ++i)
@@ -473,15 +529,14 @@ bool DISPFSolver::StepDISPFB(
     An1 = 0.0;
 
     for (size_t i = 0; i < n; ++i)
-        An1 = std::max(An1, std::fabs(f_end[i] * h - k[i][0]));
+        An1 = std::max(An1, std::fabs(f_end[i] * h - k[i][0]) * errorWeight[i]);
     An1 *= CA1B * d_coef;
 
     Vn = (An1 == 0.0) ? MAXDOUBLE : 0.5 * Lnq * std::log(tolerance / An1);
     
     if (An1 > tolerance)
     {
-        double factor = std::pow(tolerance / An1, 1.0 / 5.0);
-        factor = std::min(0.9, std::max(0.5, factor));
+        double factor = controller.Reject(An1 / tolerance, 5.0);
         h *= factor;
 
         for (size_t i = 0; i < n; ++i)
@@ -493,39 +548,25 @@ bool DISPFSolver::StepDISPFB(
     // 7a. Принимаем шаг
     t += h;
     y = Y0;
+    StoreDerivative(t, y, f_end);
     Cn1 = 0.0;
     for (size_t i = 0; i < n; ++i)
     {
         double cn1 = 0.0;
         for (int j = 0; j < 6; ++j)
             cn1 += (P36[j] - P4[j]) * k[i][j];
-        Cn1 = std::max(Cn1, std::fabs(cn1));
+        Cn1 = std::max(Cn1, std::fabs(cn1) * errorWeight[i]);
     }
 
     Cn1 *= 17.0 / 24.0;
     double Vn1 = CalcVn(k);
     double rn = (Vn1 != 0.0) ? Lnq * std::log(28.5 / Vn1) : MAXDOUBLE;
-    double factor = std::pow(tolerance / An1, 1.0 / 5.0);
-    factor = std::min(2.0, std::max(0.9, factor));
-    h *= factor;
+    h = StepSizeController::Limit(h * controller.Accept(An1 / tolerance, 5.0), StableStep(h, Vn1, 28.5));
 
     for (size_t i = 0; i < n; ++i)
         k[i][0] = f_end[i] * h;
 
-    if (stabilityControlEnabled)
-    {
-        double lambda_est = EstimateJacobianEigenvalue(t, y);
-        if (lambda_est != 0.0 && (h * lambda_est) / 28.5 < GAMMA)
-        {
-            vnBreakCount++;
-            if (vnBreakCount > 40)
-                jumpToRadau5 = true;
-        }
-        else
-        {
-            vnBreakCount = 0;
-        }
-    }
+    CheckStability(t, y, h, 28.5, 40);
 
     if (variableOrder)
     {
@@ -537,20 +578,5 @@ bool DISPFSolver::StepDISPFB(
         else if (qn1 <= 3.6 && std::pow(qn2, 6.0) * Cn1 <= tolerance)
             currentMethod = DISPFC;
     }
-
-    if (stabilityControlEnabled)
-    {
-        double lambda_est = EstimateJacobianEigenvalue(t, y);
-        if (lambda_est != 0.0 && (h * lambda_est) / 28.5 < GAMMA)
-        {
-            vnBreakCount++;
-            if (vnBreakCount > 40)
-                jumpToRadau5 = true;
-        }
-        else
-        {
-            vnBreakCount = 0;
-        }
-    }
     return true;
 }
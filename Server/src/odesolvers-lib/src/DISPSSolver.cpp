@@ -1,4 +1,5 @@
 #include "DISPSSolver.hpp"
+#include "DispsDesign.hpp"
 
 // Вспомогательные функции
 std::vector<double> DISPSSolver::Add(const std::vector<double>& a, const std::vector<double>& b) {
@@ -38,36 +39,62 @@ double DISPSSolver::Norm(const std::vector<double>& v) {
     return std::sqrt(sum);
 }
 
-// Конструктор
-DISPSSolver::DISPSSolver(std::function<std::vector<double>(double, const std::vector<double>&)> f,
-                         double initialStep,
-                         const DispsEnabledFlags& flags)
-    : f_(f), stepSize_(initialStep), currentIndex_(0)
-{
+double DISPSSolver::ErrorNorm(const std::vector<double>& diff,
+                              const std::vector<double>& yOld,
+                              const std::vector<double>& yNew,
+                              double tolerance) const {
+    if (!tolerances_.Componentwise())
+        return Norm(diff);
+    return tolerance * tolerances_.Norm(diff, yOld, yNew, tolerance);
+}
+
+// Коэффициенты вариантов
+std::vector<DispsVariant> DISPSSolver::Variants(const DispsEnabledFlags& flags) {
+    std::vector<DispsVariant> variants;
+
     if (flags.Disps13)
-        variants_.push_back({3, 1, {0.76561395265924, 0.2066991671971, 0.027686880143657}, 17.0});
+        variants.push_back({3, 1, {0.76561395265924, 0.2066991671971, 0.027686880143657}, 17.0});
 
     if (flags.Disps15)
-        variants_.push_back({5, 1, {0.49900087977418, 0.33439107198377, 0.15517028825608,
+        variants.push_back({5, 1, {0.49900087977418, 0.33439107198377, 0.15517028825608,
                                       0.011387362618405, 0.50397367568471e-4}, 46.8});
 
     if (flags.Disps23)
-        variants_.push_back({3, 2, {0.25, 0.461290700433682, 0.28870929566318}, 6.0});
+        variants.push_back({3, 2, {0.25, 0.461290700433682, 0.28870929566318}, 6.0});
 
     if (flags.Disps25)
-        variants_.push_back({5, 2, {0.25, 0.39269911064722, 0.2811818347201,
+        variants.push_back({5, 2, {0.25, 0.39269911064722, 0.2811818347201,
                                       0.06530730655278, 0.010811748097894}, 18.8});
 
     if (flags.Disps35)
-        variants_.push_back({5, 3, {1.0/6.0, -2.644193175547, 0.15929230363104,
+        variants.push_back({5, 3, {1.0/6.0, -2.644193175547, 0.15929230363104,
                                       3.1515675385826, 1.0/6.0}, 10.3});
 
     if (flags.Disps36)
-        variants_.push_back({6, 3, {1.0/6.0, -6.0414736520435, 0.12355552068869,
+        variants.push_back({6, 3, {1.0/6.0, -6.0414736520435, 0.12355552068869,
                                       0.18196838110013, 6.4026164169214, 1.0/6.0}, 15.68});
 
+    return variants;
+}
+
+// Конструктор
+DISPSSolver::DISPSSolver(std::function<std::vector<double>(double, const std::vector<double>&)> f,
+                         double initialStep,
+                         const DispsEnabledFlags& flags)
+    : f_(f), stepSize_(initialStep), variants_(Variants(flags)), currentIndex_(0)
+{
     if (variants_.empty())
         throw std::runtime_error("Нет включённых вариантов DISPS!");
+
+    for (const auto& variant : variants_) {
+        errorConstants_.push_back(std::max(std::fabs(DispsErrorConstant(variant.stages, variant.order, variant.p)), 1e-12));
+        // Номинальное gamma завышено относительно интервала полинома устойчивости с весами p
+        stabilityIntervals_.push_back(StabilityInterval(DispsStabilityPolynomial(variant.stages, variant.p)));
+
+        DispsUsage usage;
+        usage.name = "Disps" + std::to_string(variant.order) + std::to_string(variant.stages);
+        usage_.push_back(usage);
+    }
 }
 
 // Основной метод решения
@@ -78,69 +105,127 @@ std::vector<std::vector<double>> DISPSSolver::Solve(double t0,
 {
     std::vector<std::vector<double>> results;
     results.reserve(10000);
-    
+
+    Integrate(t0, y0, tEnd, tolerance, [&](double t, const std::vector<double>& y) {
+        // Терминальное событие заменяет точку шага точкой события
+        std::vector<double> row{ t };
+        row.insert(row.end(), y.begin(), y.end());
+        bool stopped = false;
+        if (results.empty()) {
+            if (events_)
+                events_->Start(t, y);
+            if (steadyState_)
+                steadyState_->Start(t, y);
+        } else {
+            double tPoint = t;
+            std::vector<double> yPoint = y;
+            if (events_ && events_->Check(tPoint, yPoint)) {
+                row = { tPoint };
+                row.insert(row.end(), yPoint.begin(), yPoint.end());
+                stopped = true;
+            }
+            if (!stopped && steadyState_)
+                stopped = steadyState_->Check(t, y);
+        }
+        results.push_back(row);
+        return stopped;
+    });
+
+    return results;
+}
+
+void DISPSSolver::Solve(double t0,
+                        const std::vector<double>& y0,
+                        double tEnd,
+                        Storage& storage,
+                        double tolerance)
+{
+    Integrate(t0, y0, tEnd, tolerance, [&](double t, const std::vector<double>& y) {
+        storage.Add(t, y);
+        return storage.Stopped();
+    });
+}
+
+void DISPSSolver::Integrate(double t0,
+                            const std::vector<double>& y0,
+                            double tEnd,
+                            double tolerance,
+                            const PointSink& sink)
+{
     double t = t0;
     std::vector<double> y = y0;
+    controller_.Reset();
+    for (auto& usage : usage_)
+        usage = DispsUsage{ usage.name };
+
+    // Главный член погрешности |C| (h / T)^(q+1): погрешность tolerance достигается
+    // при h = T (tolerance / |C|)^(1/(q+1)), T - масштаб времени решения
+    accuracyScales_.clear();
+    for (size_t i = 0; i < variants_.size(); i++)
+        accuracyScales_.push_back(std::pow(tolerance / errorConstants_[i], 1.0 / (variants_[i].order + 1)));
+    switchTimeScale_ = 0.0;
+    switches_ = 0;
+    stepsSinceSwitch_ = 0;
+    if (stepSize_ <= 0.0)
+        stepSize_ = EstimateInitialStep(f_, t, y, f_(t, y), tEnd, tolerance, variants_[currentIndex_].order, tolerances_);
     
-    {
-        std::vector<double> row;
-        row.push_back(t);
-        row.insert(row.end(), y.begin(), y.end());
-        results.push_back(row);
-    }
+    bool stopped = sink(t, y);
 
-    while (t < tEnd) {
+    while (t < tEnd && !stopped) {
         double hAttempt = std::min(stepSize_, tEnd - t);
         if (hAttempt < 1e-14)
             break;
 
         DispsVariant& variant = variants_[currentIndex_];
         bool stepAccepted = false;
+        bool switched = false;
 
         for (int tries = 0; tries < 30 && !stepAccepted; tries++) {
+            // Оценка погрешности известна после стадии k_{q+1}: обречённый шаг прекращается,
+            // не вычисляя остальных стадий (масштаб допусков по компонентам - по y)
+            auto check = [&](const std::vector<std::vector<double>>& stages) {
+                double Vn;
+                return ErrorEstimate(stages, y, y, tolerance, Vn) <= tolerance;
+            };
+
             std::vector<std::vector<double>> kStages;
-            std::vector<double> yNext = DoOneStep(t, y, hAttempt, variant, kStages);
+            std::vector<double> yNext = DoOneStep(t, y, hAttempt, variant, kStages, check);
+            bool aborted = yNext.empty();
+            usage_[currentIndex_].evaluations += aborted ? variant.order + 1 : variant.stages;
 
             bool needSwitch = false;
             double newH = hAttempt;
-            bool ok = false;
-
-            if (variant.order == 1)
-                ok = Control1stOrder(kStages, y, yNext, hAttempt, tolerance, newH, needSwitch);
-            else if (variant.order == 2)
-                ok = Control2ndOrder(kStages, y, yNext, hAttempt, tolerance, newH, needSwitch);
-            else
-                ok = Control3rdOrder(kStages, y, yNext, hAttempt, tolerance, newH, needSwitch);
+            bool ok = Control(kStages, y, aborted ? y : yNext, hAttempt, tolerance, newH, needSwitch);
 
             if (ok) {
                 stepAccepted = true;
+                usage_[currentIndex_].steps++;
+                stepsSinceSwitch_++;
                 t += hAttempt;
                 y = yNext;
                 stepSize_ = newH;
+                stopped = sink(t, y);
 
-                std::vector<double> row{ t };
-                row.insert(row.end(), y.begin(), y.end());
-                results.push_back(row);
-
-                if (needSwitch) {
-                    SwitchScheme(variant.order);
-                }
+                // Выход за границу устойчивости требует выбора схемы сразу
+                SwitchScheme(hAttempt, needSwitch);
             } else {
+                usage_[currentIndex_].rejected++;
                 if (variant.stages == 5 && variant.order == 2 && newH < hAttempt) {
-                    SwitchScheme(variant.order);
+                    // Шаг задаёт выбор схемы: уменьшенный после отказа или допустимый для новой схемы
+                    stepSize_ = newH;
+                    SwitchScheme(hAttempt, true);
+                    switched = true;
                     break;
                 }
                 hAttempt = newH;
             }
         }
 
-        if (!stepAccepted) {
+        if (!stepAccepted && !switched) {
             hAttempt = std::max(hAttempt * 0.5, 1e-10);
             stepSize_ = hAttempt;
         }
     }
-    
-    return results;
 }
 
 // Выполнение одного шага
@@ -148,14 +233,17 @@ std::vector<double> DISPSSolver::DoOneStep(double t,
                                            const std::vector<double>& y,
                                            double h,
                                            const DispsVariant& variant,
-                                           std::vector<std::vector<double>>& kStages)
+                                           std::vector<std::vector<double>>& kStages,
+                                           const StageCheck& check)
 {
+    // Оценка схемы порядка q использует стадии k1..k_{q+1}
+    int checkStage = variant.order + 1;
     if (variant.stages == 3)
-        return Step3Stage(t, y, h, f_, variant.p, kStages);
+        return Step3Stage(t, y, h, f_, variant.p, kStages, checkStage, check);
     else if (variant.stages == 5)
-        return Step5Stage(t, y, h, f_, variant.p, kStages);
+        return Step5Stage(t, y, h, f_, variant.p, kStages, checkStage, check);
     else if (variant.stages == 6)
-        return Step6Stage(t, y, h, f_, variant.p, kStages);
+        return Step6Stage(t, y, h, f_, variant.p, kStages, checkStage, check);
     else
         throw std::runtime_error("Неизвестное число стадий");
 }
@@ -166,7 +254,9 @@ std::vector<double> DISPSSolver::Step3Stage(double t,
                                             double h,
                                             std::function<std::vector<double>(double, const std::vector<double>&)> f,
                                             const std::vector<double>& p,
-                                            std::vector<std::vector<double>>& kStages)
+                                            std::vector<std::vector<double>>& kStages,
+                                            int checkStage,
+                                            const StageCheck& check)
 {
     kStages.clear();
     kStages.resize(3);
@@ -178,11 +268,15 @@ std::vector<double> DISPSSolver::Step3Stage(double t,
     std::vector<double> y2 = Add(y, Mul(2.0/3.0, k1));
     std::vector<double> k2 = Mul(h, f(t + 2.0/3.0 * h, y2));
     kStages[1] = k2;
+    if (checkStage == 2 && !check(kStages))
+        return {};
 
     std::vector<double> y3 = Add(y, Mul(1.0/3.0, k1));
     y3 = Add(y3, Mul(1.0/3.0, k2));
     std::vector<double> k3 = Mul(h, f(t + h, y3));
     kStages[2] = k3;
+    if (checkStage == 3 && !check(kStages))
+        return {};
 
     std::vector<double> yNext = Add(y, Mul(p[0], k1));
     yNext = Add(yNext, Mul(p[1], k2));
@@ -197,7 +291,9 @@ std::vector<double> DISPSSolver::Step5Stage(double t,
                                             double h,
                                             std::function<std::vector<double>(double, const std::vector<double>&)> f,
                                             const std::vector<double>& p,
-                                            std::vector<std::vector<double>>& kStages)
+                                            std::vector<std::vector<double>>& kStages,
+                                            int checkStage,
+                                            const StageCheck& check)
 {
     kStages.clear();
     kStages.resize(5);
@@ -208,16 +304,22 @@ std::vector<double> DISPSSolver::Step5Stage(double t,
     std::vector<double> y2 = Add(y, Mul(1.0/3.0, k1));
     std::vector<double> k2 = Mul(h, f(t + 1.0/3.0 * h, y2));
     kStages[1] = k2;
+    if (checkStage == 2 && !check(kStages))
+        return {};
 
     std::vector<double> y3 = Add(y, Mul(1.0/6.0, k1));
     y3 = Add(y3, Mul(1.0/6.0, k2));
     std::vector<double> k3 = Mul(h, f(t + 1.0/2.0 * h, y3));
     kStages[2] = k3;
+    if (checkStage == 3 && !check(kStages))
+        return {};
 
     std::vector<double> y4 = Add(y, Mul(1.0/8.0, k1));
     y4 = Add(y4, Mul(1.0/8.0, k3));
     std::vector<double> k4 = Mul(h, f(t + 3.0/4.0 * h, y4));
     kStages[3] = k4;
+    if (checkStage == 4 && !check(kStages))
+        return {};
 
     std::vector<double> y5 = Add(y, Mul(1.0/2.0, k1));
     y5 = Add(y5, Mul(-3.0/2.0, k3));
@@ -240,7 +342,9 @@ std::vector<double> DISPSSolver::Step6Stage(double t,
                                             double h,
                                             std::function<std::vector<double>(double, const std::vector<double>&)> f,
                                             const std::vector<double>& p,
-                                            std::vector<std::vector<double>>& kStages)
+                                            std::vector<std::vector<double>>& kStages,
+                                            int checkStage,
+                                            const StageCheck& check)
 {
     kStages.clear();
     kStages.resize(6);
@@ -251,14 +355,20 @@ std::vector<double> DISPSSolver::Step6Stage(double t,
     std::vector<double> y2 = Add(y, Mul(0.5, k1));
     std::vector<double> k2 = Mul(h, f(t + 0.5 * h, y2));
     kStages[1] = k2;
+    if (checkStage == 2 && !check(kStages))
+        return {};
 
     std::vector<double> y3 = Add(y, Mul(0.5, k2));
     std::vector<double> k3 = Mul(h, f(t + 0.5 * h, y3));
     kStages[2] = k3;
+    if (checkStage == 3 && !check(kStages))
+        return {};
 
     std::vector<double> y4 = Add(y, Mul(0.5, k3));
     std::vector<double> k4 = Mul(h, f(t + 0.5 * h, y4));
     kStages[3] = k4;
+    if (checkStage == 4 && !check(kStages))
+        return {};
 
     std::vector<double> y5 = Add(y, Mul(0.497828275994247056, k1));
     y5 = Add(y5, Mul(0.002171724005752944, k4));
@@ -279,128 +389,129 @@ std::vector<double> DISPSSolver::Step6Stage(double t,
     return yNext;
 }
 
-// Контроль 1-го порядка
-bool DISPSSolver::Control1stOrder(const std::vector<std::vector<double>>& kStages,
-                                  const std::vector<double>&,
-                                  const std::vector<double>&,
-                                  double h,
+double DISPSSolver::ErrorEstimate(const std::vector<std::vector<double>>& kStages,
+                                  const std::vector<double>& yOld,
+                                  const std::vector<double>& yNew,
                                   double tolerance,
-                                  double& newH,
-                                  bool& needSwitch)
+                                  double& Vn) const
 {
     const double eps = 1e-15;
-    const auto& variant = variants_[currentIndex_];
+    int order = variants_[currentIndex_].order;
 
     double k1_norm = Norm(kStages[0]);
     double k2_norm = Norm(kStages[1]);
-    double delta11 = (2.0 * std::fabs(1.0 - 2.0 * k1_norm)) / (k2_norm + eps);
-
-    std::vector<double> diff = Subtract(kStages[1], kStages[0]);
-    double A_prime = delta11 * Norm(diff);
-
-    double Vn = (Norm(diff) * Norm(diff)) / ((k2_norm + eps) * (Norm(diff) + eps));
-    needSwitch = (Vn > variant.gamma);
+    double coefficient;
+    if (order == 1)
+        coefficient = (2.0 * std::fabs(1.0 - 2.0 * k1_norm)) / (k2_norm + eps);  // delta11 в A'
+    else if (order == 2)
+        coefficient = std::fabs(1.0 - 4.0 * k1_norm);                          // delta11 в B'
+    else
+        coefficient = std::fabs((1.0 - 2.0 * k1_norm) / (2.0 * k2_norm + eps)); // g_n1 в C'
 
-    double q = 0.8;
-    if (A_prime > tolerance) {
-        newH = h * q * std::pow(tolerance / (A_prime + eps), 0.5);
-        return false;
-    }
+    // Разность двух последних стадий оценки: k2 - k1, k3 - k2, k4 - k3
+    std::vector<double> diff = Subtract(kStages[order], kStages[order - 1]);
+    double diff_norm = Norm(diff);
+    Vn = (diff_norm * diff_norm) / ((Norm(kStages[order]) + eps) * (diff_norm + eps));
 
-    newH = h * 1.2;
-    return true;
+    return coefficient * ErrorNorm(diff, yOld, yNew, tolerance);
 }
 
-// Контроль 2-го порядка
-bool DISPSSolver::Control2ndOrder(const std::vector<std::vector<double>>& kStages,
-                                  const std::vector<double>&,
-                                  const std::vector<double>&,
-                                  double h,
-                                  double tolerance,
-                                  double& newH,
-                                  bool& needSwitch)
+bool DISPSSolver::Control(const std::vector<std::vector<double>>& kStages,
+                          const std::vector<double>& yOld,
+                          const std::vector<double>& yNew,
+                          double h,
+                          double tolerance,
+                          double& newH,
+                          bool& needSwitch)
 {
-    const double eps = 1e-15;
     const auto& variant = variants_[currentIndex_];
-
-    double k1_norm = Norm(kStages[0]);
-    double delta11 = 1.0 - 4.0 * k1_norm;
-
-    std::vector<double> diff = Subtract(kStages[2], kStages[1]);
-    double B_prime = delta11 * Norm(diff);
-
-    double k3_norm = Norm(kStages[2]);
-    double Vn = (Norm(diff) * Norm(diff)) / ((k3_norm + eps) * (Norm(diff) + eps));
-    needSwitch = (Vn > variant.gamma);
-
-    double q = (variant.stages == 5 && variant.order == 2) ? 0.4 : 0.8;
-    if (B_prime > tolerance) {
-        newH = h * q * std::pow(tolerance / (B_prime + eps), 1.0/3.0);
-        if (variant.stages == 5 && variant.order == 2)
+    double k = variant.order + 1.0;
+
+    double Vn;
+    double error = ErrorEstimate(kStages, yOld, yNew, tolerance, Vn);
+    needSwitch = (Vn > stabilityIntervals_[currentIndex_]);
+    lastError_ = error / tolerance;
+    lastVn_ = Vn;
+
+    if (error > tolerance) {
+        newH = h * controller_.Reject(error / tolerance, k);
+        if (variant.stages == 5 && variant.order == 2) {
+            // Отказ пятистадийной схемы второго порядка - переход к другой схеме с вдвое меньшим шагом
+            newH *= 0.5;
             needSwitch = true;
+        }
         return false;
     }
 
-    newH = h * 1.1;
+    newH = AcceptedStep(h, error / tolerance, k, Vn, needSwitch);
     return true;
 }
 
-// Контроль 3-го порядка
-bool DISPSSolver::Control3rdOrder(const std::vector<std::vector<double>>& kStages,
-                                  const std::vector<double>&,
-                                  const std::vector<double>&,
-                                  double h,
-                                  double tolerance,
-                                  double& newH,
-                                  bool& needSwitch)
+double DISPSSolver::AcceptedStep(double h, double err, double k, double Vn, bool needSwitch)
 {
-    const double eps = 1e-15;
-    const auto& variant = variants_[currentIndex_];
+    // Рост шага за шаг ограничен тем сильнее, чем выше порядок схемы
+    controller_.SetLimits(SAFETY, FAC_MIN, GROWTH[variants_[currentIndex_].order - 1]);
+    double newH = h * controller_.Accept(err, k);
 
-    double k1_norm = Norm(kStages[0]);
-    double k2_norm = Norm(kStages[1]);
-    double g_n1 = (1.0 - 2.0 * k1_norm) / (2.0 * k2_norm + eps);
+    // Шаг остаётся в области устойчивости текущей схемы: V_n растёт пропорционально h.
+    // При выходе за границу схема сменится, и ограничение по её интервалу неприменимо
+    if (!needSwitch && Vn > 0.0)
+        newH = StepSizeController::Limit(newH, h * stabilityIntervals_[currentIndex_] / Vn);
 
-    std::vector<double> diff = Subtract(kStages[3], kStages[2]);
-    double C_prime = g_n1 * Norm(diff);
+    return newH;
+}
 
-    double k4_norm = Norm(kStages[3]);
-    double Vn = (Norm(diff) * Norm(diff)) / ((k4_norm + eps) * (Norm(diff) + eps));
-    needSwitch = (Vn > variant.gamma);
+double DISPSSolver::PredictedStep(size_t index, double h, double timeScale) const {
+    double hAccuracy = accuracyScales_[index] * timeScale;
 
-    double q = 0.8;
-    if (C_prime > tolerance) {
-        newH = h * q * std::pow(tolerance / (C_prime + eps), 0.25);
-        return false;
-    }
+    // V_n растёт пропорционально h: граница устойчивости варианта достигается при h * interval / V_n
+    double hStability = lastVn_ > 0.0 ? h * stabilityIntervals_[index] / lastVn_ : hAccuracy;
 
-    newH = h * 1.05;
-    return true;
+    return SAFETY * std::min(hAccuracy, hStability);
 }
 
-void DISPSSolver::SwitchScheme(int currentOrder) {
-    int bestIndex = currentIndex_;
-    int bestOrder = variants_[currentIndex_].order;
-    double bestGamma = variants_[currentIndex_].gamma;
+void DISPSSolver::SwitchScheme(double h, bool forced) {
+    // Шаг по точности текущей схемы (погрешность tolerance при h * err^(-1/(p+1))) задаёт масштаб
+    // времени решения. Оценки погрешности схем разного порядка согласованы с моделью лишь
+    // приближённо, поэтому через SWITCH_HOLD шагов после смены масштаб шага новой схемы
+    // калибруется по масштабу времени, с которым её выбрали
+    double err = std::max(lastError_, 1e-10);
+    double hAccuracy = h * std::pow(err, -1.0 / (variants_[currentIndex_].order + 1));
+    if (switchTimeScale_ > 0.0 && stepsSinceSwitch_ >= SWITCH_HOLD) {
+        accuracyScales_[currentIndex_] = hAccuracy / switchTimeScale_;
+        switchTimeScale_ = 0.0;
+    }
+    double timeScale = hAccuracy / accuracyScales_[currentIndex_];
+
+    if (!forced && (variants_.size() < 2 || stepsSinceSwitch_ < SWITCH_HOLD))
+        return;
 
+    // Стоимость единицы времени: число стадий на допустимый шаг
+    std::vector<double> steps(variants_.size());
+    std::vector<double> costs(variants_.size());
+    size_t best = 0;
     for (size_t i = 0; i < variants_.size(); i++) {
-        if (static_cast<int>(i) == currentIndex_)
-            continue;
-
-        int candidateOrder = variants_[i].order;
-        double candidateGamma = variants_[i].gamma;
-
-        if (candidateOrder > bestOrder) {
-            bestOrder = candidateOrder;
-            bestGamma = candidateGamma;
-            bestIndex = static_cast<int>(i);
-        } else if (candidateOrder == bestOrder && candidateGamma < bestGamma) {
-            bestGamma = candidateGamma;
-            bestIndex = static_cast<int>(i);
-        }
+        steps[i] = PredictedStep(i, h, timeScale);
+        costs[i] = variants_[i].stages / steps[i];
+        if (costs[i] < costs[best])
+            best = i;
     }
 
-    if (bestIndex != currentIndex_) {
-        currentIndex_ = bestIndex;
+    size_t current = static_cast<size_t>(currentIndex_);
+    if (best == current) {
+        // Текущая схема остаётся и после выхода за границу устойчивости: шаг возвращается в её область
+        if (forced)
+            stepSize_ = std::min(stepSize_, steps[current]);
+        return;
     }
+    if (!forced && costs[best] >= SWITCH_GAIN * costs[current])
+        return;
+
+    // Шаг новой схемы - допустимый для неё шаг, рост ограничен SWITCH_GROWTH
+    currentIndex_ = static_cast<int>(best);
+    stepSize_ = std::clamp(steps[best], FAC_MIN * h, SWITCH_GROWTH * h);
+    controller_.Reset();
+    stepsSinceSwitch_ = 0;
+    switchTimeScale_ = timeScale;
+    switches_++;
 }
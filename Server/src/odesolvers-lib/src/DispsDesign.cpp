@@ -0,0 +1,522 @@
+#include "../include/DispsDesign.hpp"
+#include "../include/ComputePool.hpp"
+#include "../include/LinearAlgebra.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    constexpr double START_RADIUS = 1.0;   // Разброс стартовых точек (относительно полинома Чебышёва)
+    constexpr int    MAX_EVALS    = 400;   // Вычислений на одну переменную в методе Нелдера-Мида
+    constexpr int    RESTARTS     = 4;
+
+    double Dot(
+        std::vector<double> const &a,
+        std::vector<double> const &b)
+    {
+        double sum = 0.0;
+        for (size_t i = 0; i < a.size(); ++i)
+            sum += a[i] * b[i];
+        return sum;
+    }
+
+    // Полиномы g_i(z) стадий: k_i = z g_i(z) при y' = lambda y, y = 1, z = h lambda
+    std::vector<std::vector<double>> StagePolynomials(int stages)
+    {
+        auto A = DispsStageMatrix(stages);
+        std::vector<std::vector<double>> g(stages, std::vector<double>(stages, 0.0));
+        for (int i = 0; i < stages; ++i)
+        {
+            g[i][0] = 1.0;
+            for (int j = 0; j < i; ++j)
+            {
+                if (A[i][j] == 0.0)
+                    continue;
+                for (int k = 0; k + 1 < stages; ++k)
+                    g[i][k + 1] += A[i][j] * g[j][k];
+            }
+        }
+        return g;
+    }
+
+    double Evaluate(
+        std::vector<double> const &poly,
+        double                     x)
+    {
+        double value = 0.0;
+        for (size_t k = poly.size(); k-- > 0;)
+            value = value * x + poly[k];
+        return value;
+    }
+
+    // Вещественные корни полинома на [a, b] по возрастанию: корни производной делят отрезок
+    // на участки монотонности, на каждом корень ищется делением пополам
+    std::vector<double> RealRoots(
+        std::vector<double> poly,
+        double              a,
+        double              b)
+    {
+        while (poly.size() > 1 && poly.back() == 0.0)
+            poly.pop_back();
+
+        std::vector<double> roots;
+        if (poly.size() < 2)
+            return roots;
+
+        std::vector<double> derivative(poly.size() - 1);
+        for (size_t k = 1; k < poly.size(); ++k)
+            derivative[k - 1] = k * poly[k];
+
+        std::vector<double> points{ a };
+        for (double x : RealRoots(derivative, a, b))
+            points.push_back(x);
+        points.push_back(b);
+
+        for (size_t k = 0; k + 1 < points.size(); ++k)
+        {
+            double left = points[k], right = points[k + 1];
+            double fLeft = Evaluate(poly, left), fRight = Evaluate(poly, right);
+            if (fLeft == 0.0)
+            {
+                if (roots.empty() || roots.back() < left)
+                    roots.push_back(left);
+                continue;
+            }
+            if ((fLeft < 0.0) == (fRight < 0.0))
+                continue;
+            for (int iter = 0; iter < 100 && right - left > 1e-14 * std::max(1.0, std::fabs(right)); ++iter)
+            {
+                double middle = 0.5 * (left + right);
+                if ((Evaluate(poly, middle) < 0.0) == (fLeft < 0.0))
+                    left = middle;
+                else
+                    right = middle;
+            }
+            roots.push_back(0.5 * (left + right));
+        }
+        return roots;
+    }
+
+    // Минимизация по методу Нелдера-Мида, x - начальная точка и результат
+    double NelderMead(
+        std::function<double(std::vector<double> const &)> const &objective,
+        std::vector<double>                                       &x,
+        double                                                     size)
+    {
+        size_t d = x.size();
+        std::vector<std::vector<double>> simplex(d + 1, x);
+        std::vector<double> values(d + 1);
+        for (size_t i = 0; i < d; ++i)
+            simplex[i + 1][i] += size;
+        for (size_t i = 0; i <= d; ++i)
+            values[i] = objective(simplex[i]);
+
+        int evals = static_cast<int>(d + 1);
+        std::vector<double> centroid(d), trial(d), expanded(d);
+        auto along = [&](double factor, std::vector<double> const &worst, std::vector<double> &out)
+        {
+            for (size_t i = 0; i < d; ++i)
+                out[i] = centroid[i] + factor * (worst[i] - centroid[i]);
+        };
+
+        while (evals < MAX_EVALS * static_cast<int>(d))
+        {
+            std::vector<size_t> order(d + 1);
+            for (size_t i = 0; i <= d; ++i)
+                order[i] = i;
+            std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return values[a] < values[b]; });
+            size_t best = order[0], worst = order[d], second = order[d - 1];
+
+            if (values[worst] - values[best] < 1e-9 * (1.0 + std::fabs(values[best])))
+                break;
+
+            std::fill(centroid.begin(), centroid.end(), 0.0);
+            for (size_t i = 0; i <= d; ++i)
+                if (i != worst)
+                    for (size_t k = 0; k < d; ++k)
+                        centroid[k] += simplex[i][k] / d;
+
+            along(-1.0, simplex[worst], trial);
+            double fTrial = objective(trial);
+            ++evals;
+
+            if (fTrial < values[best])
+            {
+                along(-2.0, simplex[worst], expanded);
+                double fExpanded = objective(expanded);
+                ++evals;
+                if (fExpanded < fTrial)
+                {
+                    simplex[worst] = expanded;
+                    values[worst] = fExpanded;
+                }
+                else
+                {
+                    simplex[worst] = trial;
+                    values[worst] = fTrial;
+                }
+                continue;
+            }
+            if (fTrial < values[second])
+            {
+                simplex[worst] = trial;
+                values[worst] = fTrial;
+                continue;
+            }
+
+            // Сжатие к лучшей из точек: отражённой или худшей
+            along(fTrial < values[worst] ? -0.5 : 0.5, simplex[worst], expanded);
+            double fContracted = objective(expanded);
+            ++evals;
+            if (fContracted < std::min(fTrial, values[worst]))
+            {
+                simplex[worst] = expanded;
+                values[worst] = fContracted;
+                continue;
+            }
+
+            // Сокращение симплекса к лучшей вершине
+            for (size_t i = 0; i <= d; ++i)
+            {
+                if (i == best)
+                    continue;
+                for (size_t k = 0; k < d; ++k)
+                    simplex[i][k] = simplex[best][k] + 0.5 * (simplex[i][k] - simplex[best][k]);
+                values[i] = objective(simplex[i]);
+                ++evals;
+            }
+        }
+
+        size_t best = std::min_element(values.begin(), values.end()) - values.begin();
+        x = simplex[best];
+        return values[best];
+    }
+}
+
+std::vector<std::vector<double>> DispsStageMatrix(int stages)
+{
+    switch (stages)
+    {
+    case 3:
+        return { {},
+                 { 2.0 / 3.0 },
+                 { 1.0 / 3.0, 1.0 / 3.0 } };
+    case 5:
+        return { {},
+                 { 1.0 / 3.0 },
+                 { 1.0 / 6.0, 1.0 / 6.0 },
+                 { 1.0 / 8.0, 0.0, 1.0 / 8.0 },
+                 { 0.5, 0.0, -1.5, 2.0 } };
+    case 6:
+        return { {},
+                 { 0.5 },
+                 { 0.0, 0.5 },
+                 { 0.0, 0.0, 0.5 },
+                 { 0.497828275994247056, 0.0, 0.0, 0.002171724005752944 },
+                 { 0.0, 0.0, 0.0, 0.0, 1.0 } };
+    default:
+        throw std::runtime_error("DISPS schemes have 3, 5 or 6 stages, got " + std::to_string(stages));
+    }
+}
+
+std::vector<double> DispsStabilityPolynomial(
+    int                        stages,
+    std::vector<double> const &p)
+{
+    if (p.size() != static_cast<size_t>(stages))
+        throw std::runtime_error("DispsStabilityPolynomial: expected " + std::to_string(stages) + " weights");
+
+    auto g = StagePolynomials(stages);
+    std::vector<double> poly(stages + 1, 0.0);
+    poly[0] = 1.0;
+    for (int i = 0; i < stages; ++i)
+        for (int k = 0; k < stages; ++k)
+            poly[k + 1] += p[i] * g[i][k];
+    return poly;
+}
+
+double DispsErrorConstant(
+    int                        stages,
+    int                        order,
+    std::vector<double> const &p)
+{
+    auto poly = DispsStabilityPolynomial(stages, p);
+    double factorial = std::tgamma(order + 2.0);
+    double coefficient = order + 1 < static_cast<int>(poly.size()) ? poly[order + 1] : 0.0;
+    return coefficient - 1.0 / factorial;
+}
+
+double StabilityInterval(
+    std::vector<double> const &poly,
+    double                     damping)
+{
+    // Q(x) = R(-x), x >= 0
+    std::vector<double> Q(poly);
+    for (size_t k = 1; k < Q.size(); k += 2)
+        Q[k] = -Q[k];
+
+    // Интервал полинома степени s не длиннее 2 s^2 (полином Чебышёва)
+    double degree = static_cast<double>(Q.size() - 1);
+    double limit = 2.0 * degree * degree + 1.0;
+    double const start = 1e-9; // Корень Q(x) - 1 в нуле не учитывается
+
+    auto shifted = [&Q](double level)
+    {
+        std::vector<double> result(Q);
+        result[0] -= level;
+        return result;
+    };
+    auto firstRoot = [&](double level, double from)
+    {
+        auto roots = RealRoots(shifted(level), from, limit);
+        return roots.empty() ? limit : roots.front();
+    };
+
+    double bound = 1.0;
+    double from = start;
+    if (damping > 0.0)
+    {
+        // До первого спуска R до 1 - damping достаточно |R| <= 1
+        double drop = firstRoot(1.0 - damping, start);
+        double exceed = firstRoot(1.0, start);
+        if (exceed < drop)
+            return exceed;
+        bound = 1.0 - damping;
+        from = drop + start;
+    }
+    return std::min(firstRoot(bound, from), firstRoot(-bound, from));
+}
+
+DispsDesignResult DesignDisps(DispsDesignOptions const &options)
+{
+    int s = options.stages;
+    int q = options.order;
+    if (q < 1 || q > 3)
+        throw std::runtime_error("DISPS design supports order 1 to 3, got " + std::to_string(q));
+
+    auto A = DispsStageMatrix(s);
+    auto g = StagePolynomials(s);
+    std::vector<double> c(s, 0.0), Ac(s, 0.0);
+    for (int i = 0; i < s; ++i)
+        for (int j = 0; j < i; ++j)
+            c[i] += A[i][j];
+    for (int i = 0; i < s; ++i)
+        for (int j = 0; j < i; ++j)
+            Ac[i] += A[i][j] * c[j];
+
+    // Линейные условия на p: порядок и константа погрешности
+    std::vector<std::vector<double>> rows;
+    std::vector<double> rhs;
+    rows.push_back(std::vector<double>(s, 1.0));
+    rhs.push_back(1.0);
+    if (q >= 2)
+    {
+        rows.push_back(c);
+        rhs.push_back(0.5);
+    }
+    if (q >= 3)
+    {
+        std::vector<double> c2(s);
+        for (int i = 0; i < s; ++i)
+            c2[i] = c[i] * c[i];
+        rows.push_back(c2);
+        rhs.push_back(1.0 / 3.0);
+        rows.push_back(Ac);
+        rhs.push_back(1.0 / 6.0);
+    }
+    if (options.matchError)
+    {
+        std::vector<double> row(s);
+        for (int i = 0; i < s; ++i)
+            row[i] = q < s ? g[i][q] : 0.0;
+        rows.push_back(row);
+        rhs.push_back(options.errorConstant + 1.0 / std::tgamma(q + 2.0));
+    }
+
+    // Переменные поиска v: r_{k+1} = sigma_k v_k, где sigma_k - коэффициенты сдвинутого
+    // полинома Чебышёва T_s(1 + z / s^2) (оптимального для первого порядка). Коэффициенты R
+    // различаются на порядки, а в переменных v они одного масштаба; v = 1 - сам полином Чебышёва.
+    // p = T v, T = G^{-1} diag(sigma), G[k][i] - коэффициент при z^k полинома g_i
+    std::vector<double> sigma(s);
+    double product = 1.0;
+    for (int k = 0; k < s; ++k)
+    {
+        product *= (static_cast<double>(s) * s - static_cast<double>(k) * k) / ((2.0 * k + 1.0) * s * s);
+        sigma[k] = product / std::tgamma(k + 2.0);
+    }
+
+    std::vector<double> G(s * s);
+    for (int k = 0; k < s; ++k)
+        for (int i = 0; i < s; ++i)
+            G[k * s + i] = g[i][k];
+    DenseLU<double> lu;
+    if (!lu.Factorize(G, s))
+        throw std::runtime_error("DISPS design: stage polynomials are linearly dependent");
+
+    std::vector<std::vector<double>> T(s, std::vector<double>(s));
+    for (int j = 0; j < s; ++j)
+    {
+        std::vector<double> column(s, 0.0);
+        column[j] = sigma[j];
+        lu.Solve(column);
+        for (int i = 0; i < s; ++i)
+            T[i][j] = column[i];
+    }
+
+    // Условия в переменных v, ортонормированные процессом Грама-Шмидта
+    std::vector<std::vector<double>> Q;
+    std::vector<double> rho;
+    for (size_t k = 0; k < rows.size(); ++k)
+    {
+        std::vector<double> row(s, 0.0);
+        for (int j = 0; j < s; ++j)
+            for (int i = 0; i < s; ++i)
+                row[j] += rows[k][i] * T[i][j];
+        double value = rhs[k];
+        for (size_t j = 0; j < Q.size(); ++j)
+        {
+            double dot = Dot(row, Q[j]);
+            for (int i = 0; i < s; ++i)
+                row[i] -= dot * Q[j][i];
+            value -= dot * rho[j];
+        }
+        double norm = std::sqrt(Dot(row, row));
+        if (norm < 1e-10)
+        {
+            if (std::fabs(value) > 1e-10)
+                throw std::runtime_error("DISPS design: order and error conditions are inconsistent for this stage tableau");
+            continue;
+        }
+        for (int i = 0; i < s; ++i)
+            row[i] /= norm;
+        Q.push_back(row);
+        rho.push_back(value / norm);
+    }
+
+    // v0 - ближайшая к полиному Чебышёва точка, удовлетворяющая условиям
+    std::vector<double> v0(s, 1.0);
+    for (size_t j = 0; j < Q.size(); ++j)
+    {
+        double residual = Dot(v0, Q[j]) - rho[j];
+        for (int i = 0; i < s; ++i)
+            v0[i] -= residual * Q[j][i];
+    }
+
+    // Базис нуль-пространства условий
+    std::vector<std::vector<double>> basis;
+    std::vector<std::vector<double>> all = Q;
+    for (int e = 0; e < s && all.size() < static_cast<size_t>(s); ++e)
+    {
+        std::vector<double> v(s, 0.0);
+        v[e] = 1.0;
+        for (auto const &u : all)
+        {
+            double dot = Dot(v, u);
+            for (int i = 0; i < s; ++i)
+                v[i] -= dot * u[i];
+        }
+        double norm = std::sqrt(Dot(v, v));
+        if (norm < 1e-8)
+            continue;
+        for (int i = 0; i < s; ++i)
+            v[i] /= norm;
+        basis.push_back(v);
+        all.push_back(v);
+    }
+
+    auto weights = [&](std::vector<double> const &u)
+    {
+        std::vector<double> v = v0;
+        for (size_t j = 0; j < basis.size(); ++j)
+            for (int i = 0; i < s; ++i)
+                v[i] += u[j] * basis[j][i];
+        std::vector<double> p(s, 0.0);
+        for (int i = 0; i < s; ++i)
+            for (int j = 0; j < s; ++j)
+                p[i] += T[i][j] * v[j];
+        return p;
+    };
+    auto objective = [&](std::vector<double> const &u)
+    {
+        return -StabilityInterval(DispsStabilityPolynomial(s, weights(u)), options.damping);
+    };
+
+    // Начальные точки: полином Чебышёва, существующие варианты с тем же числом стадий
+    // и порядком (проекция на условия), остальные - случайные со всё большим разбросом
+    std::vector<std::vector<double>> seeds(1, std::vector<double>(basis.size(), 0.0));
+    DispsEnabledFlags allVariants{true, true, true, true, true, true};
+    for (auto const &variant : DISPSSolver::Variants(allVariants))
+    {
+        if (variant.stages != s || variant.order != q || basis.empty())
+            continue;
+        // v = diag(1 / sigma) G p
+        std::vector<double> v(s, 0.0);
+        for (int k = 0; k < s; ++k)
+        {
+            for (int i = 0; i < s; ++i)
+                v[k] += G[k * s + i] * variant.p[i];
+            v[k] /= sigma[k];
+        }
+        std::vector<double> u(basis.size());
+        for (size_t j = 0; j < basis.size(); ++j)
+            for (int i = 0; i < s; ++i)
+                u[j] += (v[i] - v0[i]) * basis[j][i];
+        seeds.push_back(u);
+    }
+
+    std::vector<double> best(basis.size(), 0.0);
+    if (!basis.empty())
+    {
+        size_t starts = std::max<size_t>(options.starts, seeds.size());
+        std::vector<std::vector<double>> points(starts);
+        std::vector<double> values(starts);
+        ComputePool::Instance().ParallelFor(starts, [&](size_t k)
+        {
+            std::vector<double> u(basis.size());
+            if (k < seeds.size())
+            {
+                u = seeds[k];
+            }
+            else
+            {
+                double radius = START_RADIUS * (1.0 + 4.0 * k / starts);
+                std::mt19937 generator(options.seed + static_cast<unsigned>(k));
+                std::uniform_real_distribution<double> uniform(-radius, radius);
+                for (double &x : u)
+                    x = uniform(generator);
+            }
+
+            // Перезапуски с исходным размером симплекса: метод Нелдера-Мида
+            // часто останавливается на разрывах gamma(p)
+            double value = NelderMead(objective, u, 0.2);
+            for (int restart = 0; restart < RESTARTS; ++restart)
+            {
+                double next = NelderMead(objective, u, 0.2);
+                if (next >= value)
+                    break;
+                value = next;
+            }
+            values[k] = value;
+            points[k] = u;
+        });
+
+        size_t winner = std::min_element(values.begin(), values.end()) - values.begin();
+        best = points[winner];
+        NelderMead(objective, best, 0.02);
+    }
+
+    DispsDesignResult result;
+    result.variant.stages = s;
+    result.variant.order = q;
+    result.variant.p = weights(best);
+    // Интервал с запасом: округление вниз до сотых
+    double gamma = StabilityInterval(DispsStabilityPolynomial(s, result.variant.p), options.damping);
+    result.variant.gamma = std::floor(gamma * 100.0) / 100.0;
+    result.errorConstant = DispsErrorConstant(s, q, result.variant.p);
+    return result;
+}
@@ -0,0 +1,170 @@
+#include "../include/ETDRK4Solver.hpp"
+
+double ETDRK4Solver::Norm(std::vector<double> const &v) const
+{
+    return tolerances.Norm(v, scale);
+}
+
+std::vector<double> ETDRK4Solver::Nonlinear(
+    double                     t,
+    std::vector<double> const &y)
+{
+    std::vector<double> result = rhs(t, y);
+    std::vector<double> Ly = L.Multiply(y);
+    for (size_t i = 0; i < n; ++i)
+        result[i] -= Ly[i];
+    return result;
+}
+
+std::vector<double> ETDRK4Solver::Phi(
+    double                                  h,
+    std::vector<std::vector<double>> const &v)
+{
+    if (denseL.empty() && linearSolverKind == LinearSolverKind::Krylov)
+    {
+        auto multiply = [this](std::vector<double> const &x, std::vector<double> &out) { out = L.Multiply(x); };
+        return PhiKrylov(multiply, h, v, KRYLOV_FACTOR * tol);
+    }
+
+    if (denseL.empty())
+    {
+        auto &solver = shifted[h];
+        if (!solver)
+        {
+            solver = MakeLinearSolver(linearSolverKind, L.pattern);
+            if (!solver->Factorize(L, PHI_SHIFT * h))
+                throw std::runtime_error("ETDRK4: singular shifted operator");
+        }
+        LinearSolver const &shiftedSolver = *solver;
+        return PhiKrylovShiftInvert([&shiftedSolver](std::vector<double> &b) { shiftedSolver.Solve(b); }, v, KRYLOV_FACTOR * tol);
+    }
+
+    auto phi = PhiCache::Get(denseL, n, h);
+    std::vector<double> result(n, 0.0);
+    for (size_t k = 0; k < v.size(); ++k)
+    {
+        std::vector<double> const &matrix = (*phi)[k];
+        for (size_t i = 0; i < n; ++i)
+        {
+            double sum = 0.0;
+            for (size_t j = 0; j < n; ++j)
+                sum += matrix[i * n + j] * v[k][j];
+            result[i] += sum;
+        }
+    }
+    return result;
+}
+
+double ETDRK4Solver::TryStep(
+    double                     t,
+    std::vector<double> const &y,
+    double                     h,
+    std::vector<double>       &yNew)
+{
+    double h2 = 0.5 * h;
+    std::vector<double> w(n), w2(n), w3(n);
+
+    std::vector<double> Nu = Nonlinear(t, y);
+    for (size_t i = 0; i < n; ++i)
+        w[i] = h2 * Nu[i];
+    std::vector<double> a = Phi(h2, { y, w });
+
+    std::vector<double> Na = Nonlinear(t + h2, a);
+    for (size_t i = 0; i < n; ++i)
+        w[i] = h2 * Na[i];
+    std::vector<double> b = Phi(h2, { y, w });
+
+    std::vector<double> Nb = Nonlinear(t + h2, b);
+    for (size_t i = 0; i < n; ++i)
+        w[i] = h2 * (2.0 * Nb[i] - Nu[i]);
+    std::vector<double> c = Phi(h2, { a, w });
+
+    std::vector<double> Nc = Nonlinear(t + h, c);
+
+    // b1 = φ1 - 3φ2 + 4φ3, b2 = b3 = 2φ2 - 4φ3, b4 = -φ2 + 4φ3
+    for (size_t i = 0; i < n; ++i)
+    {
+        w[i] = h * Nu[i];
+        w2[i] = h * (-3.0 * Nu[i] + 2.0 * Na[i] + 2.0 * Nb[i] - Nc[i]);
+        w3[i] = 4.0 * h * (Nu[i] - Na[i] - Nb[i] + Nc[i]);
+    }
+    yNew = Phi(h, { y, w, w2, w3 });
+
+    // Разность с решением второго порядка y + h(φ1 Nu + 2φ2 (Nb - Nu)) (средняя точка b)
+    std::vector<double> zero(n, 0.0);
+    for (size_t i = 0; i < n; ++i)
+        w2[i] = h * (-Nu[i] + 2.0 * Na[i] - Nc[i]);
+    std::vector<double> e = Phi(h, { zero, zero, w2, w3 });
+
+    tolerances.Scales(tol, y, yNew, scale);
+
+    return Norm(e);
+}
+
+void ETDRK4Solver::Step(
+    double               t,
+    std::vector<double> &y,
+    double              &hStep,
+    double               tolerance)
+{
+    Storage local;
+    Solve(t, y, t + hStep, local, tolerance);
+    y = local[local.Size() - 1].second;
+}
+
+void ETDRK4Solver::Solve(
+    double                     t0,
+    std::vector<double> const &y0,
+    double                     tEnd,
+    Storage                   &storage,
+    double                     tolerance)
+{
+    double t = t0;
+    std::vector<double> y = y0;
+    n = y.size();
+    scale.resize(n);
+    tol = tolerance;
+
+    L = JacobianCsr(t, y, nullptr, tolerance);
+    shifted.clear();
+    denseL.clear();
+    if (n <= DENSE_LIMIT)
+    {
+        denseL.assign(n * n, 0.0);
+        for (size_t i = 0; i < n; ++i)
+            for (size_t k = L.pattern.rowPtr[i]; k < L.pattern.rowPtr[i + 1]; ++k)
+                denseL[i * n + L.pattern.colIndex[k]] = L.values[k];
+    }
+
+    // Начальный шаг оценивается по полной правой части
+    double const h0 = stepSize > 0.0 ? stepSize : EstimateInitialStep(rhs, t, y, rhs(t, y), tEnd, tolerance, 4, tolerances);
+    int level = 0;
+    std::vector<double> yNew;
+
+    storage.Add(t, y);
+
+    while (t < tEnd && !storage.Stopped())
+    {
+        double h = std::ldexp(h0, level);
+        bool last = t + h >= tEnd;
+        if (last)
+            h = tEnd - t;
+
+        if (h <= 10.0 * std::numeric_limits<double>::epsilon() * std::max(1.0, std::fabs(t)))
+            throw std::runtime_error("ETDRK4: step size too small");
+
+        double err = TryStep(t, y, h, yNew);
+        if (!(err <= 1.0))
+        {
+            level = std::min(level, static_cast<int>(std::floor(std::log2(h / h0)))) - 1;
+            continue;
+        }
+
+        y.swap(yNew);
+        t = last ? tEnd : t + h;
+        storage.Add(t, y);
+
+        if (err < GROW_ERROR)
+            ++level;
+    }
+}
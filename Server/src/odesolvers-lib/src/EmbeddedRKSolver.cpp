@@ -0,0 +1,497 @@
+#include "../include/EmbeddedRKSolver.hpp"
+
+namespace
+{
+    // Плотная выдача в форме Хайрера:
+    // y(t + theta h) = y + h * theta (r_2 + (1 - theta)(r_3 + theta (r_4 + (1 - theta)(r_5 + theta (...)))))
+    // r_2 = b, r_3 = e_1 - b, r_4 = b - e_last - r_3 (e_i - орт стадии), r_{5+m} = d[m].
+    // Раскрывается в многочлены b_i(theta) по всем стадиям.
+    std::vector<std::vector<double>> HairerDense(
+        size_t                                  totalStages,
+        std::vector<double> const              &b,
+        size_t                                  last,
+        std::vector<std::vector<double>> const &d)
+    {
+        std::vector<std::vector<double>> r;
+        std::vector<double> r2(totalStages, 0.0), r3(totalStages, 0.0), r4(totalStages, 0.0);
+        for (size_t i = 0; i < b.size(); ++i)
+            r2[i] = b[i];
+        for (size_t i = 0; i < totalStages; ++i)
+            r3[i] = (i == 0 ? 1.0 : 0.0) - r2[i];
+        for (size_t i = 0; i < totalStages; ++i)
+            r4[i] = r2[i] - (i == last ? 1.0 : 0.0) - r3[i];
+        r.push_back(r2);
+        r.push_back(r3);
+        r.push_back(r4);
+        for (auto const &row : d)
+        {
+            r.push_back(row);
+            r.back().resize(totalStages, 0.0);
+        }
+
+        // Многочлены по theta для каждой стадии, от внутренней скобки к внешней
+        size_t const degree = r.size() + 1;
+        std::vector<std::vector<double>> acc(totalStages, std::vector<double>(degree + 1, 0.0));
+        for (size_t i = 0; i < totalStages; ++i)
+            acc[i][0] = r.back()[i];
+
+        for (size_t j = r.size() - 1; j-- > 0;)
+        {
+            // Множитель между r_j и r_{j+1}: (1 - theta) для чётных j, theta для нечётных
+            bool complement = j % 2 == 0;
+            for (size_t i = 0; i < totalStages; ++i)
+            {
+                std::vector<double> next(degree + 1, 0.0);
+                for (size_t p = 0; p < degree; ++p)
+                {
+                    if (complement)
+                    {
+                        next[p] += acc[i][p];
+                        next[p + 1] -= acc[i][p];
+                    }
+                    else
+                    {
+                        next[p + 1] += acc[i][p];
+                    }
+                }
+                next[0] += r[j][i];
+                acc[i] = next;
+            }
+        }
+
+        // Внешний множитель theta
+        for (auto &poly : acc)
+        {
+            poly.insert(poly.begin(), 0.0);
+            poly.pop_back();
+        }
+        return acc;
+    }
+
+    EmbeddedTableau DormandPrince54()
+    {
+        EmbeddedTableau t;
+        t.name = "DP5";
+        t.order = 5;
+        t.errorOrder = 4;
+        t.stages = 7;
+        t.c = { 0.0, 1.0 / 5.0, 3.0 / 10.0, 4.0 / 5.0, 8.0 / 9.0, 1.0, 1.0 };
+        t.A = {
+            {},
+            { 1.0 / 5.0 },
+            { 3.0 / 40.0, 9.0 / 40.0 },
+            { 44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0 },
+            { 19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0 },
+            { 9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0 },
+            { 35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0 }
+        };
+        t.b = { 35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0, 0.0 };
+        t.e = { 71.0 / 57600.0, 0.0, -71.0 / 16695.0, 71.0 / 1920.0, -17253.0 / 339200.0, 22.0 / 525.0, -1.0 / 40.0 };
+
+        // Плотная выдача 4-го порядка (Шампайн)
+        std::vector<double> d = {
+            -12715105075.0 / 11282082432.0, 0.0, 87487479700.0 / 32700410799.0,
+            -10690763975.0 / 1880347072.0, 701980252875.0 / 199316789632.0,
+            -1453857185.0 / 822651844.0, 69997945.0 / 29380423.0
+        };
+        t.dense = HairerDense(t.stages, t.b, t.stages - 1, { d });
+        return t;
+    }
+
+    EmbeddedTableau Tsitouras54()
+    {
+        EmbeddedTableau t;
+        t.name = "Tsit5";
+        t.order = 5;
+        t.errorOrder = 4;
+        t.stages = 7;
+        t.c = { 0.0, 0.161, 0.327, 0.9, 0.9800255409045097, 1.0, 1.0 };
+        t.A = {
+            {},
+            { 0.161 },
+            { -0.008480655492356989, 0.335480655492357 },
+            { 2.897153057105493, -6.359448489975075, 4.3622954328695815 },
+            { 5.325864828439257, -11.748883564062828, 7.4955393428898365, -0.09249506636175525 },
+            { 5.86145544294642, -12.92096931784711, 8.159367898576159, -0.071584973281401, -0.028269050394068383 },
+            { 0.09646076681806523, 0.01, 0.4798896504144996, 1.379008574103742, -3.290069515436081, 2.324710524099774 }
+        };
+        t.b = { 0.09646076681806523, 0.01, 0.4798896504144996, 1.379008574103742,
+                -3.290069515436081, 2.324710524099774, 0.0 };
+        t.e = { -0.00178001105222577714, -0.0008164344596567469, 0.007880878010261995,
+                -0.1447110071732629, 0.5823571654525552, -0.45808210592918697, 1.0 / 66.0 };
+
+        // b_i(theta) = r_i1 theta + r_i2 theta^2 + r_i3 theta^3 + r_i4 theta^4
+        t.dense = {
+            { 0.0, 1.0, -2.763706197274826, 2.9132554618219126, -1.0530884977290216 },
+            { 0.0, 0.0, 0.13169999999999998, -0.2234, 0.1017 },
+            { 0.0, 0.0, 3.9302962368947516, -5.941033872131505, 2.490627285651253 },
+            { 0.0, 0.0, -12.411077166933676, 30.33818863028232, -16.548102889244902 },
+            { 0.0, 0.0, 37.50931341651104, -88.1789048947664, 47.37952196281928 },
+            { 0.0, 0.0, -27.896526289197286, 65.09189467479366, -34.87065786149660 },
+            { 0.0, 0.0, 1.5, -4.0, 2.5 }
+        };
+        return t;
+    }
+
+    EmbeddedTableau DormandPrince853()
+    {
+        EmbeddedTableau t;
+        t.name = "DOP853";
+        t.order = 8;
+        t.errorOrder = 7;
+        t.stages = 13;
+        t.c = {
+            0.0,
+            0.526001519587677318785587544488e-01,
+            0.789002279381515978178381316732e-01,
+            0.118350341907227396726757197510,
+            0.281649658092772603273242802490,
+            0.333333333333333333333333333333,
+            0.25,
+            0.307692307692307692307692307692,
+            0.651282051282051282051282051282,
+            0.6,
+            0.857142857142857142857142857142,
+            1.0,
+            1.0,
+            // Стадии плотной выдачи
+            0.1,
+            0.2,
+            0.777777777777777777777777777778
+        };
+
+        std::vector<double> b = {
+            5.42937341165687622380535766363e-2, 0.0, 0.0, 0.0, 0.0,
+            4.45031289275240888144113950566e0,
+            1.89151789931450038304281599044e0,
+            -5.8012039600105847814672114227e0,
+            3.1116436695781989440891606237e-1,
+            -1.52160949662516078556178806805e-1,
+            2.01365400804030348374776537501e-1,
+            4.47106157277725905176885569043e-2,
+            0.0
+        };
+
+        t.A = {
+            {},
+            { 5.26001519587677318785587544488e-2 },
+            { 1.97250569845378994544595329183e-2, 5.91751709536136983633785987549e-2 },
+            { 2.95875854768068491816892993775e-2, 0.0, 8.87627564304205475450678981324e-2 },
+            { 2.41365134159266685502369798665e-1, 0.0, -8.84549479328286085344864962717e-1,
+              9.24834003261792003115737966543e-1 },
+            { 3.7037037037037037037037037037e-2, 0.0, 0.0, 1.70828608729473871279604482173e-1,
+              1.25467687566822425016691814123e-1 },
+            { 3.7109375e-2, 0.0, 0.0, 1.70252211019544039314978060272e-1,
+              6.02165389804559606850219397283e-2, -1.7578125e-2 },
+            { 3.70920001185047927108779319836e-2, 0.0, 0.0, 1.70383925712239993810214054705e-1,
+              1.07262030446373284651809199168e-1, -1.53194377486244017527936158236e-2,
+              8.27378916381402288758473766002e-3 },
+            { 6.24110958716075717114429577812e-1, 0.0, 0.0, -3.36089262944694129406857109825e0,
+              -8.68219346841726006818189891453e-1, 2.75920996994467083049415600797e1,
+              2.01540675504778934086186788979e1, -4.34898841810699588477366255144e1 },
+            { 4.77662536438264365890433908527e-1, 0.0, 0.0, -2.48811461997166764192642586468e0,
+              -5.90290826836842996371446475743e-1, 2.12300514481811942347288949897e1,
+              1.52792336328824235832596922938e1, -3.32882109689848629194453265587e1,
+              -2.03312017085086261358222928593e-2 },
+            { -9.3714243008598732571704021658e-1, 0.0, 0.0, 5.18637242884406370830023853209e0,
+              1.09143734899672957818500254654e0, -8.14978701074692612513997267357e0,
+              -1.85200656599969598641566180701e1, 2.27394870993505042818970056734e1,
+              2.49360555267965238987089396762e0, -3.0467644718982195003823669022e0 },
+            { 2.27331014751653820792359768449e0, 0.0, 0.0, -1.05344954667372501984066689879e1,
+              -2.00087205822486249909675718444e0, -1.79589318631187989172765950534e1,
+              2.79488845294199600508499808837e1, -2.85899827713502369474065508674e0,
+              -8.87285693353062954433549289258e0, 1.23605671757943030647266201528e1,
+              6.43392746015763530355970484046e-1 },
+            std::vector<double>(b.begin(), b.begin() + 12),
+            { 5.61675022830479523392909219681e-2, 0.0, 0.0, 0.0, 0.0, 0.0,
+              2.53500210216624811088794765333e-1, -2.46239037470802489917441475441e-1,
+              -1.24191423263816360469010140626e-1, 1.5329179827876569731206322685e-1,
+              8.20105229563468988491666602057e-3, 7.56789766054569976138603589584e-3,
+              -8.298e-3 },
+            { 3.18346481635021405060768473261e-2, 0.0, 0.0, 0.0, 0.0,
+              2.83009096723667755288322961402e-2, 5.35419883074385676223797384372e-2,
+              -5.49237485713909884646569340306e-2, 0.0, 0.0,
+              -1.08347328697249322858509316994e-4, 3.82571090835658412954920192323e-4,
+              -3.40465008687404560802977114492e-4, 1.41312443674632500278074618366e-1 },
+            { -4.28896301583791923408573538692e-1, 0.0, 0.0, 0.0, 0.0,
+              -4.69762141536116384314449447206e0, 7.68342119606259904184240953878e0,
+              4.06898981839711007970213554331e0, 3.56727187455281109270669543021e-1,
+              0.0, 0.0, 0.0, -1.39902416515901462129418009734e-3,
+              2.9475147891527723389556272149e0, -9.15095847217987001081870187138e0 }
+        };
+        t.b = b;
+
+        // Оценка 5-го порядка
+        t.e = {
+            0.1312004499419488073250102996e-01, 0.0, 0.0, 0.0, 0.0,
+            -0.1225156446376204440720569753e+01,
+            -0.4957589496572501915214079952e+00,
+            0.1664377182454986536961530415e+01,
+            -0.3503288487499736816886487290e+00,
+            0.3341791187130174790297318841e+00,
+            0.8192320648511571246570742613e-01,
+            -0.2235530786388629525884427845e-01,
+            0.0
+        };
+
+        // Оценка 3-го порядка: b - b^ с b^_1, b^_9, b^_12
+        t.e3 = b;
+        t.e3[0] -= 0.244094488188976377952755905512;
+        t.e3[8] -= 0.733846688281611857341361741547;
+        t.e3[11] -= 0.220588235294117647058823529412e-1;
+
+        // Плотная выдача 7-го порядка
+        std::vector<std::vector<double>> d = {
+            { -0.84289382761090128651353491142e+01, 0.0, 0.0, 0.0, 0.0,
+              0.56671495351937776962531783590e+00, -0.30689499459498916912797304727e+01,
+              0.23846676565120698287728149680e+01, 0.21170345824450282767155149946e+01,
+              -0.87139158377797299206789907490e+00, 0.22404374302607882758541771650e+01,
+              0.63157877876946881815570249290e+00, -0.88990336451333310820698117400e-01,
+              0.18148505520854727256656404962e+02, -0.91946323924783554000451984436e+01,
+              -0.44360363875948939664310572000e+01 },
+            { 0.10427508642579134603413151009e+02, 0.0, 0.0, 0.0, 0.0,
+              0.24228349177525818288430175319e+03, 0.16520045171727028198505394887e+03,
+              -0.37454675472269020279518312152e+03, -0.22113666853125306036270938578e+02,
+              0.77334326684722638389603898808e+01, -0.30674084731089398182061213626e+02,
+              -0.93321305264302278729567221706e+01, 0.15697238121770843886131091075e+02,
+              -0.31139403219565177677282850411e+02, -0.93529243588444783865713862664e+01,
+              0.35816841486394083752465898540e+02 },
+            { 0.19985053242002433820987653617e+02, 0.0, 0.0, 0.0, 0.0,
+              -0.38703730874935176555105901742e+03, -0.18917813819516756882830838328e+03,
+              0.52780815920542364900561016686e+03, -0.11573902539959630126141871134e+02,
+              0.68812326946963000169666922661e+01, -0.10006050966910838403183860980e+01,
+              0.77771377980534432092869265740e+00, -0.27782057523535084065932004339e+01,
+              -0.60196695231264120758267380846e+02, 0.84320405506677161018159903784e+02,
+              0.11992291136182789328035130030e+02 },
+            { -0.25693933462703749003312586129e+02, 0.0, 0.0, 0.0, 0.0,
+              -0.15418974869023643374053993627e+03, -0.23152937917604549567536039109e+03,
+              0.35763911791061412378285349910e+03, 0.93405324183624310003907691704e+02,
+              -0.37458323136451633156875139351e+02, 0.10409964950896230045147246184e+03,
+              0.29840293426660503123344363579e+02, -0.43533456590011143754432175058e+02,
+              0.96324553959188282948394950600e+02, -0.39177261675615439165231486172e+02,
+              -0.14972683625798562581422125276e+03 }
+        };
+        t.dense = HairerDense(t.c.size(), t.b, t.stages - 1, d);
+        return t;
+    }
+}
+
+std::vector<std::string> EmbeddedPairs()
+{
+    return { "DP5", "Tsit5", "DOP853" };
+}
+
+EmbeddedTableau EmbeddedPair(std::string const &name)
+{
+    if (name == "DP5")
+        return DormandPrince54();
+    if (name == "Tsit5")
+        return Tsitouras54();
+    if (name == "DOP853")
+        return DormandPrince853();
+    throw std::runtime_error("Unknown embedded pair: " + name);
+}
+
+double EmbeddedRKSolver::Norm(std::vector<double> const &v) const
+{
+    return tolerances.Norm(v, scale);
+}
+
+void EmbeddedRKSolver::StageArgument(
+    size_t                     i,
+    std::vector<double> const &y,
+    double                     h)
+{
+    std::vector<double> const &a = tableau.A[i];
+    stage = y;
+    for (size_t j = 0; j < a.size(); ++j)
+    {
+        if (a[j] == 0.0)
+            continue;
+        double coefficient = h * a[j];
+        for (size_t m = 0; m < n; ++m)
+            stage[m] += coefficient * k[j][m];
+    }
+}
+
+double EmbeddedRKSolver::TryStep(
+    double                     t,
+    std::vector<double> const &y,
+    double                     h,
+    std::vector<double>       &yNew,
+    double                     tolerance)
+{
+    size_t const s = tableau.stages;
+    size_t const computed = fsalInEstimate ? s : s - 1;
+
+    for (size_t i = 1; i < computed; ++i)
+    {
+        StageArgument(i, y, h);
+        k[i] = f(t + tableau.c[i] * h, stage);
+    }
+
+    yNew = y;
+    for (size_t j = 0; j < s; ++j)
+    {
+        if (tableau.b[j] == 0.0)
+            continue;
+        for (size_t m = 0; m < n; ++m)
+            yNew[m] += h * tableau.b[j] * k[j][m];
+    }
+
+    tolerances.Scales(tolerance, y, yNew, scale);
+
+    auto estimate = [&](std::vector<double> const &weights)
+    {
+        std::vector<double> est(n, 0.0);
+        for (size_t j = 0; j < s; ++j)
+        {
+            if (weights[j] == 0.0)
+                continue;
+            for (size_t m = 0; m < n; ++m)
+                est[m] += weights[j] * k[j][m];
+        }
+        return est;
+    };
+
+    std::vector<double> est5 = estimate(tableau.e);
+    double err5 = Norm(est5);
+    if (tableau.e3.empty())
+        return std::fabs(h) * err5;
+
+    // DOP853: err = |h| err5^2 / sqrt(err5^2 + 0.01 err3^2)
+    double err3 = Norm(estimate(tableau.e3));
+    double deno = err5 * err5 + 0.01 * err3 * err3;
+    if (deno <= 0.0)
+        return 0.0;
+    return std::fabs(h) * err5 * err5 / std::sqrt(deno);
+}
+
+std::vector<double> EmbeddedRKSolver::Interpolate(double t)
+{
+    if (stepLength == 0.0)
+        return yStart;
+
+    // Дополнительные стадии плотной выдачи - один раз на шаг
+    if (!denseReady)
+    {
+        for (size_t i = tableau.stages; i < tableau.c.size(); ++i)
+        {
+            StageArgument(i, yStart, stepLength);
+            k[i] = f(stepStart + tableau.c[i] * stepLength, stage);
+        }
+        denseReady = true;
+    }
+
+    double theta = (t - stepStart) / stepLength;
+    std::vector<double> y = yStart;
+    for (size_t i = 0; i < tableau.dense.size(); ++i)
+    {
+        auto const &poly = tableau.dense[i];
+        double weight = 0.0;
+        for (size_t p = poly.size(); p-- > 0;)
+            weight = weight * theta + poly[p];
+        if (weight == 0.0)
+            continue;
+        for (size_t m = 0; m < n; ++m)
+            y[m] += stepLength * weight * k[i][m];
+    }
+    return y;
+}
+
+void EmbeddedRKSolver::Step(
+    double               t,
+    std::vector<double> &y,
+    double              &hStep,
+    double               tolerance)
+{
+    Storage local;
+    Solve(t, y, t + hStep, local, tolerance);
+    y = local[local.Size() - 1].second;
+}
+
+void EmbeddedRKSolver::Solve(
+    double                     t0,
+    std::vector<double> const &y0,
+    double                     tEnd,
+    Storage                   &storage,
+    double                     tolerance)
+{
+    double t = t0;
+    std::vector<double> y = y0, yNew;
+    double h = StartingStep(t, y, tEnd, tolerance, tableau.order);
+    n = y.size();
+    scale.resize(n);
+    k.assign(tableau.c.size(), std::vector<double>(n, 0.0));
+
+    size_t const last = tableau.stages - 1;
+    double const errorExponent = tableau.errorOrder + 1.0; // err ~ h^(errorOrder + 1)
+
+    // Последняя стадия (FSAL) нужна до проверки шага, только если входит в оценку погрешности
+    fsalInEstimate = tableau.e[last] != 0.0 || (!tableau.e3.empty() && tableau.e3[last] != 0.0);
+
+    k[0] = Derivative(t, y);
+    storage.Add(t, y, { t, nullptr, &k[0] });
+    stepLength = 0.0;
+    yStart = y;
+
+    size_t outputIndex = 1; // Номер следующей точки равномерной выдачи
+    bool advanced = false;
+    controller.Reset();
+
+    while (t < tEnd && !storage.Stopped())
+    {
+        // f(t, y) принятого шага - первая стадия следующего. Перенос откладывается до
+        // следующего шага, чтобы плотная выдача последнего шага оставалась доступной
+        if (advanced)
+        {
+            k[0].swap(k[last]);
+            advanced = false;
+        }
+
+        bool lastStep = t + h >= tEnd;
+        if (lastStep)
+            h = tEnd - t;
+
+        if (h <= 10.0 * std::numeric_limits<double>::epsilon() * std::max(1.0, std::fabs(t)))
+            throw std::runtime_error(tableau.name + ": step size too small");
+
+        double err = TryStep(t, y, h, yNew, tolerance);
+
+        if (!(err <= 1.0))
+        {
+            h *= controller.Reject(err, errorExponent);
+            continue;
+        }
+
+        double tNew = lastStep ? tEnd : t + h;
+        if (!fsalInEstimate)
+            k[last] = f(tNew, yNew);
+
+        stepStart = t;
+        stepLength = tNew - t;
+        yStart = y;
+        denseReady = false;
+
+        // События уточняются по плотной выдаче шага
+        StepOutput dense{ t, [this](double tDense) { return Interpolate(tDense); } };
+
+        if (outputStep > 0.0)
+        {
+            for (double tOut = t0 + outputIndex * outputStep; tOut < tNew; tOut = t0 + ++outputIndex * outputStep)
+                storage.Add(tOut, Interpolate(tOut), dense);
+            if (lastStep)
+                storage.Add(tNew, yNew, { t, dense.dense, &k[last] });
+        }
+        else
+        {
+            storage.Add(tNew, yNew, { t, dense.dense, &k[last] });
+        }
+
+        y.swap(yNew);
+        t = tNew;
+        advanced = true;
+
+        h *= controller.Accept(err, errorExponent);
+    }
+}
@@ -0,0 +1,133 @@
+#include "../include/ErrorTolerances.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+ErrorNormKind ParseErrorNormKind(std::string const &name)
+{
+    if (name.empty() || name == "RMS")
+        return ErrorNormKind::RMS;
+    if (name == "Max")
+        return ErrorNormKind::Max;
+
+    throw std::runtime_error("Unknown error norm: " + name);
+}
+
+ErrorTolerances::ErrorTolerances(
+    std::vector<double> atol,
+    std::vector<double> rtol,
+    ErrorNormKind       norm)
+    : atol(std::move(atol)), rtol(std::move(rtol)), norm(norm)
+{
+    for (double value : this->atol)
+    {
+        if (!(value >= 0.0))
+            throw std::invalid_argument("Absolute tolerances must be non-negative");
+    }
+    for (double value : this->rtol)
+    {
+        if (!(value >= 0.0))
+            throw std::invalid_argument("Relative tolerances must be non-negative");
+    }
+}
+
+void ErrorTolerances::Validate(size_t n) const
+{
+    if (atol.size() > 1 && atol.size() != n)
+        throw std::invalid_argument("Absolute tolerances do not match the system dimension");
+    if (rtol.size() > 1 && rtol.size() != n)
+        throw std::invalid_argument("Relative tolerances do not match the system dimension");
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (Absolute(i, 1.0) <= 0.0 && Relative(i, 1.0) <= 0.0)
+            throw std::invalid_argument("Absolute and relative tolerances of a component cannot both be zero");
+    }
+}
+
+namespace
+{
+    // Норма v_i / scaleOf(i): масштаб вычисляется в том же цикле, ветвления вынесены из цикла
+    template <typename ScaleOf>
+    double ScaledNorm(
+        size_t         n,
+        double const  *v,
+        ScaleOf const &scaleOf,
+        ErrorNormKind  kind)
+    {
+        if (n == 0)
+            return 0.0;
+
+        if (kind == ErrorNormKind::Max)
+        {
+            double result = 0.0;
+            for (size_t i = 0; i < n; ++i)
+                result = std::max(result, std::fabs(v[i]) / scaleOf(i));
+            return result;
+        }
+
+        double sum = 0.0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            double w = v[i] / scaleOf(i);
+            sum += w * w;
+        }
+        return std::sqrt(sum / n);
+    }
+}
+
+void ErrorTolerances::Scales(
+    double                     tolerance,
+    std::vector<double> const &y,
+    std::vector<double> const &yNew,
+    std::vector<double>       &scale) const
+{
+    size_t const n = y.size();
+    scale.resize(n);
+
+    if (!Componentwise())
+    {
+        for (size_t i = 0; i < n; ++i)
+            scale[i] = tolerance * (1.0 + std::max(std::fabs(y[i]), std::fabs(yNew[i])));
+        return;
+    }
+
+    for (size_t i = 0; i < n; ++i)
+        scale[i] = Absolute(i, tolerance) + Relative(i, tolerance) * std::max(std::fabs(y[i]), std::fabs(yNew[i]));
+}
+
+double ErrorTolerances::Norm(
+    std::vector<double> const &v,
+    std::vector<double> const &scale) const
+{
+    return ScaledNorm(v.size(), v.data(), [&](size_t i) { return scale[i]; }, norm);
+}
+
+double ErrorTolerances::Norm(
+    std::vector<double> const &e,
+    std::vector<double> const &y,
+    std::vector<double> const &yNew,
+    double                     tolerance) const
+{
+    double const *yp = y.data();
+    double const *yq = yNew.data();
+
+    if (!Componentwise())
+    {
+        return ScaledNorm(e.size(), e.data(), [&](size_t i)
+        {
+            return tolerance * (1.0 + std::max(std::fabs(yp[i]), std::fabs(yq[i])));
+        }, norm);
+    }
+
+    // Вектор из одного элемента - шаг 0 по индексу
+    double const *a = atol.empty() ? &tolerance : atol.data();
+    double const *r = rtol.empty() ? &tolerance : rtol.data();
+    size_t const aStride = atol.size() > 1 ? 1 : 0;
+    size_t const rStride = rtol.size() > 1 ? 1 : 0;
+    return ScaledNorm(e.size(), e.data(), [&](size_t i)
+    {
+        return a[i * aStride] + r[i * rStride] * std::max(std::fabs(yp[i]), std::fabs(yq[i]));
+    }, norm);
+}
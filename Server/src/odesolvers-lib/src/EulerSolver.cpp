@@ -8,32 +8,33 @@ void EulerSolver::Step(
 {
     std::vector<double> y_temp = y;
     
-    // Пробный шаг Эйлера
-    std::vector<double> k = MultiplyScalarByVector(h, f(t, y_temp));
+    // Пробный шаг Эйлера: f(t, y) - сохранённая в конце предыдущего шага f_next
+    std::vector<double> f_curr = Derivative(t, y);
+    std::vector<double> k = MultiplyScalarByVector(h, f_curr);
     y_temp = AddVectors(y_temp, k);
     
     // Оценка ошибки через разность производных
-    std::vector<double> f_curr = f(t, y);
     std::vector<double> f_next = f(t + h, y_temp);
     
     // Локальная ошибка (порядок h^2)
-    double error = 0.0;
+    std::vector<double> e(y.size());
     for (size_t i = 0; i < y.size(); ++i)
     {
-        error = std::max(error, std::abs(0.5 * h * (f_next[i] - f_curr[i])));
+        e[i] = 0.5 * h * (f_next[i] - f_curr[i]);
     }
+    double error = ErrorMaxNorm(e, y, y_temp, tolerance);
     
-    // Адаптация шага
+    // Адаптация шага: оценка погрешности ~ h^2
     if (error > tolerance)
     {
-        h *= std::max(SAFETY_FACTOR * sqrt(tolerance / error), MIN_FACTOR);
+        h *= controller.Reject(error / tolerance, 2.0);
         throw std::runtime_error("Step rejected"); // Шаг отклонен
     }
     else
     {
         // Принимаем шаг и корректируем размер
-        double factor = std::min(SAFETY_FACTOR * sqrt(tolerance / (error + 1e-12)), MAX_FACTOR);
-        h *= factor;
+        StoreDerivative(t + h, y_temp, f_next);
+        h *= controller.Accept(error / tolerance, 2.0);
         y = y_temp; // Обновляем состояние только при успехе
     }
 }
@@ -47,10 +48,12 @@ void EulerSolver::Solve(
 {
     double t = t0;
     std::vector<double> y = y0;
-    double h = stepSize;
     storage.Add(t, y);
+    ResetDerivative();
+    controller.Reset();
+    double h = StartingStep(t, y, tEnd, tolerance, 1);
 
-    while (t < tEnd)
+    while (t < tEnd && !storage.Stopped())
     {
         double h_attempt = std::min(h, tEnd - t);
         if (h_attempt <= 0) break;
@@ -58,16 +61,17 @@ void EulerSolver::Solve(
         try
         {
             std::vector<double> y_new = y;
-            Step(t, y_new, h_attempt, tolerance); // Проверка точности внутри Step
-            t += h_attempt;
+            double h_used = h_attempt;
+            Step(t, y_new, h_attempt, tolerance); // Проверка точности внутри Step, h_attempt - следующий шаг
+            t += h_used;
             y = y_new;
-            storage.Add(t, y);
+            AddPoint(storage, t, y);
             h = h_attempt; // Обновляем базовый шаг
         } 
         catch (const std::runtime_error&)
         {
-            // Шаг отклонен - повторяем с уменьшенным h
-            h = h_attempt * 0.5;
+            // Шаг отклонен - Step уже уменьшил h_attempt
+            h = h_attempt;
         }
     }
 }
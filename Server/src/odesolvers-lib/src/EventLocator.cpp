@@ -0,0 +1,166 @@
+#include "../include/EventLocator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+EventLocator::EventLocator(
+    EventFunction              events,
+    std::vector<EventSettings> settings,
+    std::function<std::vector<double>(
+        double,
+        std::vector<double> const &)> func)
+    : g(std::move(events)), settings(std::move(settings)), f(std::move(func))
+{
+}
+
+void EventLocator::Start(
+    double                     t,
+    std::vector<double> const &y,
+    std::vector<double> const *derivative)
+{
+    tPrev = t;
+    yPrev = y;
+    gPrev = g(t, y);
+    if (derivative)
+        fPrev = *derivative;
+    else
+        fPrev.clear();
+    records.clear();
+
+    if (gPrev.size() != settings.size())
+        throw std::invalid_argument("Number of event settings does not match the number of event functions");
+}
+
+bool EventLocator::Crossed(
+    size_t i,
+    double before,
+    double after) const
+{
+    // Выход из нуля не считается событием: корень в начале шага уже записан
+    if (before == 0.0)
+        return false;
+
+    int direction = settings[i].direction;
+    if (before < 0.0 && after >= 0.0)
+        return direction >= 0;
+    if (before > 0.0 && after <= 0.0)
+        return direction <= 0;
+    return false;
+}
+
+bool EventLocator::Check(
+    double              &t,
+    std::vector<double> &y,
+    StepOutput const    &step)
+{
+    std::vector<double> gNew = g(t, y);
+
+    std::vector<size_t> crossed;
+    for (size_t i = 0; i < gNew.size(); ++i)
+    {
+        if (Crossed(i, gPrev[i], gNew[i]))
+            crossed.push_back(i);
+    }
+
+    if (crossed.empty())
+    {
+        tPrev = t;
+        yPrev = y;
+        gPrev = std::move(gNew);
+        if (step.derivative)
+            fPrev = *step.derivative;
+        else
+            fPrev.clear();
+        return false;
+    }
+
+    // Плотная выдача решателя, если покрывает отрезок (при равномерной выдаче предыдущая
+    // точка может лежать на одном из прошлых шагов), иначе кубический интерполянт Эрмита
+    // по f в концах; s = (t - tPrev) / h
+    double const h = t - tPrev;
+    bool const dense = step.dense && step.start <= tPrev;
+    std::vector<double> f1;
+    if (!dense)
+    {
+        if (fPrev.empty())
+            fPrev = f(tPrev, yPrev);
+        f1 = step.derivative ? *step.derivative : f(t, y);
+    }
+    std::vector<double> const &f0 = fPrev;
+    auto interpolate = [&](double s)
+    {
+        if (dense)
+            return step.dense(tPrev + s * h);
+
+        double const s2 = s * s;
+        double const s3 = s2 * s;
+        double const h00 = 2.0 * s3 - 3.0 * s2 + 1.0;
+        double const h10 = s3 - 2.0 * s2 + s;
+        double const h01 = -2.0 * s3 + 3.0 * s2;
+        double const h11 = s3 - s2;
+
+        std::vector<double> ys(y.size());
+        for (size_t j = 0; j < y.size(); ++j)
+            ys[j] = h00 * yPrev[j] + h * (h10 * f0[j] + h11 * f1[j]) + h01 * y[j];
+        return ys;
+    };
+
+    // Метод Иллинойс: метод хорд с делением пополам значения на конце, который не меняется
+    std::vector<std::pair<double, size_t>> roots;
+    for (size_t i : crossed)
+    {
+        double a = 0.0;
+        double b = 1.0;
+        double ga = gPrev[i];
+        double gb = gNew[i];
+
+        for (int iteration = 0; iteration < MAX_ITERATIONS && gb != 0.0; ++iteration)
+        {
+            double c = b - gb * (b - a) / (gb - ga);
+            double gc = g(tPrev + c * h, interpolate(c))[i];
+
+            if (gc * gb < 0.0)
+            {
+                a = b;
+                ga = gb;
+            }
+            else
+            {
+                ga *= 0.5;
+            }
+            b = c;
+            gb = gc;
+
+            if (std::fabs(b - a) <= ROOT_TOLERANCE)
+                break;
+        }
+
+        roots.emplace_back(b, i);
+    }
+    std::sort(roots.begin(), roots.end());
+
+    for (auto const &[s, i] : roots)
+    {
+        EventRecord record{i, tPrev + s * h, s == 1.0 ? y : interpolate(s)};
+        records.push_back(record);
+
+        if (settings[i].terminal)
+        {
+            t = record.t;
+            y = record.y;
+            return true;
+        }
+    }
+
+    tPrev = t;
+    yPrev = y;
+    gPrev = std::move(gNew);
+    if (!f1.empty())
+        fPrev = std::move(f1);
+    else if (step.derivative)
+        fPrev = *step.derivative;
+    else
+        fPrev.clear();
+    return false;
+}
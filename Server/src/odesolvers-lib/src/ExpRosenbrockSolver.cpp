@@ -0,0 +1,113 @@
+#include "../include/ExpRosenbrockSolver.hpp"
+
+double ExpRosenbrockSolver::Norm(std::vector<double> const &v) const
+{
+    return tolerances.Norm(v, scale);
+}
+
+void ExpRosenbrockSolver::Step(
+    double               t,
+    std::vector<double> &y,
+    double              &hStep,
+    double               tolerance)
+{
+    Storage local;
+    Solve(t, y, t + hStep, local, tolerance);
+    y = local[local.Size() - 1].second;
+}
+
+void ExpRosenbrockSolver::Solve(
+    double                     t0,
+    std::vector<double> const &y0,
+    double                     tEnd,
+    Storage                   &storage,
+    double                     tolerance)
+{
+    double t = t0;
+    std::vector<double> y = y0;
+    double h = StartingStep(t, y, tEnd, tolerance, 2);
+    n = y.size();
+    scale.resize(n);
+
+    double const sqrtEps = std::sqrt(std::numeric_limits<double>::epsilon());
+    std::vector<double> zero(n, 0.0), w1(n), w2(n), U2(n), D(n);
+    shifted.reset();
+    controller.Reset();
+
+    storage.Add(t, y);
+
+    while (t < tEnd && !storage.Stopped())
+    {
+        std::vector<double> fy = Derivative(t, y);
+        CsrMatrix const &J = JacobianCsr(t, y, &fy, tolerance);
+        auto multiply = [&J](std::vector<double> const &x, std::vector<double> &out) { out = J.Multiply(x); };
+        auto solveShifted = [this](std::vector<double> &b) { shifted->Solve(b); };
+        auto phi = [&](double step, std::vector<std::vector<double>> const &v)
+        {
+            return linearSolverKind == LinearSolverKind::Krylov
+                ? PhiKrylov(multiply, step, v, KRYLOV_FACTOR * tolerance)
+                : PhiKrylovShiftInvert(solveShifted, v, KRYLOV_FACTOR * tolerance);
+        };
+
+        // Производная по времени для неавтономных систем: f(t, y) + (s - t) w + J (v - y)
+        double dt = sqrtEps * std::max(1.0, std::fabs(t));
+        std::vector<double> w = f(t + dt, y);
+        for (size_t i = 0; i < n; ++i)
+            w[i] = (w[i] - fy[i]) / dt;
+
+        tolerances.Scales(tolerance, y, y, scale);
+
+        while (true)
+        {
+            bool last = t + h >= tEnd;
+            if (last)
+                h = tEnd - t;
+
+            if (h <= 10.0 * std::numeric_limits<double>::epsilon() * std::max(1.0, std::fabs(t)))
+                throw std::runtime_error("ExpRosenbrock: step size too small");
+
+            if (linearSolverKind != LinearSolverKind::Krylov)
+            {
+                if (!shifted)
+                    shifted = MakeLinearSolver(linearSolverKind, J.pattern);
+                if (!shifted->Factorize(J, PHI_SHIFT * h))
+                    throw std::runtime_error("ExpRosenbrock: singular shifted Jacobian");
+            }
+
+            // U2 = y + h φ1(hJ) f + h^2 φ2(hJ) w
+            for (size_t i = 0; i < n; ++i)
+            {
+                w1[i] = h * fy[i];
+                w2[i] = h * h * w[i];
+            }
+            U2 = phi(h, { zero, w1, w2 });
+            for (size_t i = 0; i < n; ++i)
+                U2[i] += y[i];
+
+            // D = g(t + h, U2) - g(t, y), g - нелинейный остаток линеаризации
+            std::vector<double> fU = f(t + h, U2);
+            for (size_t i = 0; i < n; ++i)
+                w1[i] = U2[i] - y[i];
+            std::vector<double> JdU = J.Multiply(w1);
+            for (size_t i = 0; i < n; ++i)
+                D[i] = 2.0 * h * (fU[i] - fy[i] - JdU[i] - h * w[i]);
+
+            std::vector<double> e = phi(h, { zero, zero, zero, D });
+            double err = Norm(e);
+
+            if (!(err <= 1.0))
+            {
+                h *= controller.Reject(err, 3.0);
+                continue;
+            }
+
+            for (size_t i = 0; i < n; ++i)
+                y[i] = U2[i] + e[i];
+            t = last ? tEnd : t + h;
+            storage.Add(t, y);
+
+            h *= controller.Accept(err, 3.0);
+            break;
+        }
+    }
+}
@@ -0,0 +1,701 @@
+#include "../include/ExpressionCompiler.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <tuple>
+
+std::mutex ExpressionCompiler::cacheMutex;
+std::unordered_map<size_t, ExpressionCompiler::CacheEntry> ExpressionCompiler::cache;
+
+void ExpressionProgram::Evaluate(
+    double        t,
+    double const *y,
+    double const *params,
+    double       *out) const
+{
+    thread_local std::vector<double> registers;
+    registers.assign(registerTemplate.begin(), registerTemplate.end());
+
+    double *r = registers.data();
+    r[0] = t;
+    std::memcpy(r + YRegister(0), y, dimension * sizeof(double));
+    std::memcpy(r + ParameterRegister(0), params, parameterNames.size() * sizeof(double));
+
+    for (Instruction const &ins : code)
+    {
+        double const a = r[ins.a];
+        double const b = r[ins.b];
+        double v;
+
+        switch (ins.op)
+        {
+            case OpAdd:  v = a + b;              break;
+            case OpSub:  v = a - b;              break;
+            case OpMul:  v = a * b;              break;
+            case OpDiv:  v = a / b;              break;
+            case OpNeg:  v = -a;                 break;
+            case OpPow:  v = std::pow(a, b);     break;
+            case OpSqr:  v = a * a;              break;
+            case OpSqrt: v = std::sqrt(a);       break;
+            case OpExp:  v = std::exp(a);        break;
+            case OpLog:  v = std::log(a);        break;
+            case OpSin:  v = std::sin(a);        break;
+            case OpCos:  v = std::cos(a);        break;
+            case OpTan:  v = std::tan(a);        break;
+            case OpSinh: v = std::sinh(a);       break;
+            case OpCosh: v = std::cosh(a);       break;
+            case OpTanh: v = std::tanh(a);       break;
+            case OpAtan: v = std::atan(a);       break;
+            case OpAbs:  v = std::fabs(a);       break;
+            case OpMin:  v = std::min(a, b);     break;
+            case OpMax:  v = std::max(a, b);     break;
+            default:     v = 0.0;                break;
+        }
+
+        r[ins.dst] = v;
+    }
+
+    for (size_t i = 0; i < outputs.size(); ++i)
+        out[i] = r[outputs[i]];
+}
+
+std::vector<std::vector<uint32_t>> ExpressionProgram::OutputDependencies() const
+{
+    // Множества зависимостей регистров распространяются по байт-коду
+    std::vector<std::vector<uint32_t>> depends(registerTemplate.size());
+    for (size_t i = 0; i < dimension; ++i)
+        depends[YRegister(i)] = {static_cast<uint32_t>(i)};
+
+    for (Instruction const &ins : code)
+    {
+        std::vector<uint32_t> merged;
+        std::set_union(depends[ins.a].begin(), depends[ins.a].end(),
+                       depends[ins.b].begin(), depends[ins.b].end(),
+                       std::back_inserter(merged));
+        depends[ins.dst] = std::move(merged);
+    }
+
+    std::vector<std::vector<uint32_t>> result;
+    for (uint32_t output : outputs)
+        result.push_back(depends[output]);
+    return result;
+}
+
+CsrPattern ExpressionProgram::DependencyPattern() const
+{
+    std::vector<std::vector<uint32_t>> depends = OutputDependencies();
+
+    CsrPattern pattern;
+    pattern.n = dimension;
+    pattern.rowPtr.assign(dimension + 1, 0);
+    for (size_t i = 0; i < dimension; ++i)
+    {
+        std::vector<uint32_t> &row = depends[i];
+        if (!std::binary_search(row.begin(), row.end(), static_cast<uint32_t>(i)))
+            row.insert(std::lower_bound(row.begin(), row.end(), static_cast<uint32_t>(i)), static_cast<uint32_t>(i));
+
+        pattern.colIndex.insert(pattern.colIndex.end(), row.begin(), row.end());
+        pattern.rowPtr[i + 1] = pattern.colIndex.size();
+    }
+    return pattern;
+}
+
+bool ExpressionProgram::DependsOn(
+    size_t first,
+    size_t last) const
+{
+    for (auto const &row : OutputDependencies())
+    {
+        auto it = std::lower_bound(row.begin(), row.end(), static_cast<uint32_t>(first));
+        if (it != row.end() && *it < last)
+            return true;
+    }
+    return false;
+}
+
+namespace
+{
+    using OpCode = ExpressionProgram::OpCode;
+
+    enum class NodeKind
+    {
+        Time,
+        Variable,
+        Parameter,
+        Constant,
+        Operation
+    };
+
+    struct Node
+    {
+        NodeKind kind;
+        OpCode   op    = ExpressionProgram::OpAdd;
+        int      a     = -1;
+        int      b     = -1;
+        size_t   index = 0;   // Номер переменной или параметра
+        double   value = 0.0; // Значение константы
+    };
+
+    bool IsUnary(OpCode op)
+    {
+        switch (op)
+        {
+            case ExpressionProgram::OpAdd:
+            case ExpressionProgram::OpSub:
+            case ExpressionProgram::OpMul:
+            case ExpressionProgram::OpDiv:
+            case ExpressionProgram::OpPow:
+            case ExpressionProgram::OpMin:
+            case ExpressionProgram::OpMax:
+                return false;
+            default:
+                return true;
+        }
+    }
+
+    bool IsCommutative(OpCode op)
+    {
+        return op == ExpressionProgram::OpAdd || op == ExpressionProgram::OpMul ||
+               op == ExpressionProgram::OpMin || op == ExpressionProgram::OpMax;
+    }
+
+    double Apply(OpCode op, double a, double b)
+    {
+        switch (op)
+        {
+            case ExpressionProgram::OpAdd:  return a + b;
+            case ExpressionProgram::OpSub:  return a - b;
+            case ExpressionProgram::OpMul:  return a * b;
+            case ExpressionProgram::OpDiv:  return a / b;
+            case ExpressionProgram::OpNeg:  return -a;
+            case ExpressionProgram::OpPow:  return std::pow(a, b);
+            case ExpressionProgram::OpSqr:  return a * a;
+            case ExpressionProgram::OpSqrt: return std::sqrt(a);
+            case ExpressionProgram::OpExp:  return std::exp(a);
+            case ExpressionProgram::OpLog:  return std::log(a);
+            case ExpressionProgram::OpSin:  return std::sin(a);
+            case ExpressionProgram::OpCos:  return std::cos(a);
+            case ExpressionProgram::OpTan:  return std::tan(a);
+            case ExpressionProgram::OpSinh: return std::sinh(a);
+            case ExpressionProgram::OpCosh: return std::cosh(a);
+            case ExpressionProgram::OpTanh: return std::tanh(a);
+            case ExpressionProgram::OpAtan: return std::atan(a);
+            case ExpressionProgram::OpAbs:  return std::fabs(a);
+            case ExpressionProgram::OpMin:  return std::min(a, b);
+            case ExpressionProgram::OpMax:  return std::max(a, b);
+        }
+        return 0.0;
+    }
+
+    // Граф выражений (DAG) со свёрткой констант и устранением общих подвыражений
+    class ExpressionGraph
+    {
+    public:
+        explicit ExpressionGraph(size_t dimension) : dimension(dimension)
+        {
+            nodes.push_back({NodeKind::Time});
+            for (size_t i = 0; i < dimension; ++i)
+            {
+                Node node{NodeKind::Variable};
+                node.index = i;
+                nodes.push_back(node);
+            }
+        }
+
+        std::vector<Node>        nodes;
+        std::vector<std::string> parameterNames;
+
+        int Time() const { return 0; }
+
+        int Variable(size_t i) const
+        {
+            if (i >= dimension)
+                throw std::runtime_error("Variable y" + std::to_string(i) + " is out of range");
+            return static_cast<int>(1 + i);
+        }
+
+        int Parameter(std::string const &name)
+        {
+            auto it = parameters.find(name);
+            if (it != parameters.end())
+                return it->second;
+
+            Node node{NodeKind::Parameter};
+            node.index = parameterNames.size();
+            parameterNames.push_back(name);
+            nodes.push_back(node);
+            return parameters[name] = static_cast<int>(nodes.size() - 1);
+        }
+
+        int Constant(double value)
+        {
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+
+            auto it = constants.find(bits);
+            if (it != constants.end())
+                return it->second;
+
+            Node node{NodeKind::Constant};
+            node.value = value;
+            nodes.push_back(node);
+            return constants[bits] = static_cast<int>(nodes.size() - 1);
+        }
+
+        bool IsConstant(int id, double value) const
+        {
+            return nodes[id].kind == NodeKind::Constant && nodes[id].value == value;
+        }
+
+        int Operation(OpCode op, int a, int b = -1)
+        {
+            // Свёртка констант
+            if (nodes[a].kind == NodeKind::Constant && (b < 0 || nodes[b].kind == NodeKind::Constant))
+                return Constant(Apply(op, nodes[a].value, b < 0 ? 0.0 : nodes[b].value));
+
+            // Алгебраические упрощения, не меняющие результат (кроме знака нуля: -0 + 0 и 0 - 0
+            // дают +0, а упрощённые x и -x - исходный знак)
+            switch (op)
+            {
+                case ExpressionProgram::OpAdd:
+                    if (IsConstant(a, 0.0)) return b;
+                    if (IsConstant(b, 0.0)) return a;
+                    break;
+                case ExpressionProgram::OpSub:
+                    if (IsConstant(b, 0.0)) return a;
+                    if (IsConstant(a, 0.0)) return Operation(ExpressionProgram::OpNeg, b);
+                    break;
+                case ExpressionProgram::OpMul:
+                    if (IsConstant(a, 1.0)) return b;
+                    if (IsConstant(b, 1.0)) return a;
+                    if (IsConstant(a, -1.0)) return Operation(ExpressionProgram::OpNeg, b);
+                    if (IsConstant(b, -1.0)) return Operation(ExpressionProgram::OpNeg, a);
+                    break;
+                case ExpressionProgram::OpDiv:
+                    if (IsConstant(b, 1.0)) return a;
+                    if (nodes[b].kind == NodeKind::Constant)
+                    {
+                        // Деление на степень двойки заменяется точным умножением
+                        int exponent;
+                        double mantissa = std::frexp(nodes[b].value, &exponent);
+                        if (std::fabs(mantissa) == 0.5)
+                            return Operation(ExpressionProgram::OpMul, a, Constant(1.0 / nodes[b].value));
+                    }
+                    break;
+                case ExpressionProgram::OpNeg:
+                    if (nodes[a].kind == NodeKind::Operation && nodes[a].op == ExpressionProgram::OpNeg)
+                        return nodes[a].a;
+                    break;
+                case ExpressionProgram::OpPow:
+                    if (IsConstant(b, 1.0)) return a;
+                    if (IsConstant(b, 0.0)) return Constant(1.0);
+                    if (IsConstant(b, 2.0)) return Operation(ExpressionProgram::OpSqr, a);
+
+                    // Замены, которые могут отличаться от pow на 1 ulp (двойное округление или
+                    // не точно округлённый pow из libm), а у sqrt - и в особых точках:
+                    // sqrt(-0) = -0 и sqrt(-inf) = NaN вместо +0 и +inf у pow
+                    if (IsConstant(b, 3.0))
+                        return Operation(ExpressionProgram::OpMul, Operation(ExpressionProgram::OpSqr, a), a);
+                    if (IsConstant(b, 4.0))
+                        return Operation(ExpressionProgram::OpSqr, Operation(ExpressionProgram::OpSqr, a));
+                    if (IsConstant(b, 0.5)) return Operation(ExpressionProgram::OpSqrt, a);
+                    if (IsConstant(b, -1.0)) return Operation(ExpressionProgram::OpDiv, Constant(1.0), a);
+                    break;
+                default:
+                    break;
+            }
+
+            if (IsCommutative(op) && b < a)
+                std::swap(a, b);
+
+            auto key = std::make_tuple(static_cast<int>(op), a, b);
+            auto it = operations.find(key);
+            if (it != operations.end())
+                return it->second;
+
+            Node node{NodeKind::Operation};
+            node.op = op;
+            node.a = a;
+            node.b = b;
+            nodes.push_back(node);
+            return operations[key] = static_cast<int>(nodes.size() - 1);
+        }
+
+    private:
+        size_t                                   dimension;
+        std::unordered_map<std::string, int>     parameters;
+        std::unordered_map<uint64_t, int>        constants;
+        std::map<std::tuple<int, int, int>, int> operations;
+    };
+
+    // Рекурсивный спуск:
+    //   expr    := term (('+' | '-') term)*
+    //   term    := unary (('*' | '/') unary)*
+    //   unary   := ('-' | '+') unary | power
+    //   power   := primary (('^' | '**') unary)?
+    //   primary := number | name | name '(' expr (',' expr)* ')' | '(' expr ')'
+    class Parser
+    {
+    public:
+        Parser(std::string const &text, ExpressionGraph &graph) : text(text), graph(graph) {}
+
+        int Parse()
+        {
+            int id = Expression();
+            SkipSpaces();
+            if (pos != text.size())
+                Fail("unexpected symbol '" + std::string(1, text[pos]) + "'");
+            return id;
+        }
+
+    private:
+        std::string const &text;
+        ExpressionGraph   &graph;
+        size_t             pos = 0;
+
+        [[noreturn]] void Fail(std::string const &message) const
+        {
+            throw std::runtime_error(
+                "Expression error at " + std::to_string(pos) + " in \"" + text + "\": " + message);
+        }
+
+        void SkipSpaces()
+        {
+            while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos])))
+                ++pos;
+        }
+
+        bool Accept(char c)
+        {
+            SkipSpaces();
+            if (pos < text.size() && text[pos] == c)
+            {
+                ++pos;
+                return true;
+            }
+            return false;
+        }
+
+        void Expect(char c)
+        {
+            if (!Accept(c))
+                Fail(std::string("expected '") + c + "'");
+        }
+
+        int Expression()
+        {
+            int id = Term();
+            while (true)
+            {
+                if (Accept('+'))
+                    id = graph.Operation(ExpressionProgram::OpAdd, id, Term());
+                else if (Accept('-'))
+                    id = graph.Operation(ExpressionProgram::OpSub, id, Term());
+                else
+                    return id;
+            }
+        }
+
+        int Term()
+        {
+            int id = Unary();
+            while (true)
+            {
+                SkipSpaces();
+                if (pos + 1 < text.size() && text[pos] == '*' && text[pos + 1] == '*')
+                    return id;
+                if (Accept('*'))
+                    id = graph.Operation(ExpressionProgram::OpMul, id, Unary());
+                else if (Accept('/'))
+                    id = graph.Operation(ExpressionProgram::OpDiv, id, Unary());
+                else
+                    return id;
+            }
+        }
+
+        int Unary()
+        {
+            if (Accept('-'))
+                return graph.Operation(ExpressionProgram::OpNeg, Unary());
+            if (Accept('+'))
+                return Unary();
+            return Power();
+        }
+
+        int Power()
+        {
+            int base = Primary();
+            SkipSpaces();
+            if (Accept('^'))
+                return graph.Operation(ExpressionProgram::OpPow, base, Unary());
+            if (pos + 1 < text.size() && text[pos] == '*' && text[pos + 1] == '*')
+            {
+                pos += 2;
+                return graph.Operation(ExpressionProgram::OpPow, base, Unary());
+            }
+            return base;
+        }
+
+        int Primary()
+        {
+            SkipSpaces();
+            if (pos >= text.size())
+                Fail("unexpected end of expression");
+
+            if (Accept('('))
+            {
+                int id = Expression();
+                Expect(')');
+                return id;
+            }
+
+            char c = text[pos];
+            if (std::isdigit(static_cast<unsigned char>(c)) || c == '.')
+            {
+                char const *begin = text.c_str() + pos;
+                char *end = nullptr;
+                double value = std::strtod(begin, &end);
+                if (end == begin)
+                    Fail("invalid number");
+                pos += static_cast<size_t>(end - begin);
+                return graph.Constant(value);
+            }
+
+            if (std::isalpha(static_cast<unsigned char>(c)) || c == '_')
+            {
+                size_t start = pos;
+                while (pos < text.size() &&
+                       (std::isalnum(static_cast<unsigned char>(text[pos])) || text[pos] == '_'))
+                    ++pos;
+                std::string name = text.substr(start, pos - start);
+
+                if (Accept('('))
+                    return Function(name);
+
+                return Identifier(name);
+            }
+
+            Fail("unexpected symbol '" + std::string(1, c) + "'");
+        }
+
+        int Identifier(std::string const &name)
+        {
+            if (name == "t")
+                return graph.Time();
+            if (name == "pi")
+                return graph.Constant(M_PI);
+            if (name == "e")
+                return graph.Constant(M_E);
+
+            if (name.size() > 1 && name[0] == 'y' &&
+                std::all_of(name.begin() + 1, name.end(), [](char ch)
+                {
+                    return std::isdigit(static_cast<unsigned char>(ch));
+                }))
+            {
+                return graph.Variable(std::stoul(name.substr(1)));
+            }
+
+            return graph.Parameter(name);
+        }
+
+        int Function(std::string const &name)
+        {
+            static std::unordered_map<std::string, OpCode> const unary = {
+                {"sqrt", ExpressionProgram::OpSqrt}, {"exp",  ExpressionProgram::OpExp},
+                {"log",  ExpressionProgram::OpLog},  {"ln",   ExpressionProgram::OpLog},
+                {"sin",  ExpressionProgram::OpSin},  {"cos",  ExpressionProgram::OpCos},
+                {"tan",  ExpressionProgram::OpTan},  {"sinh", ExpressionProgram::OpSinh},
+                {"cosh", ExpressionProgram::OpCosh}, {"tanh", ExpressionProgram::OpTanh},
+                {"atan", ExpressionProgram::OpAtan}, {"abs",  ExpressionProgram::OpAbs}
+            };
+            static std::unordered_map<std::string, OpCode> const binary = {
+                {"pow", ExpressionProgram::OpPow},
+                {"min", ExpressionProgram::OpMin},
+                {"max", ExpressionProgram::OpMax}
+            };
+
+            int a = Expression();
+
+            auto u = unary.find(name);
+            if (u != unary.end())
+            {
+                Expect(')');
+                return graph.Operation(u->second, a);
+            }
+
+            auto bin = binary.find(name);
+            if (bin != binary.end())
+            {
+                Expect(',');
+                int b = Expression();
+                Expect(')');
+                return graph.Operation(bin->second, a, b);
+            }
+
+            Fail("unknown function '" + name + "'");
+        }
+    };
+}
+
+std::shared_ptr<ExpressionProgram const> ExpressionCompiler::Compile(
+    std::vector<std::string> const &expressions,
+    size_t                          dimension)
+{
+    if (dimension == 0)
+        dimension = expressions.size();
+
+    std::string source = std::to_string(dimension) + ':';
+    for (auto const &expression : expressions)
+    {
+        source += expression;
+        source += ';';
+    }
+    size_t hash = std::hash<std::string>{}(source);
+
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto it = cache.find(hash);
+        if (it != cache.end() && it->second.source == source)
+            return it->second.program;
+    }
+
+    auto program = Build(expressions, dimension);
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (cache.size() >= MAX_CACHE_SIZE)
+        cache.clear();
+    cache[hash] = {source, program};
+
+    return program;
+}
+
+std::shared_ptr<ExpressionProgram const> ExpressionCompiler::Build(
+    std::vector<std::string> const &expressions,
+    size_t                          dimension)
+{
+    if (expressions.empty())
+        throw std::runtime_error("Empty system of equations");
+
+    size_t n = dimension;
+    ExpressionGraph graph(n);
+
+    std::vector<int> roots;
+    for (auto const &expression : expressions)
+        roots.push_back(Parser(expression, graph).Parse());
+
+    auto program = std::make_shared<ExpressionProgram>();
+    program->dimension = n;
+    program->parameterNames = graph.parameterNames;
+
+    auto const &nodes = graph.nodes;
+
+    // Отмечаем узлы, достижимые из результатов
+    std::vector<bool> used(nodes.size(), false);
+    for (int root : roots)
+        used[root] = true;
+    for (size_t id = nodes.size(); id-- > 0;)
+    {
+        if (!used[id] || nodes[id].kind != NodeKind::Operation)
+            continue;
+        used[nodes[id].a] = true;
+        if (nodes[id].b >= 0)
+            used[nodes[id].b] = true;
+    }
+
+    // Фиксированные регистры: t, y, параметры, затем константы
+    std::vector<uint32_t> location(nodes.size(), 0);
+    std::vector<double> &registers = program->registerTemplate;
+    registers.assign(1 + n + graph.parameterNames.size(), 0.0);
+
+    for (size_t id = 0; id < nodes.size(); ++id)
+    {
+        switch (nodes[id].kind)
+        {
+            case NodeKind::Time:
+                location[id] = 0;
+                break;
+            case NodeKind::Variable:
+                location[id] = program->YRegister(nodes[id].index);
+                break;
+            case NodeKind::Parameter:
+                location[id] = program->ParameterRegister(nodes[id].index);
+                break;
+            case NodeKind::Constant:
+                if (used[id])
+                {
+                    location[id] = static_cast<uint32_t>(registers.size());
+                    registers.push_back(nodes[id].value);
+                }
+                break;
+            case NodeKind::Operation:
+                break;
+        }
+    }
+
+    // Последнее использование каждого узла (узлы упорядочены топологически)
+    size_t const forever = nodes.size();
+    std::vector<size_t> lastUse(nodes.size(), 0);
+    for (size_t id = 0; id < nodes.size(); ++id)
+    {
+        if (!used[id] || nodes[id].kind != NodeKind::Operation)
+            continue;
+        lastUse[nodes[id].a] = id;
+        if (nodes[id].b >= 0)
+            lastUse[nodes[id].b] = id;
+    }
+    for (int root : roots)
+        lastUse[root] = forever;
+
+    // Распределение временных регистров с повторным использованием освободившихся
+    size_t const firstTemporary = registers.size();
+    size_t temporaryCount = 0;
+    std::vector<uint32_t> freeRegisters;
+
+    auto release = [&](int id, size_t at)
+    {
+        if (nodes[id].kind == NodeKind::Operation && lastUse[id] == at)
+            freeRegisters.push_back(location[id]);
+    };
+
+    for (size_t id = 0; id < nodes.size(); ++id)
+    {
+        Node const &node = nodes[id];
+        if (!used[id] || node.kind != NodeKind::Operation)
+            continue;
+
+        ExpressionProgram::Instruction ins;
+        ins.op = node.op;
+        ins.a = location[node.a];
+        ins.b = IsUnary(node.op) ? ins.a : location[node.b];
+
+        release(node.a, id);
+        if (node.b >= 0 && node.b != node.a)
+            release(node.b, id);
+
+        if (!freeRegisters.empty())
+        {
+            location[id] = freeRegisters.back();
+            freeRegisters.pop_back();
+        }
+        else
+        {
+            location[id] = static_cast<uint32_t>(firstTemporary + temporaryCount++);
+        }
+
+        ins.dst = location[id];
+        program->code.push_back(ins);
+    }
+
+    registers.resize(firstTemporary + temporaryCount, 0.0);
+
+    for (int root : roots)
+        program->outputs.push_back(location[root]);
+
+    return program;
+}
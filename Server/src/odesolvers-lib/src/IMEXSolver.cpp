@@ -0,0 +1,222 @@
+#include "../include/IMEXSolver.hpp"
+
+double IMEXSolver::Norm(std::vector<double> const &v) const
+{
+    return tolerances.Norm(v, scale);
+}
+
+bool IMEXSolver::SolveStage(
+    double                     t,
+    double                     h,
+    std::vector<double> const &r,
+    std::vector<double>       &Y,
+    std::vector<double>       &fi)
+{
+    double gamma = h * GAMMA;
+    std::vector<double> delta(n);
+
+    // Как в RADAU5: оценка скорости сходимости переносится с прошлых стадий,
+    // поэтому для линейной жёсткой части обычно хватает одной итерации
+    double rate = std::pow(std::max(eta, std::numeric_limits<double>::epsilon()), 0.8);
+    double delOld = 0.0;
+
+    for (int m = 0; m < MAX_NEWTON; ++m)
+    {
+        fi = f(t, Y);
+        for (size_t i = 0; i < n; ++i)
+            delta[i] = r[i] + gamma * fi[i] - Y[i];
+        linear->Solve(delta);
+        for (size_t i = 0; i < n; ++i)
+            Y[i] += delta[i];
+
+        double del = Norm(delta);
+        if (m > 0)
+        {
+            double theta = del / delOld;
+            if (theta >= 0.99)
+                return false;
+            rate = theta / (1.0 - theta);
+        }
+
+        if (rate * del <= NEWTON_TOL)
+        {
+            eta = rate;
+            fi = f(t, Y);
+            return true;
+        }
+
+        delOld = del;
+    }
+
+    return false;
+}
+
+bool IMEXSolver::TryStep(
+    double              &t,
+    std::vector<double> &y,
+    double              &h,
+    double               tolerance)
+{
+    if (needJacobian)
+    {
+        J = JacobianCsr(t, y, nullptr, tolerance);
+        needJacobian = false;
+        jacobianCurrent = true;
+        jacobianAge = 0;
+        gammaFactored = 0.0;
+    }
+
+    double gamma = h * GAMMA;
+    if (gammaFactored == 0.0 || std::fabs(gamma / gammaFactored - 1.0) > GAMMA_CHANGE)
+    {
+        if (!linear->Factorize(J, gamma))
+        {
+            gammaFactored = 0.0;
+            h *= 0.5;
+            return false;
+        }
+        gammaFactored = gamma;
+    }
+
+    tolerances.Scales(tolerance, y, y, scale);
+
+    // Стадия 1 явная для обеих частей
+    std::vector<double> fi1 = f(t, y);
+    std::vector<double> fe1 = rhs(t, y);
+    for (size_t i = 0; i < n; ++i)
+        fe1[i] -= fi1[i];
+
+    // Стадия 2: начальное приближение - с производной жёсткой части в начале шага
+    std::vector<double> r(n), Y2(n), fi2;
+    for (size_t i = 0; i < n; ++i)
+    {
+        r[i] = y[i] + h * (E21 * fe1[i] + I21 * fi1[i]);
+        Y2[i] = r[i] + gamma * fi1[i];
+    }
+
+    bool converged = SolveStage(t + C2 * h, h, r, Y2, fi2);
+
+    std::vector<double> Y3(n), fi3, fe2, fe3;
+    if (converged)
+    {
+        fe2 = rhs(t + C2 * h, Y2);
+        for (size_t i = 0; i < n; ++i)
+        {
+            fe2[i] -= fi2[i];
+            r[i] = y[i] + h * (E31 * fe1[i] + E32 * fe2[i] + I31 * fi1[i] + I32 * fi2[i]);
+            Y3[i] = r[i] + gamma * fi2[i];
+        }
+
+        converged = SolveStage(t + C2 * h, h, r, Y3, fi3);
+    }
+
+    if (!converged)
+    {
+        // Сначала обновляется устаревшая матрица Якоби, затем уменьшается шаг
+        if (jacobianCurrent)
+            h *= 0.5;
+        needJacobian = true;
+        eta = 1.0;
+        return false;
+    }
+
+    fe3 = rhs(t + C2 * h, Y3);
+    for (size_t i = 0; i < n; ++i)
+        fe3[i] -= fi3[i];
+
+    // Оценка погрешности по разности производных стадий 2 и 3 (как в DISPS23),
+    // сглаженная разложением (I - h*GAMMA*J) для жёстких компонент
+    std::vector<double> e(n);
+    double stageDiff = 0.0;
+    double explicitDiff = 0.0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        e[i] = ERROR_FACTOR * h * (fe3[i] + fi3[i] - fe2[i] - fi2[i]);
+        stageDiff += (Y3[i] - Y2[i]) * (Y3[i] - Y2[i]);
+        explicitDiff += (fe3[i] - fe2[i]) * (fe3[i] - fe2[i]);
+    }
+    linear->Solve(e);
+    double err = Norm(e);
+
+    // Ограничение устойчивости явной части: h*rho(J_explicit) не больше интервала DISPS23
+    double hStab = 0.0;
+    if (stageDiff > 0.0 && explicitDiff > 0.0)
+    {
+        double rho = std::sqrt(explicitDiff / stageDiff);
+        hStab = SAFETY * STABILITY_BOUND / rho;
+    }
+
+    if (err > 1.0)
+    {
+        h = StepSizeController::Limit(h * controller.Reject(err, 3.0), hStab);
+        return false;
+    }
+
+    double hNew = StepSizeController::Limit(h * controller.Accept(err, 3.0), hStab);
+
+    for (size_t i = 0; i < n; ++i)
+        y[i] += h * (B1 * (fe1[i] + fi1[i]) + B2 * (fe2[i] + fi2[i]) + B3 * (fe3[i] + fi3[i]));
+    t += h;
+    h = hNew;
+
+    jacobianCurrent = false;
+    if (++jacobianAge >= JACOBIAN_AGE)
+        needJacobian = true;
+
+    return true;
+}
+
+void IMEXSolver::Step(
+    double               t,
+    std::vector<double> &y,
+    double              &hStep,
+    double               tolerance)
+{
+    Storage local;
+    Solve(t, y, t + hStep, local, tolerance);
+    y = local[local.Size() - 1].second;
+}
+
+void IMEXSolver::Solve(
+    double                     t0,
+    std::vector<double> const &y0,
+    double                     tEnd,
+    Storage                   &storage,
+    double                     tolerance)
+{
+    double t = t0;
+    std::vector<double> y = y0;
+    // Начальный шаг оценивается по полной правой части
+    double h = stepSize > 0.0 ? stepSize : EstimateInitialStep(rhs, t, y, rhs(t, y), tEnd, tolerance, 2, tolerances);
+
+    n = y.size();
+    scale.resize(n);
+    eta = 1.0;
+    gammaFactored = 0.0;
+    controller.Reset();
+
+    J = JacobianCsr(t, y, nullptr, tolerance);
+    needJacobian = false;
+    jacobianCurrent = true;
+    jacobianAge = 0;
+    linear = MakeLinearSolver(linearSolverKind, J.pattern);
+
+    storage.Add(t, y);
+
+    while (t < tEnd && !storage.Stopped())
+    {
+        bool last = t + h >= tEnd;
+        if (last)
+            h = tEnd - t;
+
+        if (h <= 10.0 * std::numeric_limits<double>::epsilon() * std::max(1.0, std::fabs(t)))
+            throw std::runtime_error("IMEX: step size too small");
+
+        if (TryStep(t, y, h, tolerance))
+        {
+            if (last)
+                t = tEnd;
+            storage.Add(t, y);
+        }
+    }
+}
@@ -0,0 +1,149 @@
+#include "../include/Krylov.hpp"
+
+#include <cmath>
+
+namespace
+{
+    double Dot(
+        std::vector<double> const &a,
+        std::vector<double> const &b,
+        std::vector<double> const &weights)
+    {
+        double sum = 0.0;
+        for (size_t i = 0; i < a.size(); ++i)
+            sum += a[i] * b[i] * weights[i] * weights[i];
+        return sum / a.size();
+    }
+}
+
+GmresResult Gmres(
+    std::function<void(std::vector<double> const &, std::vector<double> &)> const &multiply,
+    std::function<void(std::vector<double> &)> const                              &precondition,
+    std::vector<double> const                                                     &b,
+    std::vector<double>                                                           &x,
+    std::vector<double> const                                                     &weights,
+    double                                                                         tolerance,
+    size_t                                                                         restart,
+    size_t                                                                         maxRestarts)
+{
+    size_t n = b.size();
+    GmresResult result;
+    x.assign(n, 0.0);
+
+    std::vector<double> r = b;
+    double beta = std::sqrt(Dot(r, r, weights));
+    result.residual = beta;
+    if (beta <= tolerance)
+    {
+        result.converged = true;
+        return result;
+    }
+
+    std::vector<std::vector<double>> V(restart + 1, std::vector<double>(n));
+    std::vector<std::vector<double>> H(restart + 1, std::vector<double>(restart, 0.0));
+    std::vector<double> cs(restart), sn(restart), g(restart + 1), y(restart);
+    std::vector<double> w(n), z(n);
+
+    for (size_t cycle = 0; cycle <= maxRestarts; ++cycle)
+    {
+        for (size_t i = 0; i < n; ++i)
+            V[0][i] = r[i] / beta;
+        std::fill(g.begin(), g.end(), 0.0);
+        g[0] = beta;
+
+        size_t k = 0;
+        while (k < restart)
+        {
+            z = V[k];
+            if (precondition)
+                precondition(z);
+            multiply(z, w);
+            ++result.iterations;
+
+            // Модифицированный процесс Грама-Шмидта
+            for (size_t i = 0; i <= k; ++i)
+            {
+                H[i][k] = Dot(w, V[i], weights);
+                for (size_t p = 0; p < n; ++p)
+                    w[p] -= H[i][k] * V[i][p];
+            }
+            H[k + 1][k] = std::sqrt(Dot(w, w, weights));
+
+            // Вращения Гивенса приводят H к верхнетреугольному виду
+            for (size_t i = 0; i < k; ++i)
+            {
+                double t = cs[i] * H[i][k] + sn[i] * H[i + 1][k];
+                H[i + 1][k] = -sn[i] * H[i][k] + cs[i] * H[i + 1][k];
+                H[i][k] = t;
+            }
+            double denom = std::hypot(H[k][k], H[k + 1][k]);
+            bool breakdown = denom == 0.0 || H[k + 1][k] == 0.0;
+            if (denom == 0.0)
+            {
+                cs[k] = 1.0;
+                sn[k] = 0.0;
+            }
+            else
+            {
+                cs[k] = H[k][k] / denom;
+                sn[k] = H[k + 1][k] / denom;
+            }
+
+            double next = H[k + 1][k];
+            H[k][k] = cs[k] * H[k][k] + sn[k] * next;
+            H[k + 1][k] = 0.0;
+            g[k + 1] = -sn[k] * g[k];
+            g[k] = cs[k] * g[k];
+
+            if (!breakdown)
+                for (size_t p = 0; p < n; ++p)
+                    V[k + 1][p] = w[p] / next;
+
+            ++k;
+            result.residual = std::fabs(g[k]);
+            if (result.residual <= tolerance || breakdown)
+                break;
+        }
+
+        // Обратная подстановка и обновление решения x += M^{-1} V y
+        for (size_t i = k; i-- > 0;)
+        {
+            double sum = g[i];
+            for (size_t j = i + 1; j < k; ++j)
+                sum -= H[i][j] * y[j];
+            y[i] = H[i][i] != 0.0 ? sum / H[i][i] : 0.0;
+        }
+
+        std::fill(z.begin(), z.end(), 0.0);
+        for (size_t j = 0; j < k; ++j)
+            for (size_t p = 0; p < n; ++p)
+                z[p] += y[j] * V[j][p];
+        if (precondition)
+            precondition(z);
+        for (size_t p = 0; p < n; ++p)
+            x[p] += z[p];
+
+        if (result.residual <= tolerance)
+        {
+            result.converged = true;
+            return result;
+        }
+        if (cycle == maxRestarts)
+            break;
+
+        // Перезапуск с истинной невязкой
+        multiply(x, w);
+        ++result.iterations;
+        for (size_t p = 0; p < n; ++p)
+            r[p] = b[p] - w[p];
+        beta = std::sqrt(Dot(r, r, weights));
+        result.residual = beta;
+        if (beta <= tolerance)
+        {
+            result.converged = true;
+            return result;
+        }
+    }
+
+    return result;
+}
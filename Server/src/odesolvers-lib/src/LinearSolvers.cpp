@@ -0,0 +1,401 @@
+#include "../include/LinearSolvers.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <queue>
+#include <stdexcept>
+
+LinearSolverKind ParseLinearSolverKind(std::string const &name)
+{
+    if (name.empty() || name == "Auto")
+        return LinearSolverKind::Auto;
+    if (name == "Dense")
+        return LinearSolverKind::Dense;
+    if (name == "Banded")
+        return LinearSolverKind::Banded;
+    if (name == "Sparse")
+        return LinearSolverKind::Sparse;
+    if (name == "Krylov")
+        return LinearSolverKind::Krylov;
+
+    throw std::runtime_error("Unknown linear solver: " + name);
+}
+
+void Bandwidth(
+    CsrPattern const &pattern,
+    size_t           &lower,
+    size_t           &upper)
+{
+    lower = 0;
+    upper = 0;
+    for (size_t i = 0; i < pattern.n; ++i)
+    {
+        for (size_t k = pattern.rowPtr[i]; k < pattern.rowPtr[i + 1]; ++k)
+        {
+            size_t j = pattern.colIndex[k];
+            if (j < i)
+                lower = std::max(lower, i - j);
+            else
+                upper = std::max(upper, j - i);
+        }
+    }
+}
+
+std::unique_ptr<LinearSolver> MakeLinearSolver(
+    LinearSolverKind  kind,
+    CsrPattern const &pattern)
+{
+    size_t lower, upper;
+    Bandwidth(pattern, lower, upper);
+
+    if (kind == LinearSolverKind::Auto)
+    {
+        // Малые системы - плотное разложение, узкая лента - ленточное,
+        // остальное (например, двумерные сетки) - разреженное
+        if (pattern.n <= 64)
+            kind = LinearSolverKind::Dense;
+        else if (2 * lower + upper + 1 <= 32)
+            kind = LinearSolverKind::Banded;
+        else
+            kind = LinearSolverKind::Sparse;
+    }
+
+    switch (kind)
+    {
+        case LinearSolverKind::Dense:
+            return std::make_unique<DenseLinearSolver>();
+        case LinearSolverKind::Banded:
+            return std::make_unique<BandedLinearSolver>(lower, upper);
+        case LinearSolverKind::Sparse:
+            return std::make_unique<SparseLinearSolver>(pattern);
+        default:
+            throw std::runtime_error("Krylov solver has no factorization");
+    }
+}
+
+bool DenseLinearSolver::Factorize(
+    CsrMatrix const &J,
+    double           gamma)
+{
+    size_t n = J.pattern.n;
+    std::vector<double> m(n * n, 0.0);
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t k = J.pattern.rowPtr[i]; k < J.pattern.rowPtr[i + 1]; ++k)
+            m[i * n + J.pattern.colIndex[k]] = -gamma * J.values[k];
+        m[i * n + i] += 1.0;
+    }
+
+    return lu.Factorize(std::move(m), n);
+}
+
+bool BandedLinearSolver::Factorize(
+    CsrMatrix const &J,
+    double           gamma)
+{
+    n = J.pattern.n;
+    width = 2 * kl + ku + 1;
+    band.assign(n * width, 0.0);
+    pivots.resize(n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t k = J.pattern.rowPtr[i]; k < J.pattern.rowPtr[i + 1]; ++k)
+        {
+            size_t j = J.pattern.colIndex[k];
+            if (j + kl < i || j > i + ku)
+                throw std::runtime_error("Banded solver: Jacobian entry outside the band");
+            At(i, j) = -gamma * J.values[k];
+        }
+        At(i, i) += 1.0;
+    }
+
+    for (size_t k = 0; k < n; ++k)
+    {
+        size_t last = std::min(n - 1, k + kl);
+        size_t lastColumn = std::min(n - 1, k + ku + kl);
+
+        size_t p = k;
+        double best = std::fabs(At(k, k));
+        for (size_t i = k + 1; i <= last; ++i)
+        {
+            if (std::fabs(At(i, k)) > best)
+            {
+                best = std::fabs(At(i, k));
+                p = i;
+            }
+        }
+
+        pivots[k] = p;
+        if (best == 0.0)
+            return false;
+
+        // Меняются только элементы от столбца k: множители прошлых шагов остаются
+        // на месте, поэтому при решении перестановки чередуются с прямым ходом
+        if (p != k)
+            for (size_t j = k; j <= lastColumn; ++j)
+                std::swap(At(k, j), At(p, j));
+
+        double inv = 1.0 / At(k, k);
+        for (size_t i = k + 1; i <= last; ++i)
+        {
+            double m = At(i, k) * inv;
+            At(i, k) = m;
+            if (m == 0.0)
+                continue;
+            for (size_t j = k + 1; j <= lastColumn; ++j)
+                At(i, j) -= m * At(k, j);
+        }
+    }
+
+    return true;
+}
+
+void BandedLinearSolver::Solve(std::vector<double> &b) const
+{
+    for (size_t k = 0; k < n; ++k)
+    {
+        if (pivots[k] != k)
+            std::swap(b[k], b[pivots[k]]);
+
+        // Множитель строки i хранится в столбце k: смещение k + kl - i от начала строки
+        size_t last = std::min(n - 1, k + kl);
+        double bk = b[k];
+        for (size_t i = k + 1; i <= last; ++i)
+            b[i] -= band[i * width + (k + kl - i)] * bk;
+    }
+
+    for (size_t k = n; k-- > 0;)
+    {
+        size_t count = std::min(n - 1, k + ku + kl) - k;
+        double const *row = band.data() + k * width + kl; // row[j - k] = U[k][j]
+        double const *x = b.data() + k;
+        double sum = x[0];
+        for (size_t j = 1; j <= count; ++j)
+            sum -= row[j] * x[j];
+        b[k] = sum / row[0];
+    }
+}
+
+SparseLinearSolver::SparseLinearSolver(CsrPattern const &pattern)
+{
+    Symbolic(pattern);
+}
+
+std::vector<size_t> MinimumDegreeOrder(CsrPattern const &pattern)
+{
+    size_t n = pattern.n;
+
+    // Граф симметризованной структуры без диагонали
+    std::vector<std::vector<size_t>> adjacency(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t k = pattern.rowPtr[i]; k < pattern.rowPtr[i + 1]; ++k)
+        {
+            size_t j = pattern.colIndex[k];
+            if (j == i)
+                continue;
+            adjacency[i].push_back(j);
+            adjacency[j].push_back(i);
+        }
+    }
+    for (auto &neighbours : adjacency)
+    {
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+    }
+
+    using Entry = std::pair<size_t, size_t>; // (степень, вершина)
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    for (size_t i = 0; i < n; ++i)
+        heap.emplace(adjacency[i].size(), i);
+
+    std::vector<bool> eliminated(n, false);
+    std::vector<size_t> order;
+    order.reserve(n);
+    std::vector<size_t> merged;
+
+    while (!heap.empty())
+    {
+        auto [degree, v] = heap.top();
+        heap.pop();
+        if (eliminated[v] || degree != adjacency[v].size())
+            continue; // Устаревшая запись
+
+        // Исключение v: её соседи образуют клику
+        eliminated[v] = true;
+        order.push_back(v);
+        std::vector<size_t> clique = std::move(adjacency[v]);
+
+        for (size_t u : clique)
+        {
+            merged.clear();
+            std::set_union(adjacency[u].begin(), adjacency[u].end(),
+                           clique.begin(), clique.end(), std::back_inserter(merged));
+            merged.erase(std::remove_if(merged.begin(), merged.end(),
+                                        [&](size_t w) { return w == u || w == v; }),
+                         merged.end());
+            adjacency[u].swap(merged);
+            heap.emplace(adjacency[u].size(), u);
+        }
+    }
+
+    return order;
+}
+
+void SparseLinearSolver::Symbolic(CsrPattern const &pattern)
+{
+    size_t n = pattern.n;
+
+    // Строки и столбцы переставляются в порядке минимальной степени
+    permutation = MinimumDegreeOrder(pattern);
+    std::vector<size_t> inverse(n);
+    for (size_t i = 0; i < n; ++i)
+        inverse[permutation[i]] = i;
+
+    CsrPattern permuted;
+    permuted.n = n;
+    permuted.rowPtr.assign(n + 1, 0);
+    for (size_t i = 0; i < n; ++i)
+    {
+        size_t source = permutation[i];
+        size_t start = permuted.colIndex.size();
+        for (size_t k = pattern.rowPtr[source]; k < pattern.rowPtr[source + 1]; ++k)
+            permuted.colIndex.push_back(inverse[pattern.colIndex[k]]);
+        std::sort(permuted.colIndex.begin() + start, permuted.colIndex.end());
+        permuted.rowPtr[i + 1] = permuted.colIndex.size();
+    }
+
+    CsrPattern &fill = lu.pattern;
+    fill.n = n;
+    fill.rowPtr.assign(n + 1, 0);
+    fill.colIndex.clear();
+    diagonal.assign(n, 0);
+
+    // Структура строки i множителей LU: столбцы строки J и столбцы строк U,
+    // на которые опираются её ненулевые элементы левее диагонали
+    std::vector<size_t> marker(n, n);
+    std::vector<size_t> row;
+    std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> pending;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        row.clear();
+        auto visit = [&](size_t j)
+        {
+            if (marker[j] == i)
+                return;
+            marker[j] = i;
+            row.push_back(j);
+            if (j < i)
+                pending.push(j);
+        };
+
+        visit(i);
+        for (size_t k = permuted.rowPtr[i]; k < permuted.rowPtr[i + 1]; ++k)
+            visit(permuted.colIndex[k]);
+
+        while (!pending.empty())
+        {
+            size_t k = pending.top();
+            pending.pop();
+            for (size_t p = diagonal[k] + 1; p < fill.rowPtr[k + 1]; ++p)
+                visit(fill.colIndex[p]);
+        }
+
+        std::sort(row.begin(), row.end());
+        size_t start = fill.colIndex.size();
+        fill.colIndex.insert(fill.colIndex.end(), row.begin(), row.end());
+        fill.rowPtr[i + 1] = fill.colIndex.size();
+        diagonal[i] = start + (std::lower_bound(row.begin(), row.end(), i) - row.begin());
+    }
+
+    // Позиции элементов J (в исходной нумерации) в структуре LU
+    sourcePos.resize(pattern.NonZeros());
+    for (size_t i = 0; i < n; ++i)
+    {
+        size_t target = inverse[i];
+        auto begin = fill.colIndex.begin() + fill.rowPtr[target];
+        auto end = fill.colIndex.begin() + fill.rowPtr[target + 1];
+        for (size_t k = pattern.rowPtr[i]; k < pattern.rowPtr[i + 1]; ++k)
+            sourcePos[k] = std::lower_bound(begin, end, inverse[pattern.colIndex[k]]) - fill.colIndex.begin();
+    }
+
+    lu.values.assign(fill.NonZeros(), 0.0);
+    work.assign(n, 0.0);
+}
+
+bool SparseLinearSolver::Factorize(
+    CsrMatrix const &J,
+    double           gamma)
+{
+    if (J.pattern.n != lu.pattern.n || J.pattern.NonZeros() != sourcePos.size())
+        Symbolic(J.pattern);
+
+    CsrPattern const &p = lu.pattern;
+    std::fill(lu.values.begin(), lu.values.end(), 0.0);
+    for (size_t k = 0; k < J.values.size(); ++k)
+        lu.values[sourcePos[k]] = -gamma * J.values[k];
+    for (size_t i = 0; i < p.n; ++i)
+        lu.values[diagonal[i]] += 1.0;
+
+    // Построчное исключение (вариант IKJ): строка i приводится строками U выше неё
+    for (size_t i = 0; i < p.n; ++i)
+    {
+        for (size_t k = p.rowPtr[i]; k < p.rowPtr[i + 1]; ++k)
+            work[p.colIndex[k]] = lu.values[k];
+
+        for (size_t k = p.rowPtr[i]; k < diagonal[i]; ++k)
+        {
+            size_t col = p.colIndex[k];
+            double m = work[col] / lu.values[diagonal[col]];
+            work[col] = m;
+            if (m == 0.0)
+                continue;
+            for (size_t q = diagonal[col] + 1; q < p.rowPtr[col + 1]; ++q)
+                work[p.colIndex[q]] -= m * lu.values[q];
+        }
+
+        for (size_t k = p.rowPtr[i]; k < p.rowPtr[i + 1]; ++k)
+        {
+            lu.values[k] = work[p.colIndex[k]];
+            work[p.colIndex[k]] = 0.0;
+        }
+
+        if (lu.values[diagonal[i]] == 0.0)
+            return false;
+    }
+
+    return true;
+}
+
+void SparseLinearSolver::Solve(std::vector<double> &b) const
+{
+    CsrPattern const &p = lu.pattern;
+
+    for (size_t i = 0; i < p.n; ++i)
+        work[i] = b[permutation[i]];
+
+    for (size_t i = 0; i < p.n; ++i)
+    {
+        double sum = work[i];
+        for (size_t k = p.rowPtr[i]; k < diagonal[i]; ++k)
+            sum -= lu.values[k] * work[p.colIndex[k]];
+        work[i] = sum;
+    }
+
+    for (size_t i = p.n; i-- > 0;)
+    {
+        double sum = work[i];
+        for (size_t k = diagonal[i] + 1; k < p.rowPtr[i + 1]; ++k)
+            sum -= lu.values[k] * work[p.colIndex[k]];
+        work[i] = sum / lu.values[diagonal[i]];
+    }
+
+    for (size_t i = 0; i < p.n; ++i)
+    {
+        b[permutation[i]] = work[i];
+        work[i] = 0.0;
+    }
+}
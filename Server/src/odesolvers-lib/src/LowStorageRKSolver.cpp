@@ -0,0 +1,211 @@
+#include "../include/LowStorageRKSolver.hpp"
+
+namespace
+{
+    // Уильямсон (1980), 3 стадии, 3-й порядок. Вложенный метод 2-го порядка
+    // b^ = b - 6/5 (-5/9, 1, -4/9): его веса при k_1, k_2 пропорциональны dQ_2, поэтому
+    // оценка 6/5 dQ_2 - 8/15 h k_3 считается на последней стадии без отдельного регистра
+    LowStorageTableau Williamson32()
+    {
+        LowStorageTableau t;
+        t.name = "LSRK3";
+        t.order = 3;
+        t.errorOrder = 2;
+        t.A = { 0.0, -5.0 / 9.0, -153.0 / 128.0 };
+        t.B = { 1.0 / 3.0, 15.0 / 16.0, 8.0 / 15.0 };
+        t.c = { 0.0, 1.0 / 3.0, 3.0 / 4.0 };
+        t.e = { 0.0, 0.0, -8.0 / 15.0 };
+        t.increment = 6.0 / 5.0;
+        return t;
+    }
+
+    // Карпентер, Кеннеди (1994), RK4(3)5[2N]: 5 стадий, 4-й порядок. Вложенный метод 3-го
+    // порядка с b^_2 = 0; оценка e = b - b^
+    LowStorageTableau CarpenterKennedy43()
+    {
+        LowStorageTableau t;
+        t.name = "LSRK4";
+        t.order = 4;
+        t.errorOrder = 3;
+        t.A = {
+            0.0,
+            -567301805773.0 / 1357537059087.0,
+            -2404267990393.0 / 2016746695238.0,
+            -3550918686646.0 / 2091501179385.0,
+            -1275806237668.0 / 842570457699.0
+        };
+        t.B = {
+            1432997174477.0 / 9575080441755.0,
+            5161836677717.0 / 13612068292357.0,
+            1720146321549.0 / 2090206949498.0,
+            3134564353537.0 / 4481467310338.0,
+            2277821191437.0 / 14882151754819.0
+        };
+        t.c = {
+            0.0,
+            1432997174477.0 / 9575080441755.0,
+            2526269341429.0 / 6820363962896.0,
+            2006345519317.0 / 3224310063776.0,
+            2802321613138.0 / 2924317926251.0
+        };
+        t.e = {
+            -0.16033435641008234,
+            0.34474304234056707,
+            -0.24407312659415953,
+            0.054651527079573693,
+            0.0050129135841011242
+        };
+        return t;
+    }
+}
+
+std::vector<std::string> LowStorageSchemes()
+{
+    return { "LSRK3", "LSRK4" };
+}
+
+LowStorageTableau LowStorageScheme(std::string const &name)
+{
+    if (name == "LSRK3")
+        return Williamson32();
+    if (name == "LSRK4")
+        return CarpenterKennedy43();
+    throw std::runtime_error("Unknown low-storage scheme: " + name);
+}
+
+bool LowStorageRKSolver::ErrorRegister() const
+{
+    for (size_t i = 0; i + 1 < tableau.e.size(); ++i)
+    {
+        if (tableau.e[i] != 0.0)
+            return true;
+    }
+    return false;
+}
+
+double LowStorageRKSolver::TryStep(
+    double                     t,
+    std::vector<double> const &y,
+    double                     h,
+    double                     tolerance)
+{
+    size_t const n = y.size();
+    size_t const s = tableau.c.size();
+    bool const accumulate = !error.empty();
+
+    stage = y;
+    double *S = stage.data();
+    double *dQ = increment.data();
+    double *E = error.data();
+
+    for (size_t i = 0; i + 1 < s; ++i)
+    {
+        std::vector<double> k = f(t + tableau.c[i] * h, stage);
+        double const *kp = k.data();
+        double const a = i == 0 ? 0.0 : tableau.A[i]; // dQ первой стадии не читается
+        double const b = tableau.B[i];
+        double const w = h * tableau.e[i];
+
+        if (accumulate)
+        {
+            for (size_t r = 0; r < n; ++r)
+            {
+                double d = (i == 0 ? 0.0 : a * dQ[r]) + h * kp[r];
+                E[r] = (i == 0 ? 0.0 : E[r]) + w * kp[r];
+                dQ[r] = d;
+                S[r] += b * d;
+            }
+        }
+        else
+        {
+            for (size_t r = 0; r < n; ++r)
+            {
+                double d = (i == 0 ? 0.0 : a * dQ[r]) + h * kp[r];
+                dQ[r] = d;
+                S[r] += b * d;
+            }
+        }
+    }
+
+    // Последняя стадия: решение, оценка погрешности и её норма за один проход; dQ больше не нужен
+    std::vector<double> k = f(t + tableau.c[s - 1] * h, stage);
+    double const *kp = k.data();
+    double const a = tableau.A[s - 1];
+    double const b = tableau.B[s - 1];
+    double const w = h * tableau.e[s - 1];
+    double const g = tableau.increment;
+
+    double sum = 0.0;
+    double max = 0.0;
+    for (size_t r = 0; r < n; ++r)
+    {
+        double estimate = g * dQ[r] + w * kp[r] + (accumulate ? E[r] : 0.0);
+        S[r] += b * (a * dQ[r] + h * kp[r]);
+
+        double ratio = std::fabs(estimate) / tolerances.Scale(r, tolerance, y[r], S[r]);
+        sum += ratio * ratio;
+        max = std::max(max, ratio);
+    }
+
+    if (n == 0)
+        return 0.0;
+    return tolerances.NormKind() == ErrorNormKind::Max ? max : std::sqrt(sum / n);
+}
+
+void LowStorageRKSolver::Step(
+    double               t,
+    std::vector<double> &y,
+    double              &hStep,
+    double               tolerance)
+{
+    Storage local;
+    Solve(t, y, t + hStep, local, tolerance);
+    y = local[local.Size() - 1].second;
+}
+
+void LowStorageRKSolver::Solve(
+    double                     t0,
+    std::vector<double> const &y0,
+    double                     tEnd,
+    Storage                   &storage,
+    double                     tolerance)
+{
+    double t = t0;
+    std::vector<double> y = y0;
+    size_t const n = y.size();
+
+    // Без StartingStep: сохранённая им копия f(t0, y0) заняла бы лишний регистр на всё решение
+    double h = stepSize > 0.0 ? stepSize : EstimateInitialStep(f, t, y, f(t, y), tEnd, tolerance, tableau.order, tolerances);
+    double const errorExponent = tableau.errorOrder + 1.0;
+
+    stage.resize(n);
+    increment.assign(n, 0.0);
+    error.assign(ErrorRegister() ? n : 0, 0.0);
+
+    storage.Add(t, y);
+    controller.Reset();
+
+    while (t < tEnd && !storage.Stopped())
+    {
+        bool lastStep = t + h >= tEnd;
+        if (lastStep)
+            h = tEnd - t;
+
+        if (h <= 10.0 * std::numeric_limits<double>::epsilon() * std::max(1.0, std::fabs(t)))
+            throw std::runtime_error(tableau.name + ": step size too small");
+
+        double err = TryStep(t, y, h, tolerance);
+
+        if (!(err <= 1.0))
+        {
+            h *= controller.Reject(err, errorExponent);
+            continue;
+        }
+
+        t = lastStep ? tEnd : t + h;
+        y.swap(stage);
+        storage.Add(t, y);
+
+        h *= controller.Accept(err, errorExponent);
+    }
+}
@@ -0,0 +1,440 @@
+#include "../include/PhiFunctions.hpp"
+#include "../include/LinearAlgebra.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+std::mutex PhiCache::cacheMutex;
+std::unordered_map<size_t, PhiCache::CacheEntry> PhiCache::cache;
+
+namespace
+{
+    constexpr size_t MAX_KRYLOV  = 40;
+    constexpr double MIN_SUBSTEP = 1e-12;
+    // Порог вырождения Арнольди относительно нормы нового вектора до ортогонализации
+    constexpr double BREAKDOWN   = 1e-10;
+
+    std::vector<double> Multiply(
+        std::vector<double> const &A,
+        std::vector<double> const &B,
+        size_t                     n)
+    {
+        std::vector<double> C(n * n, 0.0);
+        for (size_t i = 0; i < n; ++i)
+            for (size_t k = 0; k < n; ++k)
+            {
+                double a = A[i * n + k];
+                if (a == 0.0)
+                    continue;
+                for (size_t j = 0; j < n; ++j)
+                    C[i * n + j] += a * B[k * n + j];
+            }
+        return C;
+    }
+
+    double Norm2(std::vector<double> const &v)
+    {
+        double sum = 0.0;
+        for (double x : v)
+            sum += x * x;
+        return std::sqrt(sum);
+    }
+}
+
+std::vector<double> Expm(
+    std::vector<double> A,
+    size_t              n)
+{
+    // Масштабирование до ||A / 2^s|| <= 1/2: погрешность Паде (6, 6) порядка 1e-16
+    double norm = 0.0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        double row = 0.0;
+        for (size_t j = 0; j < n; ++j)
+            row += std::fabs(A[i * n + j]);
+        norm = std::max(norm, row);
+    }
+
+    int s = norm > 0.5 ? static_cast<int>(std::ceil(std::log2(norm / 0.5))) : 0;
+    double factor = std::ldexp(1.0, -s);
+    for (double &a : A)
+        a *= factor;
+
+    static double const c[] = { 1.0, 1.0 / 2, 5.0 / 44, 1.0 / 66, 1.0 / 792, 1.0 / 15840, 1.0 / 665280 };
+
+    std::vector<double> X(n * n, 0.0), P(n * n, 0.0), Q(n * n, 0.0);
+    for (size_t i = 0; i < n; ++i)
+        X[i * n + i] = P[i * n + i] = Q[i * n + i] = 1.0;
+
+    for (int k = 1; k <= 6; ++k)
+    {
+        X = Multiply(A, X, n);
+        double sign = (k % 2 == 0) ? 1.0 : -1.0;
+        for (size_t i = 0; i < n * n; ++i)
+        {
+            P[i] += c[k] * X[i];
+            Q[i] += sign * c[k] * X[i];
+        }
+    }
+
+    DenseLU<double> lu;
+    if (!lu.Factorize(Q, n))
+        throw std::runtime_error("Expm: singular Pade denominator");
+
+    std::vector<double> E(n * n), column(n);
+    for (size_t j = 0; j < n; ++j)
+    {
+        for (size_t i = 0; i < n; ++i)
+            column[i] = P[i * n + j];
+        lu.Solve(column);
+        for (size_t i = 0; i < n; ++i)
+            E[i * n + j] = column[i];
+    }
+
+    for (int i = 0; i < s; ++i)
+        E = Multiply(E, E, n);
+
+    return E;
+}
+
+std::vector<std::vector<double>> PhiMatrices(
+    std::vector<double> const &A,
+    size_t                     n,
+    size_t                     p)
+{
+    size_t N = (p + 1) * n;
+    std::vector<double> W(N * N, 0.0);
+    for (size_t i = 0; i < n; ++i)
+        std::memcpy(&W[i * N], &A[i * n], n * sizeof(double));
+    for (size_t k = 0; k < p; ++k)
+        for (size_t i = 0; i < n; ++i)
+            W[(k * n + i) * N + (k + 1) * n + i] = 1.0;
+
+    std::vector<double> E = Expm(std::move(W), N);
+
+    std::vector<std::vector<double>> phi(p + 1, std::vector<double>(n * n));
+    for (size_t k = 0; k <= p; ++k)
+        for (size_t i = 0; i < n; ++i)
+            std::memcpy(&phi[k][i * n], &E[i * N + k * n], n * sizeof(double));
+
+    return phi;
+}
+
+std::vector<double> PhiKrylov(
+    std::function<void(std::vector<double> const &, std::vector<double> &)> const &multiply,
+    double                                                                         h,
+    std::vector<std::vector<double>> const                                        &v,
+    double                                                                         tolerance)
+{
+    size_t n = v[0].size();
+    size_t p = v.size() - 1;
+    size_t N = n + p;
+
+    // W = [v_p, ..., v_1] / eta: столбцы нормируются, чтобы части расширенного вектора были соизмеримы
+    double eta = 0.0;
+    for (size_t k = 1; k <= p; ++k)
+        eta = std::max(eta, Norm2(v[k]));
+    if (eta == 0.0)
+        eta = 1.0;
+
+    std::vector<double> x(N, 0.0);
+    std::copy(v[0].begin(), v[0].end(), x.begin());
+    if (p > 0)
+        x[n + p - 1] = eta;
+
+    std::vector<double> top(n), product(n);
+    auto augmented = [&](std::vector<double> const &in, std::vector<double> &out)
+    {
+        std::copy(in.begin(), in.begin() + n, top.begin());
+        multiply(top, product);
+        for (size_t i = 0; i < n; ++i)
+            out[i] = h * product[i];
+        for (size_t j = 0; j < p; ++j)
+        {
+            double s = in[n + j] / eta;
+            if (s == 0.0)
+                continue;
+            std::vector<double> const &column = v[p - j];
+            for (size_t i = 0; i < n; ++i)
+                out[i] += s * column[i];
+        }
+        for (size_t j = 0; j < p; ++j)
+            out[n + j] = j + 1 < p ? in[n + j + 1] : 0.0;
+    };
+
+    std::vector<std::vector<double>> V(MAX_KRYLOV + 1, std::vector<double>(N));
+    std::vector<double> H((MAX_KRYLOV + 1) * MAX_KRYLOV);
+    std::vector<double> w(N);
+
+    double done = 0.0;
+    double tau = 1.0;
+    while (done < 1.0)
+    {
+        double beta = Norm2(x);
+        if (beta == 0.0)
+            break;
+
+        // Арнольди с модифицированным процессом Грама-Шмидта
+        std::fill(H.begin(), H.end(), 0.0);
+        for (size_t i = 0; i < N; ++i)
+            V[0][i] = x[i] / beta;
+
+        size_t m = 0;
+        double hNext = 0.0;
+        bool breakdown = false;
+        while (m < MAX_KRYLOV && m < N)
+        {
+            augmented(V[m], w);
+            double wNorm = Norm2(w);
+            for (size_t j = 0; j <= m; ++j)
+            {
+                double dot = 0.0;
+                for (size_t i = 0; i < N; ++i)
+                    dot += w[i] * V[j][i];
+                H[j * MAX_KRYLOV + m] = dot;
+                for (size_t i = 0; i < N; ++i)
+                    w[i] -= dot * V[j][i];
+            }
+
+            hNext = Norm2(w);
+            ++m;
+            if (hNext <= BREAKDOWN * wNorm)
+            {
+                breakdown = true; // Подпространство инвариантно: результат точный
+                break;
+            }
+            if (m < MAX_KRYLOV)
+                H[m * MAX_KRYLOV + m - 1] = hNext;
+            for (size_t i = 0; i < N; ++i)
+                V[m][i] = w[i] / hNext;
+        }
+        if (m == N)
+            breakdown = true; // Базис покрывает всё пространство
+
+        // Наибольший подшаг, на котором оценка Саада не превышает допуск
+        tau = std::min(2.0 * tau, 1.0 - done);
+        std::vector<double> Hm(m * m), F;
+        while (true)
+        {
+            for (size_t i = 0; i < m; ++i)
+                for (size_t j = 0; j < m; ++j)
+                    Hm[i * m + j] = tau * H[i * MAX_KRYLOV + j];
+            F = Expm(Hm, m);
+
+            double error = breakdown ? 0.0 : beta * tau * hNext * std::fabs(F[(m - 1) * m]);
+            if (error <= tolerance * beta)
+                break;
+
+            tau *= 0.5;
+            if (tau < MIN_SUBSTEP)
+                throw std::runtime_error("PhiKrylov: substep too small");
+        }
+
+        std::fill(x.begin(), x.end(), 0.0);
+        for (size_t j = 0; j < m; ++j)
+        {
+            double c = beta * F[j * m];
+            for (size_t i = 0; i < N; ++i)
+                x[i] += c * V[j][i];
+        }
+        done += tau;
+    }
+
+    x.resize(n);
+    return x;
+}
+
+std::vector<double> PhiKrylovShiftInvert(
+    std::function<void(std::vector<double> &)> const &solveShifted,
+    std::vector<std::vector<double>> const           &v,
+    double                                            tolerance)
+{
+    size_t n = v[0].size();
+    size_t p = v.size() - 1;
+    size_t N = n + p;
+    double const g = PHI_SHIFT;
+
+    double eta = 0.0;
+    for (size_t k = 1; k <= p; ++k)
+        eta = std::max(eta, Norm2(v[k]));
+    if (eta == 0.0)
+        eta = 1.0;
+
+    std::vector<double> x(N, 0.0);
+    std::copy(v[0].begin(), v[0].end(), x.begin());
+    if (p > 0)
+        x[n + p - 1] = eta;
+
+    // (I - g Ã)^{-1}: нижний блок - обратная подстановка по сдвигу J, верхний - solveShifted
+    std::vector<double> top(n);
+    auto inverse = [&](std::vector<double> const &in, std::vector<double> &out)
+    {
+        for (size_t j = p; j-- > 0;)
+            out[n + j] = in[n + j] + (j + 1 < p ? g * out[n + j + 1] : 0.0);
+
+        std::copy(in.begin(), in.begin() + n, top.begin());
+        for (size_t j = 0; j < p; ++j)
+        {
+            double s = g * out[n + j] / eta;
+            if (s == 0.0)
+                continue;
+            std::vector<double> const &column = v[p - j];
+            for (size_t i = 0; i < n; ++i)
+                top[i] += s * column[i];
+        }
+        solveShifted(top);
+        std::copy(top.begin(), top.end(), out.begin());
+    };
+
+    std::vector<std::vector<double>> V(MAX_KRYLOV + 1, std::vector<double>(N));
+    std::vector<double> H((MAX_KRYLOV + 1) * MAX_KRYLOV);
+    std::vector<double> w(N);
+
+    // Приближение exp(tau Ã) x на подпространстве размерности m: exp(tau (I - H^{-1}) / g) e1
+    auto approximate = [&](size_t m, double tau)
+    {
+        std::vector<double> Hm(m * m);
+        for (size_t i = 0; i < m; ++i)
+            for (size_t j = 0; j < m; ++j)
+                Hm[i * m + j] = H[i * MAX_KRYLOV + j];
+
+        DenseLU<double> lu;
+        if (!lu.Factorize(Hm, m))
+            throw std::runtime_error("PhiKrylovShiftInvert: singular Hessenberg matrix");
+
+        std::vector<double> S(m * m), column(m);
+        for (size_t j = 0; j < m; ++j)
+        {
+            std::fill(column.begin(), column.end(), 0.0);
+            column[j] = 1.0;
+            lu.Solve(column);
+            for (size_t i = 0; i < m; ++i)
+                S[i * m + j] = tau / g * ((i == j ? 1.0 : 0.0) - column[i]);
+        }
+
+        std::vector<double> F = Expm(std::move(S), m);
+        std::vector<double> first(m);
+        for (size_t i = 0; i < m; ++i)
+            first[i] = F[i * m];
+        return first;
+    };
+
+    double done = 0.0;
+    double tau = 1.0;
+    while (done < 1.0)
+    {
+        double beta = Norm2(x);
+        if (beta == 0.0)
+            break;
+
+        std::fill(H.begin(), H.end(), 0.0);
+        for (size_t i = 0; i < N; ++i)
+            V[0][i] = x[i] / beta;
+
+        tau = 1.0 - done;
+        size_t m = 0;
+        bool converged = false;
+        std::vector<double> u, uPrev;
+        while (m < MAX_KRYLOV && m < N)
+        {
+            inverse(V[m], w);
+            double wNorm = Norm2(w);
+            for (size_t j = 0; j <= m; ++j)
+            {
+                double dot = 0.0;
+                for (size_t i = 0; i < N; ++i)
+                    dot += w[i] * V[j][i];
+                H[j * MAX_KRYLOV + m] = dot;
+                for (size_t i = 0; i < N; ++i)
+                    w[i] -= dot * V[j][i];
+            }
+
+            double hNext = Norm2(w);
+            ++m;
+            H[m * MAX_KRYLOV + m - 1] = hNext;
+
+            u = approximate(m, tau);
+            if (hNext <= BREAKDOWN * wNorm)
+            {
+                converged = true; // Подпространство инвариантно: результат точный
+                break;
+            }
+            for (size_t i = 0; i < N; ++i)
+                V[m][i] = w[i] / hNext;
+
+            // Погрешность - по разности приближений соседних размерностей
+            if (m > 1)
+            {
+                double diff = u[m - 1] * u[m - 1];
+                for (size_t i = 0; i + 1 < m; ++i)
+                    diff += (u[i] - uPrev[i]) * (u[i] - uPrev[i]);
+                if (std::sqrt(diff) <= tolerance)
+                {
+                    converged = true;
+                    break;
+                }
+            }
+            uPrev = u;
+        }
+        if (m == N)
+            converged = true; // Базис покрывает всё пространство
+
+        // Базис исчерпан: подшаг, на котором приближения размерностей m - 1 и m согласуются
+        while (!converged)
+        {
+            tau *= 0.5;
+            if (tau < MIN_SUBSTEP)
+                throw std::runtime_error("PhiKrylovShiftInvert: substep too small");
+
+            u = approximate(m, tau);
+            uPrev = approximate(m - 1, tau);
+            double diff = u[m - 1] * u[m - 1];
+            for (size_t i = 0; i + 1 < m; ++i)
+                diff += (u[i] - uPrev[i]) * (u[i] - uPrev[i]);
+            converged = std::sqrt(diff) <= tolerance;
+        }
+
+        std::fill(x.begin(), x.end(), 0.0);
+        for (size_t j = 0; j < m; ++j)
+        {
+            double c = beta * u[j];
+            for (size_t i = 0; i < N; ++i)
+                x[i] += c * V[j][i];
+        }
+        done += tau;
+    }
+
+    x.resize(n);
+    return x;
+}
+
+std::shared_ptr<PhiCache::Matrices const> PhiCache::Get(
+    std::vector<double> const &L,
+    size_t                     n,
+    double                     h)
+{
+    size_t hash = std::hash<double>{}(h);
+    for (double value : L)
+        hash ^= std::hash<double>{}(value) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto it = cache.find(hash);
+        if (it != cache.end() && it->second.h == h && it->second.op == L)
+            return it->second.phi;
+    }
+
+    std::vector<double> A(L.size());
+    for (size_t i = 0; i < L.size(); ++i)
+        A[i] = h * L[i];
+    auto phi = std::make_shared<Matrices const>(PhiMatrices(A, n, 3));
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (cache.size() >= MAX_CACHE_SIZE)
+        cache.clear();
+    cache[hash] = {L, h, phi};
+
+    return phi;
+}
@@ -0,0 +1,255 @@
+#include "../include/PluginManager.hpp"
+
+#include <dlfcn.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    char const *const COMPILER_FLAGS = "-std=c++17 -O3 -march=native -fPIC -shared";
+
+    std::string Compiler()
+    {
+        char const *cxx = std::getenv("CXX");
+        return (cxx && *cxx) ? cxx : "c++";
+    }
+
+    std::vector<std::string> SplitNames(char const *list)
+    {
+        std::vector<std::string> names;
+        std::stringstream stream(list ? list : "");
+        std::string name;
+        while (std::getline(stream, name, ','))
+        {
+            name.erase(0, name.find_first_not_of(" \t"));
+            name.erase(name.find_last_not_of(" \t") + 1);
+            if (!name.empty())
+                names.push_back(name);
+        }
+        return names;
+    }
+}
+
+PluginManager& PluginManager::Instance()
+{
+    static PluginManager instance;
+    return instance;
+}
+
+PluginManager::PluginManager()
+{
+    char const *env = std::getenv("ODE_PLUGIN_DIR");
+    directory = (env && *env) ? env : "plugins";
+
+    char const *compile = std::getenv("ODE_PLUGIN_COMPILE");
+    compilationEnabled = compile && std::string(compile) == "1";
+}
+
+void PluginManager::SetDirectory(std::string const &dir)
+{
+    directory = dir;
+}
+
+uint64_t PluginManager::Hash(std::string const &text)
+{
+    // FNV-1a: хэш стабилен между запусками, в отличие от std::hash
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : text)
+    {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+size_t PluginManager::LoadDirectory()
+{
+    std::error_code ec;
+    if (!fs::is_directory(directory, ec))
+        return 0;
+
+    size_t loaded = 0;
+    for (auto const &entry : fs::directory_iterator(directory, ec))
+    {
+        if (!entry.is_regular_file() || entry.path().extension() != ".so")
+            continue;
+
+        try
+        {
+            Load(entry.path().string());
+            ++loaded;
+        }
+        catch (std::exception const &e)
+        {
+            std::cerr << "Plugin " << entry.path() << " skipped: " << e.what() << std::endl;
+        }
+    }
+
+    // Плагины, откомпилированные до перезапуска, доступны по имени без повторного POST
+    fs::path cacheDir = fs::path(directory) / "cache";
+    for (auto const &[name, key] : ReadIndex())
+    {
+        fs::path library = cacheDir / (key + ".so");
+        try
+        {
+            Load(library.string(), name);
+            ++loaded;
+        }
+        catch (std::exception const &e)
+        {
+            std::cerr << "Plugin " << name << " (" << library << ") skipped: " << e.what() << std::endl;
+        }
+    }
+    return loaded;
+}
+
+std::unordered_map<std::string, std::string> PluginManager::ReadIndex() const
+{
+    std::unordered_map<std::string, std::string> index;
+    std::ifstream in(fs::path(directory) / "cache" / INDEX_FILE);
+    std::string name, key;
+    while (in >> name >> key)
+        index[name] = key;
+    return index;
+}
+
+void PluginManager::WriteIndex(std::unordered_map<std::string, std::string> const &index) const
+{
+    fs::path path = fs::path(directory) / "cache" / INDEX_FILE;
+    fs::path temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream out(temporary);
+        for (auto const &[name, key] : index)
+            out << name << ' ' << key << '\n';
+        if (!out)
+            throw std::runtime_error("Cannot write plugin index " + temporary.string());
+    }
+    fs::rename(temporary, path);
+}
+
+std::shared_ptr<ModelPlugin const> PluginManager::Load(
+    std::string const &path,
+    std::string        name)
+{
+    void *raw = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!raw)
+        throw std::runtime_error(std::string("Cannot load plugin: ") + dlerror());
+
+    auto plugin = std::make_shared<ModelPlugin>();
+    plugin->path = path;
+    plugin->handle = std::shared_ptr<void>(raw, [](void *h) { dlclose(h); });
+    plugin->rhs = reinterpret_cast<PluginRhs>(dlsym(raw, "ode_rhs"));
+    plugin->rhsImplicit = reinterpret_cast<PluginRhs>(dlsym(raw, "ode_rhs_implicit"));
+    plugin->jacobian = reinterpret_cast<PluginJacobian>(dlsym(raw, "ode_jacobian"));
+    plugin->sparsity = reinterpret_cast<PluginSparsity>(dlsym(raw, "ode_sparsity"));
+    plugin->preconditioner = reinterpret_cast<PluginPreconditioner>(dlsym(raw, "ode_preconditioner"));
+
+    if (!plugin->rhs)
+        throw std::runtime_error("Plugin " + path + " does not export ode_rhs");
+
+    if (auto params = reinterpret_cast<char const *const *>(dlsym(raw, "ode_parameters")))
+        plugin->parameterNames = SplitNames(*params);
+
+    if (name.empty())
+    {
+        auto declared = reinterpret_cast<char const *const *>(dlsym(raw, "ode_name"));
+        name = (declared && *declared) ? *declared : fs::path(path).stem().string();
+    }
+    plugin->name = name;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    plugins[name] = plugin;
+    return plugin;
+}
+
+std::shared_ptr<ModelPlugin const> PluginManager::Compile(
+    std::string const &name,
+    std::string const &source)
+{
+    if (!compilationEnabled)
+        throw std::runtime_error("Plugin compilation is disabled (set ODE_PLUGIN_COMPILE=1 on the server)");
+    if (name.empty() || name.find_first_of(" \t\r\n") != std::string::npos)
+        throw std::runtime_error("Plugin name must be non-empty and contain no whitespace");
+
+    std::string const compiler = Compiler();
+
+    std::ostringstream key;
+    key << std::hex << std::setw(16) << std::setfill('0')
+        << Hash(compiler + '\n' + COMPILER_FLAGS + '\n' + source);
+
+    fs::path cacheDir = fs::path(directory) / "cache";
+    fs::path library = cacheDir / (key.str() + ".so");
+
+    // Одна компиляция за раз: параллельные запросы с тем же исходником дождутся кэша
+    std::lock_guard<std::mutex> compileLock(compileMutex);
+
+    if (!fs::exists(library))
+    {
+        fs::create_directories(cacheDir);
+
+        fs::path sourcePath = cacheDir / (key.str() + ".cpp");
+        fs::path temporary = cacheDir / (key.str() + ".so.tmp");
+        {
+            std::ofstream out(sourcePath);
+            out << source;
+            if (!out)
+                throw std::runtime_error("Cannot write plugin source " + sourcePath.string());
+        }
+
+        std::string command = compiler + " " + COMPILER_FLAGS + " -o '" + temporary.string() +
+                              "' '" + sourcePath.string() + "' 2>&1";
+
+        std::string log;
+        FILE *pipe = popen(command.c_str(), "r");
+        if (!pipe)
+            throw std::runtime_error("Cannot start compiler " + compiler);
+
+        char buffer[512];
+        while (fgets(buffer, sizeof(buffer), pipe))
+            log += buffer;
+
+        if (pclose(pipe) != 0)
+        {
+            fs::remove(temporary);
+            throw std::runtime_error("Plugin compilation failed:\n" + log);
+        }
+
+        // Переименование атомарно: в кэше не бывает недописанных библиотек
+        fs::rename(temporary, library);
+    }
+
+    auto plugin = Load(library.string(), name);
+
+    std::unordered_map<std::string, std::string> index = ReadIndex();
+    if (index[name] != key.str())
+    {
+        index[name] = key.str();
+        WriteIndex(index);
+    }
+    return plugin;
+}
+
+std::shared_ptr<ModelPlugin const> PluginManager::Find(std::string const &name) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = plugins.find(name);
+    return it == plugins.end() ? nullptr : it->second;
+}
+
+std::vector<std::string> PluginManager::Names() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<std::string> names;
+    for (auto const &[name, plugin] : plugins)
+        names.push_back(name);
+    return names;
+}
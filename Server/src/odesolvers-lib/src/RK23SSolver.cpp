@@ -13,6 +13,14 @@ void RK23SSolver::Step(
     
     std::vector<double> y2 = AddVectors(y_temp, MultiplyScalarByVector(beta21, k1));
     std::vector<double> k2 = MultiplyScalarByVector(h, f(t + alpha2*h, y2));
+
+    // Условие точности известно после второй стадии: отказ без вычисления k3
+    double error = computePrecisionError(k1, k2, y, tolerance);
+    if (error > tolerance)
+    {
+        h *= controller.Reject(error / tolerance, 3.0);
+        throw std::runtime_error("Step rejected");
+    }
     
     std::vector<double> y3 = AddVectors(
         y_temp,
@@ -24,13 +32,12 @@ void RK23SSolver::Step(
     std::vector<double> k3 = MultiplyScalarByVector(h, f(t + alpha3*h, y3));
     
     // Оценка ошибки
-    double error = computeError(k1, k2, k3, h, tolerance);
+    error = std::max(error, computeStabilityError(k1, k2, k3));
     
     // Адаптация шага
     if (error > tolerance)
     {
-        double scale = std::max(SAFETY * pow(tolerance/error, 1.0/3.0), MIN_SCALE);
-        h *= scale;
+        h *= controller.Reject(error / tolerance, 3.0);
         throw std::runtime_error("Step rejected");
     }
     
@@ -47,22 +54,26 @@ void RK23SSolver::Step(
     );
     
     // Корректировка шага
-    double scale = std::min(SAFETY * pow(tolerance/error, 1.0/3.0), MAX_SCALE);
-    h *= scale;
+    h *= controller.Accept(error / tolerance, 3.0);
     y = y_temp;
 }
 
-double RK23SSolver::computeError(
+double RK23SSolver::computePrecisionError(
     std::vector<double> const &k1,
     std::vector<double> const &k2,
-    std::vector<double> const &k3,
-    double                     h,
+    std::vector<double> const &y,
     double                     tolerance)
 {
     // Условие точности (4.7)
     std::vector<double> diff_k2k1 = SubtractVectors(k2, k1);
-    double err_precision = (6.0 * alpha2 * tolerance) / (1.0 - 6.0*g) * Norm(diff_k2k1);
-    
+    return (6.0 * alpha2 * tolerance) / (1.0 - 6.0*g) * ErrorNorm(diff_k2k1, y, y, tolerance);
+}
+
+double RK23SSolver::computeStabilityError(
+    std::vector<double> const &k1,
+    std::vector<double> const &k2,
+    std::vector<double> const &k3)
+{
     // Условие устойчивости (4.14)
     double stability = 0.0;
     for (size_t i = 0; i < k1.size(); ++i)
@@ -72,7 +83,7 @@ double RK23SSolver::computeError(
         stability = std::max(stability, 3.0 * fabs((k3[i] - k2[i]) / denominator));
     }
     
-    return std::max(err_precision, stability);
+    return stability;
 }
 
 void RK23SSolver::Solve(
@@ -84,10 +95,11 @@ void RK23SSolver::Solve(
 {
     double t = t0;
     std::vector<double> y = y0;
-    double h = stepSize;
+    double h = StartingStep(t, y, tEnd, tolerance, 2);
     storage.Add(t, y);
+    controller.Reset();
 
-    while (t < tEnd)
+    while (t < tEnd && !storage.Stopped())
     {
         double h_attempt = std::min(h, tEnd - t);
         if (h_attempt < 1e-12) break;
@@ -95,14 +107,15 @@ void RK23SSolver::Solve(
         try
         {
             std::vector<double> y_new = y;
-            Step(t, y_new, h_attempt, tolerance);
-            t += h_attempt;
+            double h_used = h_attempt;
+            Step(t, y_new, h_attempt, tolerance); // h_attempt - следующий шаг
+            t += h_used;
             y = y_new;
             storage.Add(t, y);
             h = h_attempt;
         } 
         catch (const std::runtime_error&) {
-            h = h_attempt * 0.5;
+            h = h_attempt; // Step уже уменьшил шаг
         }
     }
 }
@@ -2,6 +2,7 @@
 
 RK2Solver::RK2Solver(std::function<std::vector<double>(double, const std::vector<double>&)> func, double initialStep)
     : Solver(func, initialStep) {
+    controller.SetLimits(SAFETY_FACTOR, MIN_FACTOR, MAX_FACTOR);
 }
 
 void RK2Solver::Step(
@@ -10,9 +11,12 @@ void RK2Solver::Step(
         double              &h,
         double               tolerance)
 {
+    // f(t, y) не зависит от h: одна на все попытки, в начале шага - из предыдущего шага
+    std::vector<double> fy = Derivative(t, y);
+
     while (true)
     {
-        std::vector<double> k1 = MultiplyScalarByVector(h, f(t, y));
+        std::vector<double> k1 = MultiplyScalarByVector(h, fy);
         std::vector<double> k2 = MultiplyScalarByVector(h, f(t, AddVectors(y, MultiplyScalarByVector(b21, k1))));
         
         // Вычисляем следующее приближение
@@ -22,29 +26,28 @@ void RK2Solver::Step(
         );
 
         // Оценка ошибки по двум критериям
-        std::vector<double> hf_next = MultiplyScalarByVector(h, f(t + h, y_next));
-        double error1 = Norm(SubtractVectors(k2, k1)) / 4.0;        // Условие (3.50)
-        double error2 = Norm(SubtractVectors(hf_next, k1)) / 6.0;   // Условие (3.51)
+        std::vector<double> f_next = f(t + h, y_next);
+        std::vector<double> hf_next = MultiplyScalarByVector(h, f_next);
+        double error1 = ErrorNorm(SubtractVectors(k2, k1), y, y_next, tolerance) / 4.0;        // Условие (3.50)
+        double error2 = ErrorNorm(SubtractVectors(hf_next, k1), y, y_next, tolerance) / 6.0;   // Условие (3.51)
         double error = std::max(error1, error2);
 
         // Приемлемая ошибка - принимаем шаг
         if (error <= tolerance)
         {
+            StoreDerivative(t + h, y_next, f_next);
+            acceptedStep = h;
+
             // Адаптируем шаг на основе ошибки (порядок метода 2, оценка ошибки ~ h^3)
-            double factor = SAFETY_FACTOR * pow(tolerance / error, 1.0/3.0);
-            factor = std::clamp(factor, MIN_FACTOR, MAX_FACTOR);
-            h *= factor;
+            h *= controller.Accept(error / tolerance, 3.0);
             
             y = y_next;
-            t += h;
 
             return;
         }
         
         // Уменьшаем шаг при большой ошибке
-        double factor = SAFETY_FACTOR * pow(tolerance / error, 1.0/3.0);
-        factor = std::max(factor, MIN_FACTOR);
-        h *= factor;
+        h *= controller.Reject(error / tolerance, 3.0);
     }
 }
 
@@ -56,16 +59,18 @@ void RK2Solver::Solve(
         double                     tolerance)
 {
     double t = t0;
-    double h = stepSize;
     std::vector<double> y = y0;
     storage.Add(t, y);
+    ResetDerivative();
+    controller.Reset();
+    double h = StartingStep(t, y, tEnd, tolerance, 2);
     
-    while (t < tEnd)
+    while (t < tEnd && !storage.Stopped())
     {
         double h_current = std::min(h, tEnd - t);
         Step(t, y, h_current, tolerance);
-        t += h_current;
-        storage.Add(t, y);
+        t = acceptedStep >= tEnd - t ? tEnd : t + acceptedStep;
+        AddPoint(storage, t, y);
         
         // Обновляем базовый шаг для следующей итерации
         h = h_current;
@@ -0,0 +1,221 @@
+#include "../include/RKCSolver.hpp"
+
+namespace
+{
+    double Norm2(std::vector<double> const &v)
+    {
+        double sum = 0.0;
+        for (double x : v)
+            sum += x * x;
+        return std::sqrt(sum);
+    }
+}
+
+double RKCSolver::Norm(std::vector<double> const &v) const
+{
+    return tolerances.Norm(v, scale);
+}
+
+double RKCSolver::SpectralRadius(
+    double                     t,
+    std::vector<double> const &y,
+    std::vector<double> const &fy)
+{
+    double const sqrtEps = std::sqrt(std::numeric_limits<double>::epsilon());
+
+    // Возмущение d нормы dyNorm вдоль приближения собственного вектора:
+    // sigma = |f(y + d) - f(y)| / |d| сходится к модулю доминирующего собственного числа
+    double yNorm = Norm2(y);
+    double dyNorm = yNorm > 0.0 ? sqrtEps * yNorm : sqrtEps;
+
+    std::vector<double> d = eigenvector.size() == n ? eigenvector : fy;
+    double dNorm = Norm2(d);
+    if (dNorm == 0.0)
+    {
+        std::fill(d.begin(), d.end(), 1.0);
+        dNorm = std::sqrt(static_cast<double>(n));
+    }
+    for (size_t i = 0; i < n; ++i)
+        d[i] *= dyNorm / dNorm;
+
+    std::vector<double> z(n);
+    double sigma = 0.0;
+    for (int iter = 0; iter < MAX_POWER; ++iter)
+    {
+        for (size_t i = 0; i < n; ++i)
+            z[i] = y[i] + d[i];
+        std::vector<double> fz = f(t, z);
+        for (size_t i = 0; i < n; ++i)
+            fz[i] -= fy[i];
+
+        double dfNorm = Norm2(fz);
+        double sigmaOld = sigma;
+        sigma = dfNorm / dyNorm;
+        if (iter > 0 && std::fabs(sigma - sigmaOld) <= 0.01 * sigma)
+            break;
+
+        if (dfNorm > 0.0)
+        {
+            for (size_t i = 0; i < n; ++i)
+                d[i] = fz[i] * (dyNorm / dfNorm);
+        }
+        else
+        {
+            // f не изменилась: меняем направление одной компоненты
+            size_t index = static_cast<size_t>(iter) % n;
+            d[index] = -d[index];
+        }
+    }
+
+    eigenvector = d;
+    return RHO_SAFETY * sigma;
+}
+
+double RKCSolver::TryStep(
+    double                     t,
+    std::vector<double> const &y,
+    std::vector<double> const &fy,
+    double                     h,
+    int                        s,
+    std::vector<double>       &yNew,
+    std::vector<double>       &fNew,
+    double                     tolerance)
+{
+    double const w0 = 1.0 + DAMPING / (static_cast<double>(s) * s);
+
+    // T_s'(w0) и T_s''(w0): w1 = T_s' / T_s'' выбирается так, чтобы c_s = 1
+    double T0 = 1.0, T1 = w0, dT0 = 0.0, dT1 = 1.0, ddT0 = 0.0, ddT1 = 0.0;
+    for (int j = 2; j <= s; ++j)
+    {
+        double T2 = 2.0 * w0 * T1 - T0;
+        double dT2 = 2.0 * T1 + 2.0 * w0 * dT1 - dT0;
+        double ddT2 = 4.0 * dT1 + 2.0 * w0 * ddT1 - ddT0;
+        T0 = T1; T1 = T2;
+        dT0 = dT1; dT1 = dT2;
+        ddT0 = ddT1; ddT1 = ddT2;
+    }
+    double const w1 = dT1 / ddT1;
+
+    // b_j = T_j'' / (T_j')^2 при j >= 2, b_0 = b_1 = b_2
+    double const b2 = 1.0 / (4.0 * w0 * w0);
+    double bPrev2 = b2, bPrev1 = b2;
+    double cPrev1 = w1 / (4.0 * w0 * w0); // c_1 = c_2 / T_2'(w0), c_2 = w1 / w0
+
+    // Y_1 = y + b_1 w1 h F_0
+    yPrev2 = y;
+    yPrev1.resize(n);
+    yStage.resize(n);
+    for (size_t i = 0; i < n; ++i)
+        yPrev1[i] = y[i] + b2 * w1 * h * fy[i];
+
+    T0 = 1.0; T1 = w0; dT0 = 0.0; dT1 = 1.0; ddT0 = 0.0; ddT1 = 0.0;
+    for (int j = 2; j <= s; ++j)
+    {
+        double T2 = 2.0 * w0 * T1 - T0;
+        double dT2 = 2.0 * T1 + 2.0 * w0 * dT1 - dT0;
+        double ddT2 = 4.0 * dT1 + 2.0 * w0 * ddT1 - ddT0;
+
+        double bj = ddT2 / (dT2 * dT2);
+        double mu = 2.0 * w0 * bj / bPrev1;
+        double nu = -bj / bPrev2;
+        double muTilde = 2.0 * w1 * bj / bPrev1;
+        double gammaTilde = -(1.0 - bPrev1 * T1) * muTilde;
+
+        // Y_j = (1 - mu - nu) y + mu Y_{j-1} + nu Y_{j-2} + muTilde h F_{j-1} + gammaTilde h F_0
+        fStage = f(t + cPrev1 * h, yPrev1);
+        for (size_t i = 0; i < n; ++i)
+            yStage[i] = (1.0 - mu - nu) * y[i] + mu * yPrev1[i] + nu * yPrev2[i]
+                      + h * (muTilde * fStage[i] + gammaTilde * fy[i]);
+
+        yPrev2.swap(yPrev1);
+        yPrev1.swap(yStage);
+
+        bPrev2 = bPrev1;
+        bPrev1 = bj;
+        cPrev1 = w1 * ddT2 / dT2;
+        T0 = T1; T1 = T2;
+        dT0 = dT1; dT1 = dT2;
+        ddT0 = ddT1; ddT1 = ddT2;
+    }
+
+    yNew = yPrev1;
+    fNew = f(t + h, yNew);
+
+    // Оценка погрешности RKC: (12 (y - yNew) + 6 h (F_0 + f(yNew))) / 15
+    std::vector<double> &est = yStage;
+    for (size_t i = 0; i < n; ++i)
+        est[i] = (12.0 * (y[i] - yNew[i]) + 6.0 * h * (fy[i] + fNew[i])) / 15.0;
+    tolerances.Scales(tolerance, y, yNew, scale);
+    return Norm(est);
+}
+
+void RKCSolver::Step(
+    double               t,
+    std::vector<double> &y,
+    double              &hStep,
+    double               tolerance)
+{
+    Storage local;
+    Solve(t, y, t + hStep, local, tolerance);
+    y = local[local.Size() - 1].second;
+}
+
+void RKCSolver::Solve(
+    double                     t0,
+    std::vector<double> const &y0,
+    double                     tEnd,
+    Storage                   &storage,
+    double                     tolerance)
+{
+    double t = t0;
+    std::vector<double> y = y0;
+    double h = StartingStep(t, y, tEnd, tolerance, 2);
+    n = y.size();
+    scale.resize(n);
+    eigenvector.clear();
+    rhoAge = RHO_INTERVAL;
+    controller.Reset();
+
+    std::vector<double> fy = Derivative(t, y), yNew, fNew;
+
+    storage.Add(t, y);
+
+    while (t < tEnd && !storage.Stopped())
+    {
+        if (rhoAge >= RHO_INTERVAL)
+        {
+            rho = SpectralRadius(t, y, fy);
+            rhoAge = 0;
+        }
+
+        // Не больше MAX_STAGES стадий: h*rho <= ((MAX_STAGES - 1)^2 - 1) / STAGE_FACTOR
+        if (rho > 0.0)
+            h = std::min(h, ((MAX_STAGES - 1.0) * (MAX_STAGES - 1.0) - 1.0) / (STAGE_FACTOR * rho));
+
+        bool last = t + h >= tEnd;
+        if (last)
+            h = tEnd - t;
+
+        if (h <= 10.0 * std::numeric_limits<double>::epsilon() * std::max(1.0, std::fabs(t)))
+            throw std::runtime_error("RKC: step size too small");
+
+        int s = std::max(MIN_STAGES, 1 + static_cast<int>(std::sqrt(1.0 + STAGE_FACTOR * h * rho)));
+        double err = TryStep(t, y, fy, h, s, yNew, fNew, tolerance);
+
+        if (!(err <= 1.0))
+        {
+            // Отказ мог быть вызван неустойчивостью: оценка rho устарела
+            rhoAge = RHO_INTERVAL;
+            h *= controller.Reject(err, 3.0);
+            continue;
+        }
+
+        y.swap(yNew);
+        fy.swap(fNew);
+        t = last ? tEnd : t + h;
+        storage.Add(t, y);
+
+        ++rhoAge;
+        h *= controller.Accept(err, 3.0);
+    }
+}
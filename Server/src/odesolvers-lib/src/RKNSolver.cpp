@@ -0,0 +1,241 @@
+#include "../include/RKNSolver.hpp"
+#include "../include/EmbeddedRKSolver.hpp"
+
+namespace
+{
+    // Классический метод Нюстрёма 4-го порядка для q'' = g(t, q) с оценкой 3-го порядка по FSAL-стадии
+    // g(t + h, q_{n+1}): координаты - bbar^ = (1/3, 0, 1/6), скорости - b^ = (1/6, 2/3, 0, 1/6)
+    NystromTableau Nystrom43()
+    {
+        NystromTableau t;
+        t.name = "RKN4";
+        t.order = 4;
+        t.errorOrder = 3;
+        t.velocityFree = true;
+        t.c = { 0.0, 0.5, 1.0, 1.0 };
+        t.Abar = {
+            {},
+            { 1.0 / 8.0 },
+            { 0.0, 1.0 / 2.0 },
+            { 1.0 / 6.0, 1.0 / 3.0, 0.0 }
+        };
+        t.bbar = { 1.0 / 6.0, 1.0 / 3.0, 0.0, 0.0 };
+        t.b = { 1.0 / 6.0, 2.0 / 3.0, 1.0 / 6.0, 0.0 };
+        t.ebar = { -1.0 / 6.0, 1.0 / 3.0, -1.0 / 6.0, 0.0 };
+        t.e = { 0.0, 0.0, 1.0 / 6.0, -1.0 / 6.0 };
+        return t;
+    }
+
+    // Метод Рунге-Кутты (A, b, e), применённый к системе q' = v, v' = g, в форме Нюстрёма:
+    // Abar = A^2, bbar = bA, ebar = eA. Решение совпадает с исходной парой, а вычисляются
+    // только ускорения
+    NystromTableau Induced(EmbeddedTableau const &rk)
+    {
+        size_t const s = rk.stages;
+
+        auto times = [&rk, s](std::vector<double> const &row)
+        {
+            std::vector<double> result(s, 0.0);
+            for (size_t l = 0; l < row.size(); ++l)
+                for (size_t j = 0; j < rk.A[l].size(); ++j)
+                    result[j] += row[l] * rk.A[l][j];
+            return result;
+        };
+
+        NystromTableau t;
+        t.name = "RKN" + std::to_string(rk.order);
+        t.order = rk.order;
+        t.errorOrder = rk.errorOrder;
+        t.velocityFree = false;
+        t.c.assign(rk.c.begin(), rk.c.begin() + s);
+        for (size_t i = 0; i < s; ++i)
+        {
+            std::vector<double> row = times(rk.A[i]);
+            row.resize(i);
+            t.Abar.push_back(row);
+            t.A.push_back(rk.A[i]);
+        }
+        t.b = rk.b;
+        t.e = rk.e;
+        t.bbar = times(rk.b);
+        t.ebar = times(rk.e);
+        return t;
+    }
+}
+
+std::vector<std::string> NystromPairs()
+{
+    return { "RKN4", "RKN5" };
+}
+
+NystromTableau NystromPair(std::string const &name)
+{
+    if (name == "RKN4")
+        return Nystrom43();
+    if (name == "RKN5")
+        return Induced(EmbeddedPair("DP5"));
+    throw std::runtime_error("Unknown Nystrom pair: " + name);
+}
+
+RKNSolver::RKNSolver(
+    std::function<std::vector<double>(
+        double,
+        std::vector<double> const &)> func,
+    SecondOrderSystem                 system,
+    double                            initialStep,
+    NystromTableau                    tableau)
+    : Solver(func, initialStep), system(std::move(system)), tableau(std::move(tableau))
+{
+    if (this->tableau.velocityFree && !this->system.velocityFree)
+    {
+        throw std::invalid_argument(this->tableau.name + " requires accelerations independent of velocities");
+    }
+    controller.SetLimits(SAFETY, FAC_MIN, FAC_MAX);
+}
+
+std::vector<double> RKNSolver::Acceleration(
+    double                     t,
+    std::vector<double> const &y)
+{
+    ++evaluations;
+    std::vector<double> a = system.acceleration(t, y);
+    if (a.size() != m)
+    {
+        throw std::invalid_argument("Number of accelerations does not match the state dimension");
+    }
+    return a;
+}
+
+double RKNSolver::TryStep(
+    double                     t,
+    std::vector<double> const &y,
+    double                     h,
+    std::vector<double>       &yNew,
+    double                     tolerance)
+{
+    size_t const s = tableau.c.size();
+    bool const velocities = !tableau.velocityFree && !system.velocityFree;
+
+    for (size_t i = 1; i < s; ++i)
+    {
+        // Q_i = q + c_i h q' + h^2 sum Abar_ij g_j; без зависимости от скоростей V_i = q'
+        stage = y;
+        for (size_t r = 0; r < m; ++r)
+            stage[r] += tableau.c[i] * h * y[m + r];
+
+        std::vector<double> const &abar = tableau.Abar[i];
+        for (size_t j = 0; j < abar.size(); ++j)
+        {
+            if (abar[j] == 0.0)
+                continue;
+            double coefficient = h * h * abar[j];
+            for (size_t r = 0; r < m; ++r)
+                stage[r] += coefficient * g[j][r];
+        }
+
+        if (velocities)
+        {
+            std::vector<double> const &a = tableau.A[i];
+            for (size_t j = 0; j < a.size(); ++j)
+            {
+                if (a[j] == 0.0)
+                    continue;
+                double coefficient = h * a[j];
+                for (size_t r = 0; r < m; ++r)
+                    stage[m + r] += coefficient * g[j][r];
+            }
+        }
+
+        g[i] = Acceleration(t + tableau.c[i] * h, stage);
+    }
+
+    yNew = y;
+    for (size_t r = 0; r < m; ++r)
+        yNew[r] += h * y[m + r];
+    std::fill(estimate.begin(), estimate.end(), 0.0);
+    for (size_t j = 0; j < s; ++j)
+    {
+        for (size_t r = 0; r < m; ++r)
+        {
+            yNew[r] += h * h * tableau.bbar[j] * g[j][r];
+            yNew[m + r] += h * tableau.b[j] * g[j][r];
+            estimate[r] += h * h * tableau.ebar[j] * g[j][r];
+            estimate[m + r] += h * tableau.e[j] * g[j][r];
+        }
+    }
+
+    tolerances.Scales(tolerance, y, yNew, scale);
+    return tolerances.Norm(estimate, scale);
+}
+
+void RKNSolver::Step(
+    double               t,
+    std::vector<double> &y,
+    double              &hStep,
+    double               tolerance)
+{
+    Storage local;
+    Solve(t, y, t + hStep, local, tolerance);
+    y = local[local.Size() - 1].second;
+}
+
+void RKNSolver::Solve(
+    double                     t0,
+    std::vector<double> const &y0,
+    double                     tEnd,
+    Storage                   &storage,
+    double                     tolerance)
+{
+    if (y0.size() % 2 != 0)
+    {
+        throw std::invalid_argument("Second-order system requires an even state dimension (positions, then velocities)");
+    }
+
+    double t = t0;
+    std::vector<double> y = y0, yNew;
+    double h = StartingStep(t, y, tEnd, tolerance, tableau.order);
+    m = y.size() / 2;
+    evaluations = 0;
+    scale.resize(y.size());
+    estimate.resize(y.size());
+    g.assign(tableau.c.size(), std::vector<double>(m, 0.0));
+
+    // Последняя стадия - g(t + h, q_{n+1}, q'_{n+1}) (FSAL): вне оценки погрешности она
+    // вычисляется только после принятия шага
+    size_t const last = tableau.c.size() - 1;
+    bool const fsalInEstimate = tableau.e[last] != 0.0 || tableau.ebar[last] != 0.0;
+    double const errorExponent = tableau.errorOrder + 1.0;
+
+    g[0] = Acceleration(t, y);
+    storage.Add(t, y);
+    controller.Reset();
+
+    while (t < tEnd && !storage.Stopped())
+    {
+        bool lastStep = t + h >= tEnd;
+        if (lastStep)
+            h = tEnd - t;
+
+        if (h <= 10.0 * std::numeric_limits<double>::epsilon() * std::max(1.0, std::fabs(t)))
+            throw std::runtime_error(tableau.name + ": step size too small");
+
+        double err = TryStep(t, y, h, yNew, tolerance);
+
+        if (!(err <= 1.0))
+        {
+            h *= controller.Reject(err, errorExponent);
+            continue;
+        }
+
+        double tNew = lastStep ? tEnd : t + h;
+        if (!fsalInEstimate)
+            g[last] = Acceleration(tNew, yNew);
+
+        storage.Add(tNew, yNew);
+        y.swap(yNew);
+        t = tNew;
+        g[0].swap(g[last]);
+
+        h *= controller.Accept(err, errorExponent);
+    }
+}
@@ -0,0 +1,409 @@
+#include "../include/RadauIIASolver.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+    double const SQ6 = std::sqrt(6.0);
+
+    // Узлы Radau IIA
+    double const C1 = (4.0 - SQ6) / 10.0;
+    double const C2 = (4.0 + SQ6) / 10.0;
+
+    // A^{-1} = T * diag(U1, [[ALPHA, -BETA], [BETA, ALPHA]]) * TI
+    double const T11 = 9.1232394870892942792e-02, T12 = -0.14125529502095420843, T13 = -3.0029194105147424492e-02;
+    double const T21 = 0.24171793270710701896,    T22 = 0.20412935229379993199,  T23 = 0.38294211275726193779;
+    double const T31 = 0.96604818261509293619,    T32 = 1.0;
+
+    double const TI11 = 4.3255798900631553510,  TI12 = 0.33919925181580986954,  TI13 = 0.54177053993587487119;
+    double const TI21 = -4.1787185915519047273, TI22 = -0.32768282076106238708, TI23 = 0.47662355450055045196;
+    double const TI31 = -0.50287263494578687595, TI32 = 2.5719269498556054292,  TI33 = -0.59603920482822492497;
+
+    double const CBRT81 = std::cbrt(81.0);
+    double const CBRT9  = std::cbrt(9.0);
+    double const U1     = 30.0 / (6.0 + CBRT81 - CBRT9);
+    double const ALPHA0 = (12.0 - CBRT81 + CBRT9) / 60.0;
+    double const BETA0  = (CBRT81 + CBRT9) * std::sqrt(3.0) / 60.0;
+    double const CNO    = ALPHA0 * ALPHA0 + BETA0 * BETA0;
+    double const ALPHA  = ALPHA0 / CNO;
+    double const BETA   = BETA0 / CNO;
+
+    // Коэффициенты вложенной оценки погрешности
+    double const DD1 = -(13.0 + 7.0 * SQ6) / 3.0;
+    double const DD2 = (-13.0 + 7.0 * SQ6) / 3.0;
+    double const DD3 = -1.0 / 3.0;
+
+    double const UROUND = std::numeric_limits<double>::epsilon();
+}
+
+void RadauIIASolver::Reset(
+    double                     t,
+    std::vector<double> const &y,
+    double                     h0)
+{
+    n = y.size();
+    h = h0;
+    f0 = Derivative(t, y);
+
+    z1.assign(n, 0.0); z2.assign(n, 0.0); z3.assign(n, 0.0);
+    w1.assign(n, 0.0); w2.assign(n, 0.0); w3.assign(n, 0.0);
+
+    first = true;
+    rejected = false;
+    jacobianCurrent = false;
+    needJacobian = true;
+    needFactor = true;
+    haveExtrapolation = false;
+    faccon = 1.0;
+    theta = THETA_JAC;
+    hAccepted = h0;
+    errAccepted = 1e-2;
+}
+
+void RadauIIASolver::ComputeJacobian(
+    double                     t,
+    std::vector<double> const &y,
+    double                     tolerance)
+{
+    CsrMatrix const &Jc = JacobianCsr(t, y, &f0, tolerance);
+
+    J.assign(n * n, 0.0);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t k = Jc.pattern.rowPtr[i]; k < Jc.pattern.rowPtr[i + 1]; ++k)
+            J[i * n + Jc.pattern.colIndex[k]] = Jc.values[k];
+
+    jacobianCurrent = true;
+    needJacobian = false;
+}
+
+bool RadauIIASolver::Factorize()
+{
+    double fac1 = U1 / h;
+    std::complex<double> fac2(ALPHA / h, BETA / h);
+
+    std::vector<double> e1(n * n);
+    std::vector<std::complex<double>> e2(n * n);
+    for (size_t i = 0; i < n * n; ++i)
+    {
+        e1[i] = -J[i];
+        e2[i] = -J[i];
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+        e1[i * n + i] += fac1;
+        e2[i * n + i] += fac2;
+    }
+
+    needFactor = false;
+    return realLU.Factorize(std::move(e1), n) && complexLU.Factorize(std::move(e2), n);
+}
+
+void RadauIIASolver::Extrapolate()
+{
+    if (first || !haveExtrapolation)
+    {
+        std::fill(z1.begin(), z1.end(), 0.0);
+        std::fill(z2.begin(), z2.end(), 0.0);
+        std::fill(z3.begin(), z3.end(), 0.0);
+        return;
+    }
+
+    // Коллокационный многочлен прошлого шага: u(0) = 0, u(C1) = z1, u(C2) = z2, u(1) = z3
+    auto lagrange = [](double s, double sk, double sa, double sb)
+    {
+        return (s * (s - sa) * (s - sb)) / (sk * (sk - sa) * (sk - sb));
+    };
+
+    double q = h / hAccepted;
+    double nodes[3] = {1.0 + C1 * q, 1.0 + C2 * q, 1.0 + q};
+    std::vector<double> *targets[3] = {&z1, &z2, &z3};
+
+    for (int s = 0; s < 3; ++s)
+    {
+        double x = nodes[s];
+        double l1 = lagrange(x, C1, C2, 1.0);
+        double l2 = lagrange(x, C2, C1, 1.0);
+        double l3 = lagrange(x, 1.0, C1, C2);
+        for (size_t i = 0; i < n; ++i)
+            (*targets[s])[i] = l1 * z1Prev[i] + l2 * z2Prev[i] + l3 * z3Prev[i] - z3Prev[i];
+    }
+}
+
+bool RadauIIASolver::TryStep(
+    double              &t,
+    std::vector<double> &y,
+    double               tolerance)
+{
+    if (needJacobian)
+        ComputeJacobian(t, y, tolerance);
+
+    if (needFactor && !Factorize())
+    {
+        // Вырожденная матрица итераций: уменьшаем шаг
+        h *= 0.5;
+        rejected = true;
+        needFactor = true;
+        return false;
+    }
+
+    // Пересчёт допуска как в RADAU5: порядок оценки 3 при порядке метода 5
+    // (rtol' = 0.1 rtol^(2/3), atol' = rtol' atol / rtol)
+    double tol = 0.1 * std::pow(tolerance, 2.0 / 3.0);
+    std::vector<double> scal(n);
+    if (!tolerances.Componentwise())
+    {
+        for (size_t i = 0; i < n; ++i)
+            scal[i] = tol * (1.0 + std::fabs(y[i]));
+    }
+    else
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            double rtol = tolerances.Relative(i, tolerance);
+            double atol = tolerances.Absolute(i, tolerance);
+            double rtolScaled = rtol > 0.0 ? 0.1 * std::pow(rtol, 2.0 / 3.0) : 0.0;
+            double atolScaled = rtol > 0.0 ? rtolScaled * atol / rtol : atol;
+            scal[i] = atolScaled + rtolScaled * std::fabs(y[i]);
+        }
+    }
+
+    double const fac1 = U1 / h;
+    double const alphn = ALPHA / h;
+    double const betan = BETA / h;
+    // Порог сходимости Ньютона как в RADAU5: max(10 uround / tol', min(0.03, tol'^(1/2)))
+    double const fnewt = std::max(10.0 * UROUND / tol, std::min(0.03, std::sqrt(tol)));
+
+    Extrapolate();
+    for (size_t i = 0; i < n; ++i)
+    {
+        w1[i] = TI11 * z1[i] + TI12 * z2[i] + TI13 * z3[i];
+        w2[i] = TI21 * z1[i] + TI22 * z2[i] + TI23 * z3[i];
+        w3[i] = TI31 * z1[i] + TI32 * z2[i] + TI33 * z3[i];
+    }
+
+    // Упрощённые итерации Ньютона
+    faccon = std::pow(std::max(faccon, UROUND), 0.8);
+    theta = THETA_JAC;
+    double dynold = 0.0;
+    double thqold = 0.0;
+    int newt = 0;
+    bool converged = false;
+    double hhfac = 0.5;
+
+    std::vector<double> yStage(n), r1(n);
+    std::vector<std::complex<double>> r23(n);
+
+    for (newt = 1; newt <= MAX_NEWTON; ++newt)
+    {
+        for (size_t i = 0; i < n; ++i) yStage[i] = y[i] + z1[i];
+        std::vector<double> F1 = f(t + C1 * h, yStage);
+        for (size_t i = 0; i < n; ++i) yStage[i] = y[i] + z2[i];
+        std::vector<double> F2 = f(t + C2 * h, yStage);
+        for (size_t i = 0; i < n; ++i) yStage[i] = y[i] + z3[i];
+        std::vector<double> F3 = f(t + h, yStage);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            double a1 = TI11 * F1[i] + TI12 * F2[i] + TI13 * F3[i];
+            double a2 = TI21 * F1[i] + TI22 * F2[i] + TI23 * F3[i];
+            double a3 = TI31 * F1[i] + TI32 * F2[i] + TI33 * F3[i];
+            r1[i] = a1 - fac1 * w1[i];
+            r23[i] = std::complex<double>(a2 - alphn * w2[i] + betan * w3[i],
+                                          a3 - alphn * w3[i] - betan * w2[i]);
+        }
+
+        realLU.Solve(r1);
+        complexLU.Solve(r23);
+
+        double dyno = 0.0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            double a = r1[i] / scal[i];
+            double b = r23[i].real() / scal[i];
+            double c = r23[i].imag() / scal[i];
+            dyno += a * a + b * b + c * c;
+        }
+        dyno = std::sqrt(dyno / (3.0 * n));
+
+        if (newt > 1)
+        {
+            double thq = dyno / dynold;
+            theta = (newt == 2) ? thq : std::sqrt(thq * thqold);
+            thqold = thq;
+
+            if (theta >= 0.99)
+                break;
+
+            faccon = theta / (1.0 - theta);
+            double dyth = faccon * dyno * std::pow(theta, MAX_NEWTON - newt) / fnewt;
+            if (dyth >= 1.0)
+            {
+                // Сходимость ожидается слишком медленной: уменьшаем шаг заранее
+                double qnewt = std::max(1e-4, std::min(20.0, dyth));
+                hhfac = 0.8 * std::pow(qnewt, -1.0 / (4.0 + MAX_NEWTON - newt));
+                break;
+            }
+        }
+        dynold = std::max(dyno, UROUND);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            w1[i] += r1[i];
+            w2[i] += r23[i].real();
+            w3[i] += r23[i].imag();
+            z1[i] = T11 * w1[i] + T12 * w2[i] + T13 * w3[i];
+            z2[i] = T21 * w1[i] + T22 * w2[i] + T23 * w3[i];
+            z3[i] = T31 * w1[i] + T32 * w2[i];
+        }
+
+        if (faccon * dyno <= fnewt)
+        {
+            converged = true;
+            break;
+        }
+    }
+
+    if (!converged)
+    {
+        // Отказ итераций Ньютона: меньший шаг и, если нужно, новая матрица Якоби
+        h *= hhfac;
+        rejected = true;
+        needFactor = true;
+        needJacobian = !jacobianCurrent;
+        return false;
+    }
+
+    // Оценка погрешности
+    std::vector<double> f2(n), cont(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        f2[i] = (DD1 * z1[i] + DD2 * z2[i] + DD3 * z3[i]) / h;
+        cont[i] = f0[i] + f2[i];
+    }
+    realLU.Solve(cont);
+
+    auto rms = [&](std::vector<double> const &v)
+    {
+        double sum = 0.0;
+        for (size_t i = 0; i < n; ++i)
+            sum += (v[i] / scal[i]) * (v[i] / scal[i]);
+        return std::max(std::sqrt(sum / n), 1e-10);
+    };
+
+    double err = rms(cont);
+    if (err >= 1.0 && (first || rejected))
+    {
+        // Сглаживание оценки для жёстких компонент
+        for (size_t i = 0; i < n; ++i)
+            yStage[i] = y[i] + cont[i];
+        std::vector<double> f1 = f(t, yStage);
+        for (size_t i = 0; i < n; ++i)
+            cont[i] = f1[i] + f2[i];
+        realLU.Solve(cont);
+        err = rms(cont);
+    }
+
+    double fac = std::min(SAFETY, SAFETY * (1 + 2 * MAX_NEWTON) / (newt + 2 * MAX_NEWTON));
+    double quot = std::max(1.0 / FAC_MAX, std::min(1.0 / FAC_MIN, std::pow(err, 0.25) / fac));
+    double hNew = h / quot;
+
+    if (err >= 1.0)
+    {
+        rejected = true;
+        h = first ? h * 0.1 : hNew;
+        needFactor = true;
+        return false;
+    }
+
+    // Шаг принят: прогнозирующий регулятор Густафссона
+    if (!first)
+    {
+        double facgus = (hAccepted / h) * std::pow(err * err / errAccepted, 0.25) / SAFETY;
+        facgus = std::max(1.0 / FAC_MAX, std::min(1.0 / FAC_MIN, facgus));
+        quot = std::max(quot, facgus);
+        hNew = h / quot;
+    }
+    hAccepted = h;
+    errAccepted = std::max(1e-2, err);
+
+    z1Prev = z1;
+    z2Prev = z2;
+    z3Prev = z3;
+    haveExtrapolation = true;
+
+    t += h;
+    for (size_t i = 0; i < n; ++i)
+        y[i] += z3[i];
+    f0 = f(t, y);
+
+    first = false;
+    rejected = false;
+    jacobianCurrent = false;
+
+    double qt = hNew / h;
+    if (theta <= THETA_JAC && qt >= KEEP_MIN && qt <= KEEP_MAX)
+        return true; // Шаг и LU-разложения сохраняются
+
+    h = hNew;
+    needFactor = true;
+    needJacobian = theta > THETA_JAC;
+    return true;
+}
+
+void RadauIIASolver::Advance(
+    double              &t,
+    std::vector<double> &y,
+    double               tEnd,
+    double               tolerance)
+{
+    if (y.size() != n)
+        Reset(t, y, h > 0.0 ? h : stepSize);
+
+    while (true)
+    {
+        if (t + 1.0001 * h >= tEnd)
+        {
+            h = tEnd - t;
+            needFactor = true;
+        }
+
+        if (h <= 10.0 * UROUND * std::max(1.0, std::fabs(t)))
+            throw std::runtime_error("RadauIIA: step size too small");
+
+        if (TryStep(t, y, tolerance))
+            return;
+    }
+}
+
+void RadauIIASolver::Step(
+    double               t,
+    std::vector<double> &y,
+    double              &hStep,
+    double               tolerance)
+{
+    Reset(t, y, hStep);
+    Advance(t, y, std::numeric_limits<double>::infinity(), tolerance);
+    hStep = h;
+}
+
+void RadauIIASolver::Solve(
+    double                     t0,
+    std::vector<double> const &y0,
+    double                     tEnd,
+    Storage                   &storage,
+    double                     tolerance)
+{
+    double t = t0;
+    std::vector<double> y = y0;
+    Reset(t, y, StartingStep(t, y, tEnd, tolerance, 3));
+    storage.Add(t, y);
+
+    while (t < tEnd && !storage.Stopped())
+    {
+        Advance(t, y, tEnd, tolerance);
+        storage.Add(t, y);
+    }
+}
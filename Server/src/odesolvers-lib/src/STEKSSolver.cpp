@@ -19,6 +19,14 @@ void STEKSSolver::Step(
     );
     std::vector<double> k3 = MultiplyScalarByVector(h, f(t + h/3.0, y3));
 
+    // Условие устойчивости известно после третьей стадии: отказ без вычисления k4, k5
+    double error = computeStabilityError(k1, k2, k3);
+    if (error > tolerance)
+    {
+        h *= controller.Reject(error / tolerance, 4.0);
+        throw std::runtime_error("Step rejected");
+    }
+
     std::vector<double> y4 = AddVectors(
         AddVectors(y_temp, MultiplyScalarByVector(1.0/8.0, k1)),
         MultiplyScalarByVector(3.0/8.0, k3)
@@ -35,16 +43,12 @@ void STEKSSolver::Step(
     std::vector<double> k5 = MultiplyScalarByVector(h, f(t + h, y5));
 
     // Оценка ошибки
-    double error = computeError(k1, k2, k3, k4, k5, h, tolerance);
+    error = std::max(computePrecisionError(k1, k3, k4, k5, y, tolerance), error);
 
     // Адаптация шага
     if (error > tolerance)
     {
-        double scale = SAFETY * std::pow(tolerance / error, 1.0/4.0);
-
-        scale = std::clamp(scale, MIN_SCALE, MAX_SCALE);
-        h *= scale;
-
+        h *= controller.Reject(error / tolerance, 4.0);
         throw std::runtime_error("Step rejected");
     }
 
@@ -61,19 +65,35 @@ void STEKSSolver::Step(
     );
 
     // Корректировка шага
-    double scale = SAFETY * std::pow(tolerance / error, 1.0/4.0);
-    scale = std::clamp(scale, MIN_SCALE, MAX_SCALE);
-    h *= scale;
+    h *= controller.Accept(error / tolerance, 4.0);
     y = y_temp;
 }
 
-double STEKSSolver::computeError(
+double STEKSSolver::computeStabilityError(
     std::vector<double> const &k1,
     std::vector<double> const &k2,
+    std::vector<double> const &k3)
+{
+    // Условие устойчивости: 6*max|(k3 -k2)/(k2 -k1)| <= 3.5
+    double stability_error = 0.0;
+    for (size_t i = 0; i < k1.size(); ++i)
+    {
+        double denominator = k2[i] - k1[i];
+
+        if (std::abs(denominator) < 1e-12) denominator = 1e-12;
+
+        double ratio = std::abs((k3[i] - k2[i]) / denominator);
+        stability_error = std::max(stability_error, ratio);
+    }
+    return (6.0 / 3.5) * stability_error;
+}
+
+double STEKSSolver::computePrecisionError(
+    std::vector<double> const &k1,
     std::vector<double> const &k3,
     std::vector<double> const &k4,
     std::vector<double> const &k5,
-    double                     h,
+    std::vector<double> const &y,
     double                     tolerance)
 {
     // Условие точности: (1/30)||2k1 -9k3 +8k4 -k5|| <= 5e^(5/4)
@@ -87,22 +107,7 @@ double STEKSSolver::computeError(
             k5
         )
     );
-    double precision_error = (Norm(precision_term) / 30.0) / (5.0 * std::exp(5.0/4.0));
-
-    // Условие устойчивости: 6*max|(k3 -k2)/(k2 -k1)| <= 3.5
-    double stability_error = 0.0;
-    for (size_t i = 0; i < k1.size(); ++i)
-    {
-        double denominator = k2[i] - k1[i];
-
-        if (std::abs(denominator) < 1e-12) denominator = 1e-12;
-
-        double ratio = std::abs((k3[i] - k2[i]) / denominator);
-        stability_error = std::max(stability_error, ratio);
-    }
-    stability_error = (6.0 / 3.5) * stability_error;
-
-    return std::max(precision_error, stability_error);
+    return (ErrorNorm(precision_term, y, y, tolerance) / 30.0) / (5.0 * std::exp(5.0/4.0));
 }
 
 void STEKSSolver::Solve(
@@ -114,25 +119,27 @@ void STEKSSolver::Solve(
 {
     double t = t0;
     std::vector<double> y = y0;
-    double h = stepSize;
+    double h = StartingStep(t, y, tEnd, tolerance, 3);
     storage.Add(t, y);
+    controller.Reset();
 
-    while (t < tEnd)
+    while (t < tEnd && !storage.Stopped())
     {
         double h_attempt = std::min(h, tEnd - t);
         if (h_attempt < 1e-12) break;
 
         try {
             std::vector<double> y_new = y;
-            Step(t, y_new, h_attempt, tolerance);
-            t += h_attempt;
+            double h_used = h_attempt;
+            Step(t, y_new, h_attempt, tolerance); // h_attempt - следующий шаг
+            t += h_used;
             y = y_new;
             storage.Add(t, y);
             h = h_attempt;
         }
         catch (const std::runtime_error&)
         {
-            h *= 0.5;
+            h = h_attempt; // Step уже уменьшил шаг
         }
     }
 }
@@ -0,0 +1,116 @@
+#include "../include/Solver.hpp"
+
+CsrMatrix const& Solver::JacobianCsr(
+    double                     t,
+    std::vector<double> const &y,
+    std::vector<double> const *f0,
+    double                     tolerance)
+{
+    if (jacobian)
+    {
+        exactJacobian = CsrMatrix::FromDense(jacobian(t, y));
+        return exactJacobian;
+    }
+
+    if (!sparseJacobian || sparseJacobian->Pattern().n != y.size())
+    {
+        CsrPattern pattern = (sparsity && sparsity->n == y.size())
+            ? *sparsity
+            : SparseJacobian::DetectPattern(f, t, y);
+        sparseJacobian = std::make_unique<SparseJacobian>(f, std::move(pattern));
+    }
+
+    if (tolerance <= 0.0)
+        return sparseJacobian->Evaluate(t, y, f0);
+
+    tolerances.Scales(tolerance, y, y, differenceScale);
+    return sparseJacobian->Evaluate(t, y, f0, &differenceScale);
+}
+
+void Solver::StoreDerivative(
+    double                     t,
+    std::vector<double> const &y,
+    std::vector<double> const &fy)
+{
+    derivativeT = t;
+    derivativeY = y;
+    derivativeF = fy;
+    derivativeValid = true;
+}
+
+std::vector<double> Solver::Derivative(
+    double                     t,
+    std::vector<double> const &y)
+{
+    if (derivativeValid && derivativeT == t && derivativeY == y)
+        return derivativeF;
+    return f(t, y);
+}
+
+void Solver::AddPoint(
+    Storage                   &storage,
+    double                     t,
+    std::vector<double> const &y)
+{
+    StepOutput step;
+    if (derivativeValid && derivativeT == t && derivativeY == y)
+        step.derivative = &derivativeF;
+    storage.Add(t, y, step);
+}
+
+double Solver::StartingStep(
+    double                     t0,
+    std::vector<double> const &y0,
+    double                     tEnd,
+    double                     tolerance,
+    int                        order)
+{
+    if (stepSize > 0.0)
+        return stepSize;
+
+    std::vector<double> f0 = Derivative(t0, y0);
+    StoreDerivative(t0, y0, f0);
+    return EstimateInitialStep(f, t0, y0, f0, tEnd, tolerance, order, tolerances);
+}
+
+double Solver::ErrorNorm(
+    std::vector<double> const &e,
+    std::vector<double> const &y,
+    std::vector<double> const &yNew,
+    double                     tolerance) const
+{
+    if (tolerances.Componentwise())
+        return tolerance * tolerances.Norm(e, y, yNew, tolerance);
+    return Norm(e);
+}
+
+double Solver::ErrorMaxNorm(
+    std::vector<double> const &e,
+    std::vector<double> const &y,
+    std::vector<double> const &yNew,
+    double                     tolerance) const
+{
+    if (tolerances.Componentwise())
+        return tolerance * tolerances.Norm(e, y, yNew, tolerance);
+
+    double norm = 0.0;
+    for (double value : e)
+        norm = std::max(norm, std::fabs(value));
+    return norm;
+}
+
+void Solver::ErrorWeights(
+    std::vector<double> const &y,
+    double                     tolerance,
+    std::vector<double>       &weight) const
+{
+    if (!tolerances.Componentwise())
+    {
+        weight.assign(y.size(), 1.0);
+        return;
+    }
+
+    tolerances.Scales(tolerance, y, y, weight);
+    for (double &value : weight)
+        value = tolerance / value;
+}
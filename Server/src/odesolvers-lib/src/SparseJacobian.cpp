@@ -0,0 +1,194 @@
+#include "../include/SparseJacobian.hpp"
+#include "../include/ComputePool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+CsrPattern CsrPattern::Dense(size_t n)
+{
+    CsrPattern pattern;
+    pattern.n = n;
+    pattern.rowPtr.resize(n + 1);
+    pattern.colIndex.reserve(n * n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        pattern.rowPtr[i] = i * n;
+        for (size_t j = 0; j < n; ++j)
+            pattern.colIndex.push_back(j);
+    }
+    pattern.rowPtr[n] = n * n;
+    return pattern;
+}
+
+std::vector<double> CsrMatrix::Multiply(std::vector<double> const &x) const
+{
+    std::vector<double> result(pattern.n, 0.0);
+    for (size_t i = 0; i < pattern.n; ++i)
+    {
+        double sum = 0.0;
+        for (size_t k = pattern.rowPtr[i]; k < pattern.rowPtr[i + 1]; ++k)
+            sum += values[k] * x[pattern.colIndex[k]];
+        result[i] = sum;
+    }
+    return result;
+}
+
+CsrMatrix CsrMatrix::FromDense(std::vector<std::vector<double>> const &dense)
+{
+    CsrMatrix matrix;
+    matrix.pattern = CsrPattern::Dense(dense.size());
+    matrix.values.reserve(dense.size() * dense.size());
+    for (auto const &row : dense)
+        matrix.values.insert(matrix.values.end(), row.begin(), row.end());
+    return matrix;
+}
+
+SparseJacobian::SparseJacobian(
+    Function   func,
+    CsrPattern pattern)
+    : f(std::move(func))
+{
+    jac.pattern = std::move(pattern);
+    jac.values.assign(jac.pattern.NonZeros(), 0.0);
+    Colorize();
+}
+
+void SparseJacobian::Colorize()
+{
+    CsrPattern const &p = jac.pattern;
+    size_t n = p.n;
+
+    // Транспонированная структура: для каждого столбца - строки и позиции в CSR
+    columnEntries.assign(n, {});
+    for (size_t i = 0; i < n; ++i)
+        for (size_t k = p.rowPtr[i]; k < p.rowPtr[i + 1]; ++k)
+            columnEntries[p.colIndex[k]].emplace_back(i, k);
+
+    // Жадная раскраска графа пересечений столбцов, столбцы с большим числом
+    // ненулевых элементов раскрашиваются первыми
+    std::vector<size_t> order(n);
+    for (size_t j = 0; j < n; ++j)
+        order[j] = j;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+    {
+        return columnEntries[a].size() > columnEntries[b].size();
+    });
+
+    size_t const none = std::numeric_limits<size_t>::max();
+    std::vector<size_t> color(n, none);
+    std::vector<size_t> forbidden; // forbidden[c] == j - цвет c занят соседом столбца j
+
+    groups.clear();
+    for (size_t j : order)
+    {
+        for (auto const &[row, pos] : columnEntries[j])
+        {
+            for (size_t k = p.rowPtr[row]; k < p.rowPtr[row + 1]; ++k)
+            {
+                size_t c = color[p.colIndex[k]];
+                if (c != none)
+                    forbidden[c] = j;
+            }
+        }
+
+        size_t c = 0;
+        while (c < forbidden.size() && forbidden[c] == j)
+            ++c;
+
+        if (c == forbidden.size())
+        {
+            forbidden.push_back(none);
+            groups.emplace_back();
+        }
+
+        color[j] = c;
+        groups[c].push_back(j);
+    }
+}
+
+CsrPattern SparseJacobian::DetectPattern(
+    Function const            &func,
+    double                     t,
+    std::vector<double> const &y)
+{
+    size_t n = y.size();
+
+    // Случайная точка около y исключает случайные нули производных (например, при y = 0)
+    std::mt19937_64 random(n);
+    std::uniform_real_distribution<double> noise(0.5, 1.5);
+    std::vector<double> base(n);
+    for (size_t j = 0; j < n; ++j)
+        base[j] = y[j] + 1e-3 * noise(random) * (std::fabs(y[j]) + 1.0);
+
+    std::vector<double> f0 = func(t, base);
+    std::vector<std::vector<size_t>> columnRows(n);
+
+    ComputePool::Instance().ParallelFor(n, [&](size_t j)
+    {
+        std::vector<double> perturbed = base;
+        perturbed[j] += 1e-3 * (std::fabs(base[j]) + 1.0);
+        std::vector<double> fj = func(t, perturbed);
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (fj[i] != f0[i])
+                columnRows[j].push_back(i);
+        }
+    });
+
+    std::vector<std::vector<size_t>> rows(n);
+    for (size_t j = 0; j < n; ++j)
+        for (size_t i : columnRows[j])
+            rows[i].push_back(j);
+
+    CsrPattern pattern;
+    pattern.n = n;
+    pattern.rowPtr.assign(n + 1, 0);
+    for (size_t i = 0; i < n; ++i)
+    {
+        // Диагональ сохраняется всегда: она нужна матрицам итераций неявных методов
+        if (!std::binary_search(rows[i].begin(), rows[i].end(), i))
+            rows[i].insert(std::lower_bound(rows[i].begin(), rows[i].end(), i), i);
+
+        pattern.colIndex.insert(pattern.colIndex.end(), rows[i].begin(), rows[i].end());
+        pattern.rowPtr[i + 1] = pattern.colIndex.size();
+    }
+
+    return pattern;
+}
+
+CsrMatrix const& SparseJacobian::Evaluate(
+    double                     t,
+    std::vector<double> const &y,
+    std::vector<double> const *f0,
+    std::vector<double> const *scale)
+{
+    std::vector<double> base;
+    if (!f0)
+    {
+        base = f(t, y);
+        f0 = &base;
+    }
+
+    double const sqrtEps = std::sqrt(std::numeric_limits<double>::epsilon());
+
+    ComputePool::Instance().ParallelFor(groups.size(), [&](size_t c)
+    {
+        std::vector<double> perturbed = y;
+        for (size_t j : groups[c])
+            perturbed[j] += sqrtEps * std::max(std::fabs(y[j]), scale ? (*scale)[j] : MIN_SCALE);
+
+        std::vector<double> fc = f(t, perturbed);
+
+        // В каждой строке не более одного столбца группы, поэтому разность однозначна
+        for (size_t j : groups[c])
+        {
+            double delta = perturbed[j] - y[j];
+            for (auto const &[row, pos] : columnEntries[j])
+                jac.values[pos] = (fc[row] - (*f0)[row]) / delta;
+        }
+    });
+
+    return jac;
+}
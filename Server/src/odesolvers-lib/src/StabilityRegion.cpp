@@ -0,0 +1,388 @@
+#include "../include/StabilityRegion.hpp"
+#include "../include/ComputePool.hpp"
+#include "../include/DISPFSolver.hpp"
+#include "../include/DispsDesign.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace
+{
+    constexpr size_t MAX_GRID         = 16384; // Узлов сетки по одной оси
+    constexpr size_t BANDS_PER_THREAD = 8;    // Полос строк на поток пула (балансировка)
+    constexpr size_t LANES            = 8;    // Точек в блоке схемы Горнера
+
+    struct Point
+    {
+        double x;
+        double y;
+    };
+
+    // Отрезок границы внутри ячейки; концы лежат на рёбрах сетки с ключами a и b
+    struct Segment
+    {
+        uint64_t a;
+        uint64_t b;
+        Point    pa;
+        Point    pb;
+    };
+
+    std::vector<ExplicitTableau> Registry()
+    {
+        std::vector<ExplicitTableau> schemes;
+
+        schemes.push_back({ "Euler", { {} }, { 1.0 } });
+        schemes.push_back({ "RK2", { {}, { 2.0 / 3.0 } }, { 1.0 / 4.0, 3.0 / 4.0 } });
+        schemes.push_back({ "RK23S",
+                            { {}, { 2.0 / 3.0 }, { 1.0 / 3.0, 1.0 / 3.0 } },
+                            { 1.0 / 4.0, 15.0 / 32.0, 9.0 / 32.0 } });
+        schemes.push_back({ "STEKS",
+                            { {},
+                              { 1.0 / 3.0 },
+                              { 1.0 / 6.0, 1.0 / 6.0 },
+                              { 1.0 / 8.0, 0.0, 3.0 / 8.0 },
+                              { 0.5, 0.0, -1.5, 2.0 } },
+                            { 1.0 / 6.0, 0.0, 0.0, 2.0 / 3.0, 1.0 / 6.0 } });
+
+        // Варианты DISPS: таблица стадий, которую выполняет решатель, и веса p
+        DispsEnabledFlags all { true, true, true, true, true, true };
+        for (auto const &variant : DISPSSolver::Variants(all))
+        {
+            std::string name = "Disps" + std::to_string(variant.order) + std::to_string(variant.stages);
+            schemes.push_back({ name, DispsStageMatrix(variant.stages), variant.p });
+        }
+
+        // Наборы весов DISPF на общей таблице стадий Фельберга
+        std::vector<std::vector<double>> fehlberg(1);
+        for (size_t i = 0; i < DISPFSolver::B.size(); ++i)
+            fehlberg.emplace_back(DISPFSolver::B[i].begin(), DISPFSolver::B[i].begin() + i + 1);
+
+        auto dispf = [&](std::string const &name, std::array<double, 6> const &weights)
+        {
+            schemes.push_back({ name, fehlberg, std::vector<double>(weights.begin(), weights.end()) });
+        };
+        dispf("DISPF_P36", DISPFSolver::P36);
+        dispf("DISPF_P4", DISPFSolver::P4);
+        dispf("DISPF_P72", DISPFSolver::P72);
+        dispf("DISPF_P28", DISPFSolver::P28);
+
+        return schemes;
+    }
+
+    std::vector<ExplicitTableau> const &Schemes()
+    {
+        static std::vector<ExplicitTableau> const schemes = Registry();
+        return schemes;
+    }
+
+    // |R(x_i + i y)|^2 - 1 для всех узлов строки. Схема Горнера ведётся блоками по LANES
+    // точек: число итераций внутренних циклов известно при компиляции, поэтому они
+    // векторизуются и при -O2, а re/im блока остаются в регистрах на всём проходе по
+    // коэффициентам. Размер x и out кратен LANES.
+    void EvaluateRow(
+        std::vector<double> const &poly,
+        std::vector<double> const &x,
+        double                     y,
+        std::vector<double>       &out)
+    {
+        size_t const degree = poly.size() - 1;
+        double const top = poly[degree];
+
+        for (size_t base = 0; base < x.size(); base += LANES)
+        {
+            double const *xs = x.data() + base;
+            double re[LANES], im[LANES];
+            for (size_t l = 0; l < LANES; ++l)
+            {
+                re[l] = top;
+                im[l] = 0.0;
+            }
+
+            for (size_t k = degree; k-- > 0;)
+            {
+                double const c = poly[k];
+                for (size_t l = 0; l < LANES; ++l)
+                {
+                    double r = re[l] * xs[l] - im[l] * y + c;
+                    double m = re[l] * y + im[l] * xs[l];
+                    re[l] = r;
+                    im[l] = m;
+                }
+            }
+
+            for (size_t l = 0; l < LANES; ++l)
+                out[base + l] = re[l] * re[l] + im[l] * im[l] - 1.0;
+        }
+    }
+
+    // Точка пересечения уровня 0 на ребре между узлами со значениями va и vb
+    Point Crossing(
+        Point  pa,
+        Point  pb,
+        double va,
+        double vb)
+    {
+        double s = va / (va - vb);
+        return { pa.x + s * (pb.x - pa.x), pa.y + s * (pb.y - pa.y) };
+    }
+
+    // Marching squares для ряда ячеек между строками j и j + 1
+    void MarchRow(
+        std::vector<double> const &x,
+        size_t                     width,
+        double                     y0,
+        double                     y1,
+        size_t                     j,
+        std::vector<double> const &bottom,
+        std::vector<double> const &top,
+        std::vector<Segment>      &segments)
+    {
+        for (size_t i = 0; i + 1 < width; ++i)
+        {
+            double v00 = bottom[i], v10 = bottom[i + 1];
+            double v01 = top[i],    v11 = top[i + 1];
+
+            int index = (v00 <= 0.0 ? 1 : 0) | (v10 <= 0.0 ? 2 : 0)
+                      | (v11 <= 0.0 ? 4 : 0) | (v01 <= 0.0 ? 8 : 0);
+            if (index == 0 || index == 15)
+                continue;
+
+            Point p00 { x[i], y0 }, p10 { x[i + 1], y0 };
+            Point p01 { x[i], y1 }, p11 { x[i + 1], y1 };
+
+            // Ключи рёбер: горизонтальное (i, j)-(i+1, j) - чётный, вертикальное (i, j)-(i, j+1) - нечётный
+            uint64_t const B = 2 * (static_cast<uint64_t>(j) * width + i);
+            uint64_t const T = 2 * (static_cast<uint64_t>(j + 1) * width + i);
+            uint64_t const L = B + 1;
+            uint64_t const R = B + 3;
+
+            auto point = [&](uint64_t edge)
+            {
+                if (edge == B) return Crossing(p00, p10, v00, v10);
+                if (edge == T) return Crossing(p01, p11, v01, v11);
+                if (edge == L) return Crossing(p00, p01, v00, v01);
+                return Crossing(p10, p11, v10, v11);
+            };
+            auto add = [&](uint64_t a, uint64_t b)
+            {
+                segments.push_back({ a, b, point(a), point(b) });
+            };
+
+            bool centerInside = v00 + v10 + v01 + v11 <= 0.0;
+            switch (index)
+            {
+            case 1: case 14: add(L, B); break;
+            case 2: case 13: add(B, R); break;
+            case 3: case 12: add(L, R); break;
+            case 4: case 11: add(R, T); break;
+            case 6: case 9:  add(B, T); break;
+            case 7: case 8:  add(L, T); break;
+            case 5:
+                // Седло: внутри узлы (0, 0) и (1, 1)
+                if (centerInside) { add(B, R); add(L, T); }
+                else              { add(L, B); add(R, T); }
+                break;
+            case 10:
+                // Седло: внутри узлы (1, 0) и (0, 1)
+                if (centerInside) { add(L, B); add(R, T); }
+                else              { add(B, R); add(L, T); }
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    // Сшивка отрезков в ломаные по общим рёбрам сетки: каждое ребро принадлежит не более
+    // чем двум ячейкам, поэтому у ключа не больше двух отрезков
+    std::vector<std::vector<std::pair<double, double>>> Stitch(std::vector<Segment> const &segments)
+    {
+        std::unordered_map<uint64_t, std::pair<int, int>> byEdge;
+        byEdge.reserve(segments.size() * 2);
+        for (size_t s = 0; s < segments.size(); ++s)
+        {
+            for (uint64_t key : { segments[s].a, segments[s].b })
+            {
+                auto it = byEdge.emplace(key, std::make_pair(-1, -1)).first;
+                (it->second.first < 0 ? it->second.first : it->second.second) = static_cast<int>(s);
+            }
+        }
+
+        std::vector<char> used(segments.size(), 0);
+
+        // Следующий неиспользованный отрезок через ребро key
+        auto next = [&](uint64_t key) -> int
+        {
+            auto const &pair = byEdge[key];
+            if (pair.first >= 0 && !used[pair.first])
+                return pair.first;
+            if (pair.second >= 0 && !used[pair.second])
+                return pair.second;
+            return -1;
+        };
+
+        // Продолжение цепочки от ребра key, точки добавляются в path
+        auto walk = [&](uint64_t key, std::vector<Point> &path)
+        {
+            for (int s = next(key); s >= 0; s = next(key))
+            {
+                used[s] = 1;
+                Segment const &segment = segments[s];
+                bool forward = segment.a == key;
+                path.push_back(forward ? segment.pb : segment.pa);
+                key = forward ? segment.b : segment.a;
+            }
+            return key;
+        };
+
+        std::vector<std::vector<std::pair<double, double>>> contours;
+        for (size_t s = 0; s < segments.size(); ++s)
+        {
+            if (used[s])
+                continue;
+            used[s] = 1;
+
+            std::vector<Point> forward { segments[s].pa, segments[s].pb };
+            uint64_t end = walk(segments[s].b, forward);
+
+            std::vector<Point> backward;
+            if (end != segments[s].a)
+                walk(segments[s].a, backward);
+
+            std::vector<std::pair<double, double>> contour;
+            contour.reserve(backward.size() + forward.size());
+            for (auto it = backward.rbegin(); it != backward.rend(); ++it)
+                contour.emplace_back(it->x, it->y);
+            for (Point const &p : forward)
+                contour.emplace_back(p.x, p.y);
+            contours.push_back(std::move(contour));
+        }
+
+        // Длинные ломаные первыми: главная граница области
+        std::stable_sort(contours.begin(), contours.end(), [](auto const &a, auto const &b)
+        {
+            return a.size() > b.size();
+        });
+        return contours;
+    }
+}
+
+std::vector<std::string> StabilitySchemes()
+{
+    std::vector<std::string> names;
+    for (auto const &scheme : Schemes())
+        names.push_back(scheme.name);
+    return names;
+}
+
+ExplicitTableau SchemeTableau(std::string const &name)
+{
+    for (auto const &scheme : Schemes())
+    {
+        if (scheme.name == name)
+            return scheme;
+    }
+    throw std::runtime_error("Unknown scheme: " + name);
+}
+
+std::vector<double> StabilityPolynomial(ExplicitTableau const &tableau)
+{
+    size_t const s = tableau.b.size();
+    if (tableau.A.size() != s)
+        throw std::runtime_error("Tableau " + tableau.name + ": A and b sizes differ");
+
+    // r_k = b^T A^{k-1} 1: v_0 = 1, v_k = A v_{k-1}
+    std::vector<double> poly(s + 1, 0.0), v(s, 1.0), w(s);
+    poly[0] = 1.0;
+    for (size_t k = 1; k <= s; ++k)
+    {
+        for (size_t i = 0; i < s; ++i)
+            poly[k] += tableau.b[i] * v[i];
+
+        for (size_t i = 0; i < s; ++i)
+        {
+            w[i] = 0.0;
+            for (size_t j = 0; j < tableau.A[i].size(); ++j)
+                w[i] += tableau.A[i][j] * v[j];
+        }
+        v.swap(w);
+    }
+
+    while (poly.size() > 1 && poly.back() == 0.0)
+        poly.pop_back();
+    return poly;
+}
+
+StabilityRegion ComputeStabilityRegion(
+    std::vector<double> const &poly,
+    StabilityGrid const       &grid)
+{
+    if (poly.empty())
+        throw std::runtime_error("Stability polynomial is empty");
+    if (grid.width < 2 || grid.height < 2 || grid.width > MAX_GRID || grid.height > MAX_GRID)
+        throw std::runtime_error("Grid size must be between 2 and " + std::to_string(MAX_GRID));
+    if (!(grid.reMin < grid.reMax) || !(grid.imMin < grid.imMax))
+        throw std::runtime_error("Grid bounds must satisfy min < max");
+
+    size_t const width = grid.width;
+    size_t const height = grid.height;
+    double const dx = (grid.reMax - grid.reMin) / (width - 1);
+    double const dy = (grid.imMax - grid.imMin) / (height - 1);
+
+    // Абсциссы узлов, дополненные до кратного LANES последним значением
+    size_t const padded = (width + LANES - 1) / LANES * LANES;
+    std::vector<double> x(padded, grid.reMax);
+    for (size_t i = 0; i < width; ++i)
+        x[i] = grid.reMin + i * dx;
+    auto yAt = [&](size_t j) { return grid.imMin + j * dy; };
+
+    // Полосы рядов ячеек; соседние полосы вычисляют общую строку узлов дважды
+    size_t const cellRows = height - 1;
+    size_t const bands = std::min(cellRows, std::max<size_t>(1, ComputePool::Instance().ThreadCount() + 1) * BANDS_PER_THREAD);
+
+    std::vector<std::vector<Segment>> bandSegments(bands);
+    std::vector<size_t> bandInside(bands, 0);
+
+    ComputePool::Instance().ParallelFor(bands, [&](size_t band)
+    {
+        size_t const first = cellRows * band / bands;
+        size_t const last = cellRows * (band + 1) / bands;
+
+        std::vector<double> bottom(padded), top(padded);
+        auto countInside = [&](std::vector<double> const &row)
+        {
+            size_t count = 0;
+            for (size_t i = 0; i < width; ++i)
+                count += row[i] <= 0.0 ? 1 : 0;
+            return count;
+        };
+
+        EvaluateRow(poly, x, yAt(first), bottom);
+        size_t inside = band == 0 ? countInside(bottom) : 0;
+
+        for (size_t j = first; j < last; ++j)
+        {
+            EvaluateRow(poly, x, yAt(j + 1), top);
+            inside += countInside(top);
+            MarchRow(x, width, yAt(j), yAt(j + 1), j, bottom, top, bandSegments[band]);
+            bottom.swap(top);
+        }
+        bandInside[band] = inside;
+    });
+
+    std::vector<Segment> segments;
+    size_t inside = 0;
+    for (size_t band = 0; band < bands; ++band)
+    {
+        segments.insert(segments.end(), bandSegments[band].begin(), bandSegments[band].end());
+        inside += bandInside[band];
+    }
+
+    StabilityRegion region;
+    region.realInterval = StabilityInterval(poly);
+    region.area = inside * dx * dy;
+    region.contours = Stitch(segments);
+    return region;
+}
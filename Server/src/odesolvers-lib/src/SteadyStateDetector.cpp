@@ -0,0 +1,82 @@
+#include "../include/SteadyStateDetector.hpp"
+
+#include <algorithm>
+
+SteadyStateDetector::SteadyStateDetector(
+    std::function<std::vector<double>(
+        double,
+        std::vector<double> const &)> func,
+    ErrorTolerances                   tolerances,
+    double                            tolerance,
+    double                            tEnd,
+    size_t                            window)
+    : f(std::move(func)), tolerances(std::move(tolerances)), tolerance(tolerance), tEnd(tEnd), window(std::max<size_t>(window, 1))
+{
+}
+
+void SteadyStateDetector::Start(
+    double,
+    std::vector<double> const &y)
+{
+    yPrev = y;
+    windowStart = y;
+    previousChange = -1.0;
+    quietSteps = 0;
+    detected = false;
+    detectedTime = 0.0;
+}
+
+double SteadyStateDetector::Norm(
+    std::vector<double> const &v,
+    std::vector<double> const &y) const
+{
+    return tolerances.Norm(v, y, y, tolerance);
+}
+
+bool SteadyStateDetector::Check(
+    double                     t,
+    std::vector<double> const &y)
+{
+    if (detected)
+        return true;
+
+    std::vector<double> change(y.size());
+    for (size_t i = 0; i < y.size(); ++i)
+        change[i] = y[i] - yPrev[i];
+    yPrev = y;
+
+    if (Norm(change, y) > 1.0)
+    {
+        // Шумный шаг обрывает и последовательность окон
+        quietSteps = 0;
+        windowStart = y;
+        previousChange = -1.0;
+        return false;
+    }
+    if (++quietSteps < window)
+        return false;
+
+    // Окно спокойных шагов: изменение за окно сравнивается с предыдущим
+    for (size_t i = 0; i < y.size(); ++i)
+        change[i] = y[i] - windowStart[i];
+    double windowChange = Norm(change, y);
+    bool decaying = false;
+    if (previousChange > 0.0 && windowChange <= DECAY * previousChange)
+    {
+        double rho = windowChange / previousChange;
+        decaying = windowChange * rho / (1.0 - rho) <= 1.0;
+    }
+    windowStart = y;
+    previousChange = windowChange;
+
+    // Подтверждение по производной, при неудаче - новое окно. Без геометрического затухания
+    // остановка только при малом уходе ||f|| * (tEnd - t): медленный дрейф не принимается за покой
+    quietSteps = 0;
+    double derivative = Norm(f(t, y), y);
+    if (derivative > 1.0 || (!decaying && derivative * (tEnd - t) > 1.0))
+        return false;
+
+    detected = true;
+    detectedTime = t;
+    return true;
+}
@@ -0,0 +1,42 @@
+#include "../include/StepHintCache.hpp"
+
+#include <cmath>
+
+std::mutex StepHintCache::cacheMutex;
+std::unordered_map<std::string, double> StepHintCache::cache;
+
+std::string StepHintCache::Key(
+    std::string const              &equation,
+    std::vector<std::string> const &equations,
+    std::string const              &method,
+    double                          tolerance)
+{
+    int decade = tolerance > 0.0 ? static_cast<int>(std::floor(std::log10(tolerance))) : 0;
+    std::string key = equation + '|' + method + '|' + std::to_string(decade);
+    for (auto const &expression : equations)
+    {
+        key += '|';
+        key += expression;
+    }
+    return key;
+}
+
+double StepHintCache::Find(std::string const &key)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = cache.find(key);
+    return it != cache.end() ? it->second : 0.0;
+}
+
+void StepHintCache::Store(
+    std::string const &key,
+    double             step)
+{
+    if (!(step > 0.0) || !std::isfinite(step))
+        return;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (cache.size() >= MAX_CACHE_SIZE)
+        cache.clear();
+    cache[key] = step;
+}
@@ -0,0 +1,126 @@
+#include "../include/StepSizeController.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+StepControlKind ParseStepControlKind(std::string const &name)
+{
+    if (name.empty() || name == "Elementary")
+        return StepControlKind::Elementary;
+    if (name == "PI")
+        return StepControlKind::PI;
+    if (name == "PID")
+        return StepControlKind::PID;
+
+    throw std::runtime_error("Unknown step control: " + name);
+}
+
+void StepSizeController::SetLimits(
+    double safetyFactor,
+    double minFactor,
+    double maxFactor)
+{
+    safety = safetyFactor;
+    facMin = minFactor;
+    facMax = maxFactor;
+}
+
+void StepSizeController::Reset()
+{
+    errPrev = 1.0;
+    errPrev2 = 1.0;
+    rejected = false;
+}
+
+double StepSizeController::Accept(
+    double err,
+    double k)
+{
+    err = std::max(err, ERR_MIN);
+
+    double fac = safety;
+    switch (kind)
+    {
+        case StepControlKind::Elementary:
+            fac *= std::pow(err, -1.0 / k);
+            break;
+        case StepControlKind::PI:
+            fac *= std::pow(err, -0.7 / k) * std::pow(errPrev, 0.4 / k);
+            break;
+        case StepControlKind::PID:
+            fac *= std::pow(err, -0.58 / k) * std::pow(errPrev, 0.21 / k) * std::pow(errPrev2, -0.1 / k);
+            break;
+    }
+
+    errPrev2 = errPrev;
+    errPrev = std::max(err, HISTORY_MIN);
+
+    fac = std::clamp(fac, facMin, rejected ? 1.0 : facMax);
+    rejected = false;
+    return fac;
+}
+
+double StepSizeController::Reject(
+    double err,
+    double k)
+{
+    rejected = true;
+    double fac = safety * std::pow(std::max(err, ERR_MIN), -1.0 / k);
+    return std::clamp(fac, facMin, REJECT_MAX);
+}
+
+double StepSizeController::Limit(
+    double h,
+    double hStab)
+{
+    return hStab > 0.0 ? std::min(h, hStab) : h;
+}
+
+double EstimateInitialStep(
+    std::function<std::vector<double>(
+        double,
+        std::vector<double> const &)> const &f,
+    double                                   t0,
+    std::vector<double> const               &y0,
+    std::vector<double> const               &f0,
+    double                                   tEnd,
+    double                                   tolerance,
+    int                                      order,
+    ErrorTolerances const                   &tolerances)
+{
+    size_t const n = y0.size();
+    double const hMax = std::fabs(tEnd - t0);
+    if (n == 0 || !(hMax > 0.0))
+        return hMax;
+
+    // Масштабы те же, что в контроле точности решателя
+    std::vector<double> scale;
+    tolerances.Scales(tolerance, y0, y0, scale);
+    auto norm = [&](std::vector<double> const &v)
+    {
+        return tolerances.Norm(v, scale);
+    };
+
+    // Первое приближение: приращение решения за шаг - 1% его масштаба
+    double d0 = norm(y0);
+    double d1 = norm(f0);
+    double h0 = (d0 < 1e-5 || d1 < 1e-5) ? 1e-6 : 0.01 * d0 / d1;
+    h0 = std::min(h0, hMax);
+
+    // Вторая производная по разности f на пробном шаге Эйлера
+    std::vector<double> y1(n);
+    for (size_t i = 0; i < n; ++i)
+        y1[i] = y0[i] + h0 * f0[i];
+    std::vector<double> f1 = f(t0 + h0, y1);
+    for (size_t i = 0; i < n; ++i)
+        f1[i] -= f0[i];
+    double d2 = norm(f1) / h0;
+
+    double dMax = std::max(d1, d2);
+    double h1 = dMax <= 1e-15
+        ? std::max(1e-6, h0 * 1e-3)
+        : std::pow(0.01 / dMax, 1.0 / (order + 1));
+
+    return std::min({ 100.0 * h0, h1, hMax });
+}
@@ -2,9 +2,46 @@
 
 void Storage::Add(
     double time,
-    std::vector<double> const &values)
+    std::vector<double> const &values,
+    StepOutput const &step)
 {
+    if (stopped)
+        return;
+
+    if (events)
+    {
+        if (data.empty())
+        {
+            events->Start(time, values, step.derivative);
+        }
+        else
+        {
+            double t = time;
+            std::vector<double> y = values;
+            if (events->Check(t, y, step))
+            {
+                data.emplace_back(t, std::move(y));
+                stopped = true;
+                return;
+            }
+        }
+    }
+
     data.emplace_back(time, values);
+
+    if (steadyState)
+    {
+        if (data.size() == 1)
+            steadyState->Start(time, values);
+        else
+            stopped = steadyState->Check(time, values);
+    }
+}
+
+void Storage::Extend(double time)
+{
+    if (!data.empty() && time > data.back().first)
+        data.emplace_back(time, data.back().second);
 }
 
 std::pair<double, std::vector<double>>& Storage::operator[](size_t index) {
@@ -2,42 +2,32 @@
 
 TaskManager::TaskManager()
 {
-    tasks["VanDerPol"] = [this](double t, const std::vector<double>& y)
+    RegisterModel<2>("VanDerPol", [this]()
     {
-        double mu = parameters["mu"];
-        double p = parameters["p"];
-        return std::vector<double>
-        {
-            y[1],
-            (mu * (1 - y[0] * y[0]) * y[1] - y[0]) / p
-        };
-    };
+        return VanDerPolModel{Parameter("mu"), Parameter("p")};
+    });
 
-    tasks["ForcedOscillator"] = [this](double t, const std::vector<double>& y)
+    RegisterSecondOrderModel("VanDerPol", [this]()
     {
-        double omega = parameters["omega"];
-        double gamma = parameters["gamma"];
-        double F = parameters["F"];
-        double omega_drive = parameters["omega_k"];
-        return std::vector<double>
-        {
-            y[1],
-            -omega * omega * y[0] - gamma * y[1] + F * std::cos(omega_drive * t)
-        };
-    };
+        return VanDerPolModel{Parameter("mu"), Parameter("p")};
+    });
 
-    tasks["RobertsonSystem"] = [this](double t, const std::vector<double>& y)
+    RegisterModel<2>("ForcedOscillator", [this]()
     {
-        double k1 = parameters["k1"];
-        double k2 = parameters["k2"];
-        double k3 = parameters["k3"];
-        return std::vector<double>
-        {
-            -k1 * y[0] + k2 * y[1] * y[2],
-            k1 * y[0] - k2 * y[1] * y[2] - k3 * y[1] * y[1],
-            k3 * y[1] * y[1]
-        };
-    };
+        return ForcedOscillatorModel{
+            Parameter("omega"), Parameter("gamma"), Parameter("F"), Parameter("omega_k")};
+    });
+
+    RegisterSecondOrderModel("ForcedOscillator", [this]()
+    {
+        return ForcedOscillatorModel{
+            Parameter("omega"), Parameter("gamma"), Parameter("F"), Parameter("omega_k")};
+    });
+
+    RegisterModel<3>("RobertsonSystem", [this]()
+    {
+        return RobertsonModel{Parameter("k1"), Parameter("k2"), Parameter("k3")};
+    });
 }
 
 void TaskManager::LoadParameters(json const &params)
@@ -48,12 +38,283 @@ void TaskManager::LoadParameters(json const &params)
     }
 }
 
-const ODEFunction& TaskManager::GetTask(std::string const &taskName) const
+const ODEFunction& TaskManager::GetTask(std::string const &taskName)
 {
     auto it = tasks.find(taskName);
     if (it == tasks.end())
     {
-        throw std::runtime_error("Task not found: " + taskName);
+        if (!BindModel(taskName) && !BindPlugin(taskName))
+        {
+            throw std::runtime_error("Task not found: " + taskName);
+        }
+        it = tasks.find(taskName);
     }
     return it->second;
 }
+
+const ODEFunction* TaskManager::FindImplicitPart(std::string const &taskName)
+{
+    GetTask(taskName);
+
+    auto it = tasks.find(ImplicitPartName(taskName));
+    return it == tasks.end() ? nullptr : &it->second;
+}
+
+const JacobianFunction* TaskManager::FindJacobian(std::string const &taskName) const
+{
+    auto it = jacobians.find(taskName);
+    return it == jacobians.end() ? nullptr : &it->second;
+}
+
+const JacobianVectorFunction* TaskManager::FindJacobianVector(std::string const &taskName) const
+{
+    auto it = jacobianVectors.find(taskName);
+    return it == jacobianVectors.end() ? nullptr : &it->second;
+}
+
+bool TaskManager::FindSecondOrder(
+    std::string const &taskName,
+    SecondOrderSystem &system) const
+{
+    auto it = secondOrder.find(taskName);
+    if (it == secondOrder.end())
+    {
+        return false;
+    }
+    system = it->second;
+    return true;
+}
+
+const PreconditionerFunction* TaskManager::FindPreconditioner(std::string const &taskName) const
+{
+    auto it = preconditioners.find(taskName);
+    return it == preconditioners.end() ? nullptr : &it->second;
+}
+
+const CsrPattern* TaskManager::FindSparsity(
+    std::string const &taskName,
+    size_t             n)
+{
+    auto it = sparsity.find(taskName);
+    if (it != sparsity.end())
+    {
+        return it->second.n == n ? &it->second : nullptr;
+    }
+
+    // Структура из плагина объявлена для полной правой части и покрывает её жёсткую часть
+    std::string pluginName = taskName;
+    std::string const suffix = IMPLICIT_SUFFIX;
+    if (pluginName.size() > suffix.size() && pluginName.compare(pluginName.size() - suffix.size(), suffix.size(), suffix) == 0)
+    {
+        pluginName.resize(pluginName.size() - suffix.size());
+    }
+
+    auto plugin = PluginManager::Instance().Find(pluginName);
+    if (!plugin || !plugin->sparsity)
+    {
+        return nullptr;
+    }
+
+    CsrPattern pattern;
+    pattern.n = n;
+    pattern.rowPtr.resize(n + 1);
+    pattern.colIndex.resize(plugin->sparsity(n, pattern.rowPtr.data(), nullptr));
+    plugin->sparsity(n, pattern.rowPtr.data(), pattern.colIndex.data());
+
+    return &(sparsity[taskName] = std::move(pattern));
+}
+
+double TaskManager::Parameter(std::string const &name) const
+{
+    auto it = parameters.find(name);
+    if (it == parameters.end())
+    {
+        throw std::runtime_error("Missing model parameter: " + name);
+    }
+    return it->second;
+}
+
+bool TaskManager::BindModel(std::string const &taskName)
+{
+    auto it = models.find(taskName);
+    if (it == models.end())
+    {
+        return false;
+    }
+
+    for (auto const &bind : it->second)
+    {
+        bind();
+    }
+    return true;
+}
+
+bool TaskManager::BindPlugin(std::string const &taskName)
+{
+    auto plugin = PluginManager::Instance().Find(taskName);
+    if (!plugin)
+    {
+        return false;
+    }
+
+    std::vector<double> values;
+    for (auto const &name : plugin->parameterNames)
+    {
+        auto it = parameters.find(name);
+        if (it == parameters.end())
+        {
+            throw std::runtime_error("Missing plugin parameter: " + name);
+        }
+        values.push_back(it->second);
+    }
+
+    tasks[taskName] = [plugin, values](double t, const std::vector<double>& y)
+    {
+        std::vector<double> dydt(y.size());
+        plugin->rhs(t, y.data(), dydt.data(), y.size(), values.data());
+        return dydt;
+    };
+
+    if (plugin->jacobian)
+    {
+        jacobians[taskName] = [plugin, values](double t, const std::vector<double>& y)
+        {
+            size_t n = y.size();
+            std::vector<double> flat(n * n);
+            plugin->jacobian(t, y.data(), flat.data(), n, values.data());
+
+            std::vector<std::vector<double>> J(n, std::vector<double>(n));
+            for (size_t i = 0; i < n; ++i)
+            {
+                std::copy(flat.begin() + i * n, flat.begin() + (i + 1) * n, J[i].begin());
+            }
+            return J;
+        };
+    }
+
+    if (plugin->rhsImplicit)
+    {
+        tasks[ImplicitPartName(taskName)] = [plugin, values](double t, const std::vector<double>& y)
+        {
+            std::vector<double> dydt(y.size());
+            plugin->rhsImplicit(t, y.data(), dydt.data(), y.size(), values.data());
+            return dydt;
+        };
+    }
+
+    preconditioners.erase(taskName);
+    if (plugin->preconditioner)
+    {
+        preconditioners[taskName] = [plugin, values](double t, const std::vector<double>& y, double gamma, std::vector<double>& v)
+        {
+            plugin->preconditioner(t, y.data(), gamma, v.data(), y.size(), values.data());
+        };
+    }
+
+    return true;
+}
+
+std::vector<double> TaskManager::BindParameters(
+    ExpressionProgram const &program,
+    std::string const       &what) const
+{
+    std::vector<double> values;
+    for (auto const &name : program.ParameterNames())
+    {
+        auto it = parameters.find(name);
+        if (it == parameters.end())
+        {
+            throw std::runtime_error("Unknown parameter in " + what + ": " + name);
+        }
+        values.push_back(it->second);
+    }
+    return values;
+}
+
+void TaskManager::RegisterExpressionTask(
+    std::string const              &taskName,
+    std::vector<std::string> const &expressions)
+{
+    auto program = ExpressionCompiler::Compile(expressions);
+
+    // Значения параметров связываются один раз, при регистрации задачи
+    std::vector<double> values = BindParameters(*program, "equations");
+
+    jacobians.erase(taskName);
+    jacobianVectors.erase(taskName);
+    preconditioners.erase(taskName);
+    secondOrder.erase(taskName);
+    sparsity[taskName] = program->DependencyPattern();
+    tasks[taskName] = [program, values](double t, const std::vector<double>& y)
+    {
+        if (y.size() != program->Dimension())
+        {
+            throw std::invalid_argument("State dimension does not match the number of equations");
+        }
+
+        std::vector<double> dydt(program->Dimension());
+        program->Evaluate(t, y.data(), values.data(), dydt.data());
+        return dydt;
+    };
+}
+
+void TaskManager::RegisterSecondOrderTask(
+    std::string const              &taskName,
+    std::vector<std::string> const &expressions,
+    bool                            firstOrder)
+{
+    size_t const m = expressions.size();
+    auto program = ExpressionCompiler::Compile(expressions, 2 * m);
+    std::vector<double> values = BindParameters(*program, "accelerations");
+
+    auto acceleration = [program, values, m](double t, const std::vector<double>& y)
+    {
+        if (y.size() != 2 * m)
+        {
+            throw std::invalid_argument("State dimension must be twice the number of accelerations");
+        }
+
+        std::vector<double> a(m);
+        program->Evaluate(t, y.data(), values.data(), a.data());
+        return a;
+    };
+
+    secondOrder[taskName] = SecondOrderSystem{acceleration, !program->DependsOn(m, 2 * m)};
+
+    if (!firstOrder)
+    {
+        return;
+    }
+
+    jacobians.erase(taskName);
+    jacobianVectors.erase(taskName);
+    preconditioners.erase(taskName);
+    sparsity.erase(taskName);
+    tasks[taskName] = [acceleration, m](double t, const std::vector<double>& y)
+    {
+        std::vector<double> a = acceleration(t, y);
+        std::vector<double> dydt(y.begin() + m, y.end());
+        dydt.insert(dydt.end(), a.begin(), a.end());
+        return dydt;
+    };
+}
+
+EventFunction TaskManager::CompileEvents(
+    std::vector<std::string> const &expressions,
+    size_t                          n) const
+{
+    auto program = ExpressionCompiler::Compile(expressions, n);
+    std::vector<double> values = BindParameters(*program, "events");
+
+    return [program, values, n](double t, const std::vector<double>& y)
+    {
+        if (y.size() != n)
+        {
+            throw std::invalid_argument("State dimension does not match the event functions");
+        }
+
+        std::vector<double> g(program->Dimension());
+        program->Evaluate(t, y.data(), values.data(), g.data());
+        return g;
+    };
+}
@@ -0,0 +1,133 @@
+#include "DispsDesign.hpp"
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+// Построение коэффициентов схем DISPS:
+//   disps-design --stages 5 --order 2 [--damping 0.05] [--match-error C | --free-error] [--starts 64] [--seed 1]
+//   disps-design --check
+// Результат - строка для DISPSSolver::Variants. Константа погрешности по умолчанию - как у встроенного
+// варианта с тем же числом стадий и порядком (--match-error C задаёт её явно); --free-error снимает
+// условие - интервал длиннее, но оценки погрешности решателя для таких весов не откалиброваны.
+
+namespace
+{
+    DispsEnabledFlags AllVariants()
+    {
+        return { true, true, true, true, true, true };
+    }
+
+    // Интервалы устойчивости встроенных вариантов для таблицы стадий, которую выполняет решатель
+    void Check()
+    {
+        for (auto const &variant : DISPSSolver::Variants(AllVariants()))
+        {
+            auto poly = DispsStabilityPolynomial(variant.stages, variant.p);
+            std::printf("stages %d order %d: gamma %.2f, interval %.4f, error constant %.6g\n",
+                        variant.stages, variant.order, variant.gamma,
+                        StabilityInterval(poly),
+                        DispsErrorConstant(variant.stages, variant.order, variant.p));
+        }
+    }
+
+    void Usage()
+    {
+        std::fprintf(stderr,
+            "usage: disps-design --stages {3,5,6} --order {1,2,3} [--damping D]\n"
+            "                    [--match-error C | --free-error] [--starts N] [--seed S]\n"
+            "       disps-design --check\n");
+    }
+}
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        DispsDesignOptions options;
+        bool matchBuiltin = true;
+
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            auto value = [&]()
+            {
+                if (i + 1 >= argc)
+                    throw std::runtime_error("missing value for " + arg);
+                return std::string(argv[++i]);
+            };
+
+            if (arg == "--check")
+            {
+                Check();
+                return 0;
+            }
+            else if (arg == "--stages")
+                options.stages = std::stoi(value());
+            else if (arg == "--order")
+                options.order = std::stoi(value());
+            else if (arg == "--damping")
+                options.damping = std::stod(value());
+            else if (arg == "--starts")
+                options.starts = std::stoi(value());
+            else if (arg == "--seed")
+                options.seed = static_cast<unsigned>(std::stoul(value()));
+            else if (arg == "--match-error")
+            {
+                options.matchError = true;
+                // Без значения - константа встроенного варианта (как по умолчанию)
+                if (i + 1 < argc && std::string(argv[i + 1]).rfind("--", 0) != 0)
+                {
+                    options.errorConstant = std::stod(value());
+                    matchBuiltin = false;
+                }
+                else
+                    matchBuiltin = true;
+            }
+            else if (arg == "--free-error")
+            {
+                options.matchError = false;
+                matchBuiltin = false;
+            }
+            else
+            {
+                Usage();
+                return 1;
+            }
+        }
+
+        if (matchBuiltin)
+        {
+            bool found = false;
+            for (auto const &variant : DISPSSolver::Variants(AllVariants()))
+            {
+                if (variant.stages == options.stages && variant.order == options.order)
+                {
+                    options.errorConstant = DispsErrorConstant(variant.stages, variant.order, variant.p);
+                    found = true;
+                }
+            }
+            if (!found)
+                throw std::runtime_error("no built-in variant to match the error constant; "
+                                         "pass it with --match-error C or use --free-error");
+        }
+
+        DispsDesignResult result = DesignDisps(options);
+
+        std::printf("// gamma %.2f, error constant %.6g (%s), damping %g\n",
+                    result.variant.gamma, result.errorConstant,
+                    options.matchError ? "matched" : "free, not calibrated for the solver",
+                    options.damping);
+        std::printf("variants.push_back({%d, %d, {", result.variant.stages, result.variant.order);
+        for (size_t i = 0; i < result.variant.p.size(); ++i)
+            std::printf(i == 0 ? "%.15g" : ", %.15g", result.variant.p[i]);
+        std::printf("}, %.2f});\n", result.variant.gamma);
+    }
+    catch (std::exception const &e)
+    {
+        std::fprintf(stderr, "Error: %s\n", e.what());
+        return 1;
+    }
+
+    return 0;
+}